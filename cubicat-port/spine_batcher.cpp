@@ -0,0 +1,136 @@
+#include "spine_batcher.h"
+#include "spine_node.h"
+#include "graphic_engine/drawable/polygon2d.h"
+#include <algorithm>
+
+SpineBatcher::~SpineBatcher() {
+    for (auto node : m_vNodes)
+        node->m_pBatcher = nullptr;
+}
+
+SpineBatcher* SpineBatcher::createSpineBatcher() {
+    return NEW SpineBatcher();
+}
+
+void SpineBatcher::addNode(SpineNode* node) {
+    if (!node || node->m_pBatcher == this)
+        return;
+    if (node->m_pBatcher)
+        node->m_pBatcher->removeNode(node);
+    node->m_pBatcher = this;
+    node->clearDrawables();
+    m_vNodes.push_back(node);
+}
+
+void SpineBatcher::removeNode(SpineNode* node) {
+    auto it = std::find(m_vNodes.begin(), m_vNodes.end(), node);
+    if (it == m_vNodes.end())
+        return;
+    m_vNodes.erase(it);
+    node->m_pBatcher = nullptr;
+}
+
+void SpineBatcher::setMaxVertices(int maxVertices) {
+    m_iMaxVertices = std::max(4, std::min(maxVertices, 65536));
+}
+
+int SpineBatcher::getDrawCalls() {
+    return m_iDrawCalls;
+}
+
+int SpineBatcher::getUploadedBytes() {
+    return m_iUploadedBytes;
+}
+
+void SpineBatcher::setFixedPoint(bool fixed) {
+    m_bFixedPoint = fixed;
+}
+
+bool SpineBatcher::isFixedPoint() {
+    return m_bFixedPoint;
+}
+
+void SpineBatcher::update(float deltaTime, bool parentDirty) {
+    Node::update(deltaTime, parentDirty);
+    m_vPositions.clear();
+    m_vUVs.clear();
+    m_vIndices.clear();
+    m_vBatches.clear();
+    if (isVisible()) {
+        for (auto node : m_vNodes)
+            node->emitBatch(*this);
+    }
+    draw();
+}
+
+SpineBatcher::Batch& SpineBatcher::getBatch(const TexturePtr& texture, BlendMode blendMode, bool bilinearFilter,
+                                            int vertexCount) {
+    Batch* batch = m_vBatches.empty() ? nullptr : &m_vBatches.back();
+    if (!batch || batch->texture != texture || batch->blendMode != blendMode ||
+        batch->bilinearFilter != bilinearFilter || batch->vertexCount + vertexCount > m_iMaxVertices) {
+        m_vBatches.push_back({texture, blendMode, bilinearFilter, (int)m_vPositions.size() / 2, 0,
+                              (int)m_vIndices.size(), 0});
+        batch = &m_vBatches.back();
+    }
+    return *batch;
+}
+
+void SpineBatcher::addIndices(Batch& batch, const uint16_t* indices, int indexCount, int vertexCount) {
+    uint16_t base = (uint16_t)batch.vertexCount;
+    for (int i = 0; i < indexCount; ++i)
+        m_vIndices.push_back(base + indices[i]);
+    batch.vertexCount += vertexCount;
+    batch.indexCount += indexCount;
+}
+
+void SpineBatcher::addGeometry(const SpineSlotGeometry& geometry, const float* m, bool bilinearFilter) {
+    Batch& batch = getBatch(geometry.texture, geometry.blendMode, bilinearFilter, geometry.vertexCount);
+    const float* positions = geometry.positions;
+    for (int i = 0; i < geometry.vertexCount; ++i) {
+        float x = positions[i * 2], y = positions[i * 2 + 1];
+        m_vPositions.push_back(x * m[0] + y * m[1] + m[4]);
+        m_vPositions.push_back(x * m[2] + y * m[3] + m[5]);
+    }
+    m_vUVs.insert(m_vUVs.end(), geometry.uvs, geometry.uvs + geometry.vertexCount * 2);
+    addIndices(batch, geometry.indices, geometry.indexCount, geometry.vertexCount);
+}
+
+void SpineBatcher::addFixedGeometry(const SpineFixedGeometry& geometry, bool bilinearFilter) {
+    Batch& batch = getBatch(geometry.texture, geometry.blendMode, bilinearFilter, geometry.vertexCount);
+    // the engine's meshes take floats
+    const float positionScale = 1.0f / (1 << SPINE_FIXED_POSITION_BITS);
+    const float uvScale = 1.0f / (1 << SPINE_FIXED_UV_BITS);
+    for (int i = 0; i < geometry.vertexCount * 2; ++i) {
+        m_vPositions.push_back(geometry.positions[i] * positionScale);
+        m_vUVs.push_back(geometry.uvs[i] * uvScale);
+    }
+    addIndices(batch, geometry.indices, geometry.indexCount, geometry.vertexCount);
+}
+
+void SpineBatcher::draw() {
+    auto& drawables = getDrawables();
+    for (size_t i = drawables.size(); i < m_vBatches.size(); ++i)
+        attachDrawable(Polygon2D::create(Mesh2D::create(nullptr, 0, nullptr, 0, true)));
+    m_iUploadedBytes = 0;
+    for (size_t i = 0; i < drawables.size(); ++i) {
+        auto poly = drawables[i]->cast<Polygon2D>();
+        if (i >= m_vBatches.size()) {
+            poly->setVisible(false);
+            continue;
+        }
+        Batch& batch = m_vBatches[i];
+        poly->addDirty(true);
+        poly->setVisible(true);
+        auto material = poly->getMaterial();
+        if (batch.texture)
+            material->setTexture(batch.texture);
+        material->setBlendMode(batch.blendMode);
+        material->setBilinearFilter(batch.bilinearFilter);
+        auto mesh = poly->getMesh();
+        mesh->updateVertices(&m_vPositions[batch.vertexStart * 2], batch.vertexCount);
+        mesh->updateIndices(&m_vIndices[batch.indexStart], batch.indexCount);
+        mesh->updateUVs(&m_vUVs[batch.vertexStart * 2], batch.vertexCount * 2);
+        m_iUploadedBytes += batch.vertexCount * 4 * sizeof(float) + batch.indexCount * sizeof(uint16_t);
+    }
+    m_iDrawCalls = (int)m_vBatches.size();
+}
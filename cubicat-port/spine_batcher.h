@@ -0,0 +1,104 @@
+#ifndef _SPINE_BATCHER_H_
+#define _SPINE_BATCHER_H_
+#include <vector>
+#include <stdint.h>
+#include "graphic_engine/node2d.h"
+#include "graphic_engine/drawable/texture.h"
+
+using namespace cubicat;
+
+class SpineNode;
+// What one slot draws, in the space of its SpineNode
+struct SpineSlotGeometry {
+    TexturePtr          texture;
+    BlendMode           blendMode = BlendMode::Normal;
+    const float*        positions = nullptr;
+    const float*        uvs = nullptr;
+    int                 vertexCount = 0;
+    const uint16_t*     indices = nullptr;
+    int                 indexCount = 0;
+};
+
+// fraction bits of SpineNode::getFixedSlotGeometry output. Positions cover +-2048 pixels at 1/16 pixel,
+// UVs are Q1.15 so their precision doesn't depend on the page size.
+#define SPINE_FIXED_POSITION_BITS 4
+#define SPINE_FIXED_UV_BITS 15
+
+// What one slot draws, as 16 bit fixed point, see SpineNode::getFixedSlotGeometry
+struct SpineFixedGeometry {
+    TexturePtr          texture;
+    BlendMode           blendMode = BlendMode::Normal;
+    const int16_t*      positions = nullptr;
+    const int16_t*      uvs = nullptr;
+    int                 vertexCount = 0;
+    const uint16_t*     indices = nullptr;
+    int                 indexCount = 0;
+};
+
+// Draws the slots of all added SpineNodes through shared meshes. Slots are collected in draw order,
+// nodes added later on top, and consecutive slots with the same texture, blend mode and filter are
+// merged into one mesh, so a crowd sharing atlas pages costs a few draw calls instead of one per slot.
+// Draws in its parent's space: put it at the origin under the same parent as its nodes, after them
+// so it updates once they have posed.
+class SpineBatcher : public Node2D
+{
+public:
+    DECLARE_RTTI_SUB(SpineBatcher, Node2D)
+    SharedPtr<SpineBatcher> static create() {return SharedPtr<SpineBatcher>(NEW SpineBatcher());}
+    ~SpineBatcher();
+
+    void update(float deltaTime, bool parentDirty) override;
+    // [JS_BINDING_BEGIN]
+    static SpineBatcher* createSpineBatcher();
+    // the node stops drawing itself, its slots are drawn by this batcher
+    void addNode(SpineNode* node);
+    // the node draws itself again from its next update
+    void removeNode(SpineNode* node);
+    // vertices per merged mesh, at most 65536 so indices fit 16 bits. A slot that doesn't fit starts
+    // a new mesh, a single slot over the limit gets a mesh of its own.
+    void setMaxVertices(int maxVertices);
+    // meshes drawn by the last update
+    int getDrawCalls();
+    // vertex and index bytes written to meshes by the last update
+    int getUploadedBytes();
+    // [JS_BINDING_END]
+    // collect the slots of nodes not under a SpineScheduler as 16 bit fixed point skinned straight from
+    // the bones (SpineNode::getFixedSlotGeometry), converted back to mesh floats when appended. The
+    // meshes are float, so this costs more than the float path. It's a hook for checking fixed point
+    // precision (tools/host/fixed_point_check), not a faster mode, and stays out of the JS binding
+    // until meshes take int16 vertices. Off by default.
+    void setFixedPoint(bool fixed);
+    bool isFixedPoint();
+    // append a slot's geometry, positions through the node matrix m (see SpineNode::getNodeTransform)
+    void addGeometry(const SpineSlotGeometry& geometry, const float* m, bool bilinearFilter);
+    // append a slot's fixed point geometry, positions already in this batcher's space
+    void addFixedGeometry(const SpineFixedGeometry& geometry, bool bilinearFilter);
+private:
+    struct Batch {
+        TexturePtr  texture;
+        BlendMode   blendMode;
+        bool        bilinearFilter;
+        int         vertexStart;
+        int         vertexCount;
+        int         indexStart;
+        int         indexCount;
+    };
+    SpineBatcher() = default;
+    // the batch the geometry goes to, a new one when it doesn't merge with the last
+    Batch& getBatch(const TexturePtr& texture, BlendMode blendMode, bool bilinearFilter, int vertexCount);
+    void addIndices(Batch& batch, const uint16_t* indices, int indexCount, int vertexCount);
+    // hand the batches to the drawables, one Polygon2D per batch
+    void draw();
+    std::vector<SpineNode*>     m_vNodes;
+    std::vector<float>          m_vPositions;
+    std::vector<float>          m_vUVs;
+    std::vector<uint16_t>       m_vIndices;
+    std::vector<Batch>          m_vBatches;
+    int                         m_iMaxVertices = 65536;
+    int                         m_iDrawCalls = 0;
+    int                         m_iUploadedBytes = 0;
+    bool                        m_bFixedPoint = false;
+};
+typedef SharedPtr<SpineBatcher> SpineBatcherPtr;
+
+#endif
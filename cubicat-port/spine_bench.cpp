@@ -0,0 +1,272 @@
+#include "spine_bench.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "texture_loader.h"
+#include "spine_node.h"
+#include "spine_extension.h"
+#include <math.h>
+#include "spine/Vector.h"
+#include "spine/SkeletonData.h"
+#include "spine/BoneData.h"
+#include "spine/SlotData.h"
+#include "spine/Animation.h"
+#ifdef CONFIG_SPINE_VERSION_42
+#include "spine/spine.h"
+#endif
+
+void SpineBench::benchNoop(SpineNode* node, int trackIndex, int animation, bool loop) {
+    (void)node;
+    (void)trackIndex;
+    (void)animation;
+    (void)loop;
+}
+
+int SpineBench::benchMicros() {
+    return (int)esp_timer_get_time();
+}
+
+int SpineBench::benchDeform(int vertexCount, int movedVertices, int applies, bool sparse) {
+#ifdef CONFIG_SPINE_VERSION_42
+    if (vertexCount <= 0 || movedVertices < 0 || movedVertices > vertexCount)
+        return -1;
+    CubicatSpineExtension::init();
+    spine::SkeletonData data;
+    auto boneData = new spine::BoneData(0, "root", nullptr);
+    data.getBones().add(boneData);
+    data.getSlots().add(new spine::SlotData(0, "mesh", *boneData));
+    auto mesh = new spine::MeshAttachment("mesh");
+    auto& vertices = mesh->getVertices();
+    for (int i = 0; i < vertexCount * 2; ++i)
+        vertices.add((float)(i % 97));
+    // the moved vertices sit in the middle of the mesh, like a mouth on a face
+    int movedStart = (vertexCount - movedVertices) / 2 * 2;
+    spine::DeformTimeline timeline(2, 0, 0, mesh);
+    spine::Vector<float> key;
+    for (int frame = 0; frame < 2; ++frame) {
+        key.clearAndAddAll(vertices);
+        for (int i = movedStart, n = movedStart + movedVertices * 2; i < n; ++i)
+            key[i] += frame ? 5.0f : -5.0f;
+        timeline.setFrame(frame, (float)frame, key);
+    }
+    if (sparse)
+        timeline.sparsify();
+    int result;
+    {
+        spine::Skeleton skeleton(&data);
+        skeleton.getSlots()[0]->setAttachment(mesh);
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < applies; ++i)
+            timeline.apply(skeleton, 0, (i & 15) / 16.0f, nullptr, 1, spine::MixBlend_First, spine::MixDirection_In);
+        result = (int)(esp_timer_get_time() - start);
+    }
+    delete mesh;
+    return result;
+#else
+    (void)vertexCount;
+    (void)movedVertices;
+    (void)applies;
+    (void)sparse;
+    return -1;
+#endif
+}
+
+#define BENCH_PAGE_SIZE 256
+
+int SpineBench::benchTexelFetch(bool indexed, int fetches) {
+    size_t pixels = BENCH_PAGE_SIZE * BENCH_PAGE_SIZE;
+    size_t bytes = indexed ? pixels + INDEXED_CLUT_BYTES : pixels * 4;
+    uint8_t* page = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (!page)
+        return -1;
+    for (size_t i = 0; i < bytes; ++i)
+        page[i] = (uint8_t)(i * 2654435761u >> 24);
+    const uint32_t* rgba = (const uint32_t*)page;
+    const uint16_t* clut = (const uint16_t*)(page + pixels);
+    const uint8_t* clutAlpha = (const uint8_t*)(clut + INDEXED_CLUT_SIZE);
+    // 16.16 texture coordinates stepping across a span, a new span every 64 texels
+    const int32_t du = 0xd000, dv = 0x3000;
+    uint32_t sum = 0;
+    int64_t start = esp_timer_get_time();
+    int32_t u = 0, v = 0;
+    for (int i = 0; i < fetches; ++i) {
+        if ((i & 63) == 0) {
+            u = (i * 37) << 12;
+            v = (i >> 6) << 16;
+        }
+        uint32_t x = (uint32_t)(u >> 16) & (BENCH_PAGE_SIZE - 1);
+        uint32_t y = (uint32_t)(v >> 16) & (BENCH_PAGE_SIZE - 1);
+        uint32_t texel = y * BENCH_PAGE_SIZE + x;
+        uint16_t color;
+        uint8_t alpha;
+        if (indexed) {
+            uint8_t index = page[texel];
+            color = clut[index];
+            alpha = clutAlpha[index];
+        } else {
+            uint32_t c = rgba[texel];
+            color = (uint16_t)(((c >> 27) << 11) | (((c >> 18) & 0x3f) << 5) | ((c >> 11) & 0x1f));
+            alpha = (uint8_t)c;
+        }
+        sum += color + alpha;
+        u += du;
+        v += dv;
+    }
+    int result = (int)(esp_timer_get_time() - start);
+    free(page);
+    // keep the loop from being optimized away
+    return sum == 0xffffffffu ? -2 : result;
+}
+
+int SpineBench::benchImpostor(SpineNode* node, int updates, bool impostor) {
+    bool wasImpostor = node->isImpostor();
+    if (node->setImpostor(impostor) != impostor) {
+        node->setImpostor(wasImpostor);
+        return -1;
+    }
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < updates; ++i)
+        node->update(1.0f / 60, false);
+    int64_t elapsed = esp_timer_get_time() - start;
+    node->setImpostor(wasImpostor);
+    return (int)elapsed;
+}
+
+int SpineBench::benchFixedVertices(SpineNode* node, int passes, bool fixed) {
+    if (!node->m_pSkeleton)
+        return -1;
+    auto& drawOrder = node->m_pSkeleton->getDrawOrder();
+    int slotCount = drawOrder.size();
+    float m[6];
+    node->getNodeTransform(m);
+    SpineFixedGeometry fixedGeometry;
+    SpineSlotGeometry geometry;
+    std::vector<float> positions;
+    int64_t start = esp_timer_get_time();
+    for (int pass = 0; pass < passes; ++pass) {
+        // a new pose each pass, as after an update
+        node->m_bFixedBonesDirty = true;
+        for (int i = 0; i < slotCount; ++i) {
+            if (fixed) {
+                node->getFixedSlotGeometry(i, fixedGeometry);
+            } else if (node->getSlotGeometry(*drawOrder[i], slotCount, geometry)) {
+                // what SpineBatcher does with the floats before handing them on
+                positions.resize(geometry.vertexCount * 2);
+                for (int v = 0; v < geometry.vertexCount; ++v) {
+                    float x = geometry.positions[v * 2], y = geometry.positions[v * 2 + 1];
+                    positions[v * 2] = x * m[0] + y * m[1] + m[4];
+                    positions[v * 2 + 1] = x * m[2] + y * m[3] + m[5];
+                }
+            }
+        }
+    }
+    return (int)(esp_timer_get_time() - start);
+}
+
+double SpineBench::poseFixedPointError(SpineNode* node, bool uvs) {
+    auto& drawOrder = node->m_pSkeleton->getDrawOrder();
+    int slotCount = drawOrder.size();
+    float m[6];
+    node->getNodeTransform(m);
+    SpineFixedGeometry fixedGeometry;
+    SpineSlotGeometry geometry;
+    double maxError = 0;
+    for (int i = 0; i < slotCount; ++i) {
+        if (!node->getFixedSlotGeometry(i, fixedGeometry))
+            continue;
+        if (!node->getSlotGeometry(*drawOrder[i], slotCount, geometry))
+            return -1;
+        for (int v = 0; v < geometry.vertexCount * 2; ++v) {
+            double error;
+            if (uvs) {
+                error = fabs(fixedGeometry.uvs[v] / (double)(1 << SPINE_FIXED_UV_BITS) - geometry.uvs[v]);
+            } else {
+                // parent space, as SpineBatcher places the float vertices
+                double x = geometry.positions[v & ~1], y = geometry.positions[v | 1];
+                double expected = (v & 1) ? x * m[2] + y * m[3] + m[5] : x * m[0] + y * m[1] + m[4];
+                error = fabs(fixedGeometry.positions[v] / (double)(1 << SPINE_FIXED_POSITION_BITS) - expected);
+            }
+            if (error > maxError)
+                maxError = error;
+        }
+    }
+    return maxError;
+}
+
+int SpineBench::fixedPointError(SpineNode* node, int frames, bool uvs) {
+    if (!node->m_pSkeleton)
+        return -1;
+    double maxError = 0;
+    for (int i = 0; i < frames; ++i) {
+        if (i > 0)
+            node->update(1.0f / 30, false);
+        double error = poseFixedPointError(node, uvs);
+        if (error < 0)
+            return -1;
+        if (error > maxError)
+            maxError = error;
+    }
+    return (int)(maxError * 1000000);
+}
+
+int SpineBench::vectorStats(bool reallocations, bool reset) {
+#ifdef SPINE_VECTOR_STATS
+    size_t& counter = reallocations ? spine::VectorStats::reallocations : spine::VectorStats::copies;
+    int count = (int)counter;
+    if (reset)
+        counter = 0;
+    return count;
+#else
+    (void)reallocations;
+    (void)reset;
+    return -1;
+#endif
+}
+
+int SpineBench::spineAllocations() {
+    return CubicatSpineExtension::getAllocations();
+}
+
+int SpineBench::freeHeap() {
+    return (int)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+int SpineBench::internedNames(SpineNode* node, bool bytes) {
+#ifdef CONFIG_SPINE_VERSION_42
+    if (!node->m_pSkeleton)
+        return -1;
+    auto& names = node->m_pSkeleton->getData()->getNames();
+    return (int)(bytes ? names.getBytes() : names.getCount());
+#else
+    (void)node;
+    (void)bytes;
+    return -1;
+#endif
+}
+
+int SpineBench::benchNameLookup(SpineNode* node, int passes) {
+    if (!node->m_pSkeleton)
+        return -1;
+    auto data = node->m_pSkeleton->getData();
+    std::vector<std::string> bones, slots, animations;
+    for (size_t i = 0; i < data->getBones().size(); ++i)
+        bones.push_back(data->getBones()[i]->getName().buffer());
+    for (size_t i = 0; i < data->getSlots().size(); ++i)
+        slots.push_back(data->getSlots()[i]->getName().buffer());
+    for (size_t i = 0; i < data->getAnimations().size(); ++i)
+        animations.push_back(data->getAnimations()[i]->getName().buffer());
+    int found = 0;
+    int64_t start = esp_timer_get_time();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (auto& name : bones)
+            found += data->findBone(name.c_str()) != nullptr;
+        for (auto& name : slots)
+            found += data->findSlot(name.c_str()) != nullptr;
+        for (auto& name : animations)
+            found += data->findAnimation(name.c_str()) != nullptr;
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    // every name is found, or the lookup is broken
+    if (found != passes * (int)(bones.size() + slots.size() + animations.size()))
+        return -1;
+    return (int)elapsed;
+}
@@ -0,0 +1,53 @@
+#ifndef _SPINE_BENCH_H_
+#define _SPINE_BENCH_H_
+#include <stdint.h>
+
+class SpineNode;
+// Native side of tools/js_call_bench.js, used to time JS to native calls on the device. Only built, and
+// only bound to JS, with CONFIG_SPINE_BENCH on.
+class SpineBench
+{
+public:
+    // [JS_BINDING_BEGIN]
+    // does nothing, with the argument types of SpineNode::setAnimationById, to time the bare ffi call
+    static void benchNoop(SpineNode* node, int trackIndex, int animation, bool loop);
+    // microseconds since boot, truncated to 32 bits
+    static int benchMicros();
+    // microseconds for applying a two key deform timeline to a mesh of vertexCount vertices, of which
+    // movedVertices move, applies times. sparse keeps the keys trimmed as the loaders do, otherwise the
+    // keys cover every vertex. -1 when the spine runtime has no sparse deform keys (before 4.2).
+    static int benchDeform(int vertexCount, int movedVertices, int applies, bool sparse);
+    // microseconds for fetching texels from a 256x256 page in PSRAM and resolving them to RGB565 + alpha,
+    // along scaled and rotated spans as a textured triangle would. indexed reads an 8 bit page through
+    // its color table, otherwise the page is RGBA8888.
+    static int benchTexelFetch(bool indexed, int fetches);
+    // microseconds for updating the node updates times at 60 fps, live or through its baked impostor
+    // (see SpineNode::bakeImpostor). -1 when impostor is asked for and the node has none.
+    static int benchImpostor(SpineNode* node, int updates, bool impostor);
+    // microseconds for producing the vertices of every slot of the node's current pose passes times, as
+    // 16 bit fixed point (SpineNode::getFixedSlotGeometry) or as floats through the node transform
+    static int benchFixedVertices(SpineNode* node, int passes, bool fixed);
+    // largest difference between the fixed point and float vertices over frames poses, the current one
+    // and then one every update at 30 fps, in millionths of a pixel, or of the UV range when uvs
+    static int fixedPointError(SpineNode* node, int frames, bool uvs);
+    // copies of non trivial elements (strings, nested vectors) spine::Vector made since the last reset,
+    // or its buffer reallocations when reallocations. -1 unless built with SPINE_VECTOR_STATS defined.
+    static int vectorStats(bool reallocations, bool reset);
+    // heap blocks the spine runtime allocated since boot, the difference across a load is its allocations.
+    // -1 unless built with SPINE_ALLOCATION_STATS defined.
+    static int spineAllocations();
+    // free bytes of the heap spine allocates from, PSRAM included
+    static int freeHeap();
+    // distinct names interned for the node's skeleton data, or the bytes they take when bytes. -1 before
+    // spine 4.2, which doesn't intern names.
+    static int internedNames(SpineNode* node, bool bytes);
+    // microseconds for looking up every bone, slot and animation of the node by name passes times, from
+    // C strings as the JS API gets them
+    static int benchNameLookup(SpineNode* node, int passes);
+    // [JS_BINDING_END]
+private:
+    // largest fixed point error of the node's current pose, in pixels or UV units
+    static double poseFixedPointError(SpineNode* node, bool uvs);
+};
+
+#endif
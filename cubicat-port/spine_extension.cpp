@@ -3,8 +3,18 @@
 #include <string.h>
 #include "spine/SpineString.h"
 #include "cubicat.h"
+#ifdef SPINE_ALLOCATION_STATS
+#include <atomic>
+#endif
 
 CubicatSpineExtension* g_Instance = nullptr;
+#ifdef SPINE_ALLOCATION_STATS
+// any task may load or update skeletons, so the counter is atomic
+static std::atomic<uint32_t> g_iAllocations(0);
+#define SPINE_ALLOCATION_COUNT() g_iAllocations.fetch_add(1, std::memory_order_relaxed)
+#else
+#define SPINE_ALLOCATION_COUNT() ((void) 0)
+#endif
 
 CubicatSpineExtension::CubicatSpineExtension() {
 }
@@ -14,7 +24,15 @@ void CubicatSpineExtension::init() {
         SpineExtension::setInstance(g_Instance);
     }
 }
+int CubicatSpineExtension::getAllocations() {
+#ifdef SPINE_ALLOCATION_STATS
+    return (int)g_iAllocations.load(std::memory_order_relaxed);
+#else
+    return -1;
+#endif
+}
 void* CubicatSpineExtension::_alloc(size_t size, const char *file, int line) {
+    SPINE_ALLOCATION_COUNT();
     return psram_prefered_malloc(size);
 }
 
@@ -28,6 +46,8 @@ void* CubicatSpineExtension::_calloc(size_t size, const char *file, int line) {
 }
 
 void* CubicatSpineExtension::_realloc(void *ptr, size_t size, const char *file, int line) {
+    if (!ptr)
+        SPINE_ALLOCATION_COUNT();
     return psram_prefered_realloc(ptr, size);
 }
 
@@ -35,9 +55,18 @@ void CubicatSpineExtension::_free(void *mem, const char *file, int line) {
     heap_caps_free(mem);
 }
 
+// Skeletons and atlases are read from flash, or from the SD card when flash doesn't have them. Every read
+// resolves the same way, so animations read back later come from the file the skeleton was loaded from.
+static FILE* openFile(const String &path) {
+    FILE *file = CUBICAT.storage.openFileFlash(path.buffer());
+    if (!file)
+        file = CUBICAT.storage.openFileSD(path.buffer());
+    return file;
+}
+
 char* CubicatSpineExtension::_readFile(const String &path, int *length) {
     char *data;
-	FILE *file = CUBICAT.storage.openFileFlash(path.buffer());
+	FILE *file = openFile(path);
 	if (!file) {
         return 0;
     }
@@ -50,4 +79,19 @@ char* CubicatSpineExtension::_readFile(const String &path, int *length) {
 	fread(data, 1, *length, file);
 	fclose(file);
 	return data;
-}
\ No newline at end of file
+}
+#ifdef CONFIG_SPINE_VERSION_42
+char* CubicatSpineExtension::_readFile(const String &path, int offset, int length) {
+    FILE *file = openFile(path);
+    if (!file) {
+        return 0;
+    }
+    char *data = SpineExtension::alloc<char>(length, __FILE__, __LINE__);
+    if (fseek(file, offset, SEEK_SET) != 0 || fread(data, 1, length, file) != (size_t)length) {
+        SpineExtension::free(data, __FILE__, __LINE__);
+        data = 0;
+    }
+    fclose(file);
+    return data;
+}
+#endif
@@ -1,6 +1,7 @@
 #ifndef _CUBICAT_SPINE_EXTENSION_H_
 #define _CUBICAT_SPINE_EXTENSION_H_
 #include "spine/Extension.h"
+#include <stdint.h>
 
 using namespace spine;
 
@@ -9,6 +10,9 @@ public:
     CubicatSpineExtension();
     virtual ~CubicatSpineExtension() = default;
     static void init();
+    // heap blocks the spine runtime allocated since boot, reallocations of a block not counted. -1 unless
+    // built with SPINE_ALLOCATION_STATS defined.
+    static int getAllocations();
 protected:
     virtual void *_alloc(size_t size, const char *file, int line) override;
 
@@ -19,6 +23,9 @@ protected:
     virtual void _free(void *mem, const char *file, int line) override;
 
     virtual char *_readFile(const String &path, int *length) override;
+#ifdef CONFIG_SPINE_VERSION_42
+    virtual char *_readFile(const String &path, int offset, int length) override;
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "spine_hit_test.h"
+#include "spine_node.h"
+#include <algorithm>
+#include <math.h>
+#include <float.h>
+
+// a node covering more cells than this is kept out of the grid
+#define MAX_NODE_CELLS 64
+#define MIN_CELL_SIZE 16.0f
+
+SpineHitGrid& SpineHitGrid::get() {
+    static SpineHitGrid grid;
+    return grid;
+}
+
+void SpineHitGrid::add(SpineNode* node) {
+    if (node->m_iHitGridIndex >= 0)
+        return;
+    node->m_iHitGridIndex = (int)m_vEntries.size();
+    Entry entry;
+    entry.node = node;
+    m_vEntries.push_back(entry);
+    m_bDirty = true;
+}
+
+void SpineHitGrid::remove(SpineNode* node) {
+    int index = node->m_iHitGridIndex;
+    if (index < 0)
+        return;
+    m_vEntries.erase(m_vEntries.begin() + index);
+    for (size_t i = index; i < m_vEntries.size(); ++i)
+        m_vEntries[i].node->m_iHitGridIndex = (int)i;
+    node->m_iHitGridIndex = -1;
+    m_bDirty = true;
+}
+
+void SpineHitGrid::markDirty(SpineNode* node) {
+    int index = node->m_iHitGridIndex;
+    if (index < 0 || m_bDirty || m_vEntries[index].pending)
+        return;
+    m_vEntries[index].pending = true;
+    m_vPending.push_back(index);
+}
+
+uint64_t SpineHitGrid::cellKey(int cx, int cy) {
+    return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+}
+
+bool SpineHitGrid::nodeCells(SpineNode* node, int& x0, int& y0, int& x1, int& y1) {
+    if (!node->updateHitBounds())
+        return false;
+    // parent space AABB of the node's rotated skeleton space AABB
+    float m[6];
+    node->getNodeTransform(m);
+    const float* box = node->m_aHitAABB;
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (int corner = 0; corner < 4; ++corner) {
+        float bx = box[corner & 1 ? 2 : 0], by = box[corner & 2 ? 3 : 1];
+        float px = m[0] * bx + m[1] * by + m[4], py = m[2] * bx + m[3] * by + m[5];
+        minX = std::min(minX, px);
+        minY = std::min(minY, py);
+        maxX = std::max(maxX, px);
+        maxY = std::max(maxY, py);
+    }
+    x0 = (int)floorf(minX / m_fCellSize);
+    y0 = (int)floorf(minY / m_fCellSize);
+    x1 = (int)floorf(maxX / m_fCellSize);
+    y1 = (int)floorf(maxY / m_fCellSize);
+    return true;
+}
+
+// keeps each index list ascending, so candidates come out in draw order
+static void insertIndex(std::vector<uint32_t>& indices, uint32_t index) {
+    indices.insert(std::lower_bound(indices.begin(), indices.end(), index), index);
+}
+
+static void eraseIndex(std::vector<uint32_t>& indices, uint32_t index) {
+    auto it = std::lower_bound(indices.begin(), indices.end(), index);
+    if (it != indices.end() && *it == index)
+        indices.erase(it);
+}
+
+void SpineHitGrid::bin(uint32_t index) {
+    Entry& entry = m_vEntries[index];
+    entry.large = (int64_t)(entry.x1 - entry.x0 + 1) * (entry.y1 - entry.y0 + 1) > MAX_NODE_CELLS;
+    entry.binned = true;
+    if (entry.large) {
+        insertIndex(m_vLargeNodes, index);
+        return;
+    }
+    for (int cy = entry.y0; cy <= entry.y1; ++cy)
+        for (int cx = entry.x0; cx <= entry.x1; ++cx)
+            insertIndex(m_cells[cellKey(cx, cy)], index);
+}
+
+void SpineHitGrid::unbin(uint32_t index) {
+    Entry& entry = m_vEntries[index];
+    if (!entry.binned)
+        return;
+    entry.binned = false;
+    if (entry.large) {
+        eraseIndex(m_vLargeNodes, index);
+        return;
+    }
+    for (int cy = entry.y0; cy <= entry.y1; ++cy) {
+        for (int cx = entry.x0; cx <= entry.x1; ++cx) {
+            auto cell = m_cells.find(cellKey(cx, cy));
+            if (cell == m_cells.end())
+                continue;
+            eraseIndex(cell->second, index);
+            if (cell->second.empty())
+                m_cells.erase(cell);
+        }
+    }
+}
+
+void SpineHitGrid::rebuild() {
+    m_cells.clear();
+    m_vLargeNodes.clear();
+    m_vPending.clear();
+    // size cells after the average node so most nodes land in a few cells
+    float extent = 0;
+    int count = 0;
+    for (auto& entry : m_vEntries) {
+        entry.binned = false;
+        entry.pending = false;
+        SpineNode* node = entry.node;
+        if (!node->updateHitBounds())
+            continue;
+        extent += (node->m_aHitAABB[2] - node->m_aHitAABB[0]) + (node->m_aHitAABB[3] - node->m_aHitAABB[1]);
+        count++;
+    }
+    m_fCellSize = count ? std::max(MIN_CELL_SIZE, extent / (2 * count)) : MIN_CELL_SIZE;
+    for (uint32_t i = 0; i < m_vEntries.size(); ++i) {
+        Entry& entry = m_vEntries[i];
+        if (nodeCells(entry.node, entry.x0, entry.y0, entry.x1, entry.y1))
+            bin(i);
+    }
+    m_bDirty = false;
+}
+
+void SpineHitGrid::refresh() {
+    for (uint32_t i : m_vPending) {
+        Entry& entry = m_vEntries[i];
+        entry.pending = false;
+        int x0, y0, x1, y1;
+        bool valid = nodeCells(entry.node, x0, y0, x1, y1);
+        // most animating nodes stay in the same cells
+        if (valid == entry.binned && (!valid || (x0 == entry.x0 && y0 == entry.y0 && x1 == entry.x1 && y1 == entry.y1)))
+            continue;
+        unbin(i);
+        if (valid) {
+            entry.x0 = x0;
+            entry.y0 = y0;
+            entry.x1 = x1;
+            entry.y1 = y1;
+            bin(i);
+        }
+    }
+    m_vPending.clear();
+}
+
+SpineNode* SpineHitGrid::pick(float x, float y, std::string* boxName) {
+    if (m_bDirty)
+        rebuild();
+    else if (!m_vPending.empty())
+        refresh();
+    m_vCandidates = m_vLargeNodes;
+    auto it = m_cells.find(cellKey((int)floorf(x / m_fCellSize), (int)floorf(y / m_fCellSize)));
+    if (it != m_cells.end())
+        m_vCandidates.insert(m_vCandidates.end(), it->second.begin(), it->second.end());
+    // test from the top, candidates are node indices so the highest index draws last
+    std::sort(m_vCandidates.begin(), m_vCandidates.end());
+    for (auto i = m_vCandidates.rbegin(); i != m_vCandidates.rend(); ++i) {
+        SpineNode* node = m_vEntries[*i].node;
+        if (!node->isVisible())
+            continue;
+        float sx, sy;
+        node->toSkeletonSpace(x, y, sx, sy);
+        const char* name = node->hitTestSkeleton(sx, sy);
+        if (name) {
+            if (boxName)
+                *boxName = name;
+            return node;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,55 @@
+#ifndef _SPINE_HIT_TEST_H_
+#define _SPINE_HIT_TEST_H_
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <stdint.h>
+
+class SpineNode;
+// Uniform grid over the bounding box AABBs of loaded SpineNodes, so a scene wide pick only tests
+// the nodes whose cells hold the point. The nodes are expected to share a parent, their AABBs are
+// placed with each node's own position and rotation. A node that moved or animated is re-binned on
+// the next query, and only if its cells changed. Adding or removing nodes rebuilds the grid.
+class SpineHitGrid
+{
+public:
+    static SpineHitGrid& get();
+    void add(SpineNode* node);
+    void remove(SpineNode* node);
+    // the node's pose or transform changed
+    void markDirty(SpineNode* node);
+    // topmost node with a bounding box under the point (the nodes' parent space), nodes added later
+    // are on top
+    SpineNode* pick(float x, float y, std::string* boxName);
+private:
+    struct Entry {
+        SpineNode*  node;
+        // cells the node is binned in, inclusive
+        int         x0 = 0;
+        int         y0 = 0;
+        int         x1 = -1;
+        int         y1 = -1;
+        bool        binned = false;
+        bool        large = false;
+        bool        pending = false;
+    };
+    void rebuild();
+    void refresh();
+    // cell range of the node's current AABB, false when it has no visible box
+    bool nodeCells(SpineNode* node, int& x0, int& y0, int& x1, int& y1);
+    void bin(uint32_t index);
+    void unbin(uint32_t index);
+    static uint64_t cellKey(int cx, int cy);
+    std::vector<Entry>                                      m_vEntries;
+    // cell -> indices into m_vEntries, ascending
+    std::unordered_map<uint64_t, std::vector<uint32_t>>    m_cells;
+    // nodes spanning too many cells, tested for every query, ascending
+    std::vector<uint32_t>                                   m_vLargeNodes;
+    // entries to re-bin on the next query
+    std::vector<uint32_t>                                   m_vPending;
+    std::vector<uint32_t>                                   m_vCandidates;
+    float                                                   m_fCellSize = 64.0f;
+    bool                                                    m_bDirty = true;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "spine_impostor.h"
+#include "cubicat.h"
+#include "utils/logger.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+size_t SpineImpostor::m_sBudget = 0;
+size_t SpineImpostor::m_sTotalBytes = 0;
+
+SpineImpostor* SpineImpostor::create(float x, float y, int width, int height, float resolution, int frameCount,
+                                     float frameRate) {
+    if (width <= 0 || height <= 0 || frameCount <= 0 || height * frameCount > 0xffff || width > 0xffff)
+        return nullptr;
+    size_t bytes = (size_t)width * height * frameCount * 4;
+    if (m_sBudget && m_sTotalBytes + bytes > m_sBudget) {
+        LOGE("Spine: impostor of %u bytes is over the budget, %u of %u used", (unsigned)bytes,
+             (unsigned)m_sTotalBytes, (unsigned)m_sBudget);
+        return nullptr;
+    }
+    uint32_t* pixels = (uint32_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (!pixels)
+        return nullptr;
+    memset(pixels, 0, bytes);
+    SpineImpostor* impostor = NEW SpineImpostor();
+    impostor->m_pPixels = pixels;
+    impostor->m_fX = x;
+    impostor->m_fY = y;
+    impostor->m_iWidth = width;
+    impostor->m_iHeight = height;
+    impostor->m_fResolution = resolution;
+    impostor->m_iFrameCount = frameCount;
+    impostor->m_fFrameRate = frameRate;
+    m_sTotalBytes += bytes;
+    return impostor;
+}
+
+SpineImpostor::~SpineImpostor() {
+    m_sTotalBytes -= getBytes();
+    // once finished the texture owns the pixels
+    if (!m_texture)
+        free(m_pPixels);
+}
+
+size_t SpineImpostor::getBytes() {
+    return (size_t)m_iWidth * m_iHeight * m_iFrameCount * 4;
+}
+
+void SpineImpostor::drawSlot(int frame, const SpineSlotGeometry& geometry, const PageImage& image) {
+    if (m_texture || frame < 0 || frame >= m_iFrameCount)
+        return;
+    uint32_t* pixels = m_pPixels + (size_t)frame * m_iWidth * m_iHeight;
+    for (int i = 0; i + 2 < geometry.indexCount; i += 3) {
+        int i0 = geometry.indices[i] * 2;
+        int i1 = geometry.indices[i + 1] * 2;
+        int i2 = geometry.indices[i + 2] * 2;
+        drawTriangle(pixels, geometry.positions + i0, geometry.positions + i1, geometry.positions + i2,
+                     geometry.uvs + i0, geometry.uvs + i1, geometry.uvs + i2, geometry.blendMode, image);
+    }
+}
+
+// which side of the edge a to b the point is on, twice the area of the triangle they form
+static inline float edge(float ax, float ay, float bx, float by, float px, float py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+// pixels on an edge shared by two triangles belong to one of them only
+static inline bool covers(float w, float dx, float dy) {
+    return w > 0 || (w == 0 && (dy < 0 || (dy == 0 && dx > 0)));
+}
+
+void SpineImpostor::drawTriangle(uint32_t* frame, const float* p0, const float* p1, const float* p2,
+                                 const float* uv0, const float* uv1, const float* uv2, BlendMode blendMode,
+                                 const PageImage& image) {
+    float x0 = (p0[0] - m_fX) * m_fResolution, y0 = (p0[1] - m_fY) * m_fResolution;
+    float x1 = (p1[0] - m_fX) * m_fResolution, y1 = (p1[1] - m_fY) * m_fResolution;
+    float x2 = (p2[0] - m_fX) * m_fResolution, y2 = (p2[1] - m_fY) * m_fResolution;
+    float area = edge(x0, y0, x1, y1, x2, y2);
+    if (area == 0)
+        return;
+    // wind counter clockwise so the inside has positive edge values
+    if (area < 0) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+        std::swap(uv1, uv2);
+        area = -area;
+    }
+    int minX = std::max(0, (int)floorf(std::min(x0, std::min(x1, x2))));
+    int minY = std::max(0, (int)floorf(std::min(y0, std::min(y1, y2))));
+    int maxX = std::min(m_iWidth - 1, (int)ceilf(std::max(x0, std::max(x1, x2))));
+    int maxY = std::min(m_iHeight - 1, (int)ceilf(std::max(y0, std::max(y1, y2))));
+    float inv = 1.0f / area;
+    for (int y = minY; y <= maxY; ++y) {
+        float py = y + 0.5f;
+        for (int x = minX; x <= maxX; ++x) {
+            float px = x + 0.5f;
+            float w0 = edge(x1, y1, x2, y2, px, py);
+            float w1 = edge(x2, y2, x0, y0, px, py);
+            float w2 = edge(x0, y0, x1, y1, px, py);
+            if (!covers(w0, x2 - x1, y2 - y1) || !covers(w1, x0 - x2, y0 - y2) || !covers(w2, x1 - x0, y1 - y0))
+                continue;
+            w0 *= inv;
+            w1 *= inv;
+            w2 *= inv;
+            uint32_t texel = image.sample(w0 * uv0[0] + w1 * uv1[0] + w2 * uv2[0],
+                                          w0 * uv0[1] + w1 * uv1[1] + w2 * uv2[1]);
+            uint32_t a = texel & 0xff;
+            if (!a)
+                continue;
+            uint32_t r = (texel >> 24) * a / 255, g = ((texel >> 16) & 0xff) * a / 255, b = ((texel >> 8) & 0xff) * a / 255;
+            uint32_t& dst = frame[y * m_iWidth + x];
+            uint32_t dr = dst >> 24, dg = (dst >> 16) & 0xff, db = (dst >> 8) & 0xff, da = dst & 0xff;
+            if (blendMode == BlendMode::Additive) {
+                // only brightens what the skeleton drew below, the background behind the quad is unknown
+                dr = std::min(255u, dr + r);
+                dg = std::min(255u, dg + g);
+                db = std::min(255u, db + b);
+            } else if (blendMode == BlendMode::Multiply) {
+                uint32_t keep = 255 - a;
+                dr = (dr * (texel >> 24) / 255 * a + dr * keep) / 255;
+                dg = (dg * ((texel >> 16) & 0xff) / 255 * a + dg * keep) / 255;
+                db = (db * ((texel >> 8) & 0xff) / 255 * a + db * keep) / 255;
+            } else {
+                uint32_t keep = 255 - a;
+                dr = r + dr * keep / 255;
+                dg = g + dg * keep / 255;
+                db = b + db * keep / 255;
+                da = a + da * keep / 255;
+            }
+            dst = (dr << 24) | (dg << 16) | (db << 8) | da;
+        }
+    }
+}
+
+void SpineImpostor::finish() {
+    if (m_texture)
+        return;
+    size_t count = (size_t)m_iWidth * m_iHeight * m_iFrameCount;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t c = m_pPixels[i];
+        uint32_t a = c & 0xff;
+        if (!a || a == 255)
+            continue;
+        uint32_t r = std::min(255u, (c >> 24) * 255 / a);
+        uint32_t g = std::min(255u, ((c >> 16) & 0xff) * 255 / a);
+        uint32_t b = std::min(255u, ((c >> 8) & 0xff) * 255 / a);
+        m_pPixels[i] = (r << 24) | (g << 16) | (b << 8) | a;
+    }
+    m_texture = TexturePtr(NEW Texture(m_iWidth, m_iHeight * m_iFrameCount, m_pPixels, true, 1, 1, nullptr, 32, true));
+    float x1 = m_fX + m_iWidth / m_fResolution;
+    float y1 = m_fY + m_iHeight / m_fResolution;
+    float quad[8] = {m_fX, m_fY, x1, m_fY, x1, y1, m_fX, y1};
+    memcpy(m_aQuadVertices, quad, sizeof(quad));
+}
+
+void SpineImpostor::getGeometry(float animationTime, SpineSlotGeometry& out) {
+    static uint16_t indices[] = {0, 1, 2, 0, 2, 3};
+    int frame = (int)(animationTime * m_fFrameRate) % m_iFrameCount;
+    if (frame < 0)
+        frame += m_iFrameCount;
+    float v0 = (float)frame / m_iFrameCount;
+    float v1 = (float)(frame + 1) / m_iFrameCount;
+    float uvs[8] = {0, v0, 1, v0, 1, v1, 0, v1};
+    memcpy(m_aQuadUVs, uvs, sizeof(uvs));
+    out.texture = m_texture;
+    out.blendMode = BlendMode::Normal;
+    out.positions = m_aQuadVertices;
+    out.uvs = m_aQuadUVs;
+    out.vertexCount = 4;
+    out.indices = indices;
+    out.indexCount = 6;
+}
@@ -0,0 +1,49 @@
+#ifndef _SPINE_IMPOSTOR_H_
+#define _SPINE_IMPOSTOR_H_
+#include <stdint.h>
+#include <stddef.h>
+#include "spine_batcher.h"
+#include "texture_loader.h"
+
+// A looping animation rendered once on the CPU into a strip of small frames, stacked vertically in one
+// RGBA8888 texture, and played back as a single textured quad. Frames cover the skeleton space
+// rectangle (x, y) to (x + width / resolution, y + height / resolution), row 0 at y.
+class SpineImpostor
+{
+public:
+    // null when the frames would push the impostors over the budget
+    static SpineImpostor* create(float x, float y, int width, int height, float resolution, int frameCount,
+                                 float frameRate);
+    ~SpineImpostor();
+    // draw a slot into a frame, its texture read back through image
+    void drawSlot(int frame, const SpineSlotGeometry& geometry, const PageImage& image);
+    // frames are drawn, hand them to a texture
+    void finish();
+    // the quad showing the frame at the animation time, loops
+    void getGeometry(float animationTime, SpineSlotGeometry& out);
+    int getFrameCount() { return m_iFrameCount; }
+    size_t getBytes();
+    // bytes all impostors may hold, 0 for no limit. Doesn't evict existing ones.
+    static void setBudget(size_t bytes) { m_sBudget = bytes; }
+    static size_t getTotalBytes() { return m_sTotalBytes; }
+private:
+    SpineImpostor() = default;
+    void drawTriangle(uint32_t* frame, const float* p0, const float* p1, const float* p2, const float* uv0,
+                      const float* uv1, const float* uv2, BlendMode blendMode, const PageImage& image);
+    static size_t       m_sBudget;
+    static size_t       m_sTotalBytes;
+    // premultiplied while drawing, straight alpha once finished
+    uint32_t*           m_pPixels = nullptr;
+    TexturePtr          m_texture;
+    float               m_fX = 0;
+    float               m_fY = 0;
+    int                 m_iWidth = 0;
+    int                 m_iHeight = 0;
+    float               m_fResolution = 1;
+    int                 m_iFrameCount = 0;
+    float               m_fFrameRate = 0;
+    float               m_aQuadVertices[8];
+    float               m_aQuadUVs[8];
+};
+
+#endif
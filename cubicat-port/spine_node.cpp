@@ -8,13 +8,26 @@
 #include "spine/ClippingAttachment.h"
 #include "spine/RegionAttachment.h"
 #include "spine/MeshAttachment.h"
+#include "spine/BoundingBoxAttachment.h"
 #include "spine/SlotData.h"
+#include "spine/BoneData.h"
 #include "spine/Bone.h"
+#include "spine/Skin.h"
+#include "spine/MathUtil.h"
 #include "utils/logger.h"
 #include "utils/helper.h"
 #include "spine/Animation.h"
+#include "spine/Event.h"
+#ifdef CONFIG_SPINE_VERSION_42
+#include "spine/AnimationCache.h"
+#endif
 #include "graphic_engine/drawable/polygon2d.h"
 #include "graphic_engine/renderer/renderer.h"
+#include "spine_hit_test.h"
+#include "esp_timer.h"
+#include <float.h>
+#include <stdio.h>
+#include <math.h>
 
 using namespace cubicat;
 
@@ -56,40 +69,63 @@ bool nothingToDraw(Slot &slot, int startSlotIndex, int endSlotIndex) {
     return false;
 }
 #if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+#define PAGE_TEXTURE(page) ((page)->getRendererObject())
+#define ATTACHMENT_REGION(attachmentType, attachment) ((AtlasRegion*)((attachmentType*)attachment)->getRendererObject())
+#define SLOT_REGION(attachmentType, attachment, slot) ATTACHMENT_REGION(attachmentType, attachment)
+#define SLOT_UVS(attachmentType, attachment, slot) (((attachmentType*)attachment)->getUVs().buffer())
+#else
+#define PAGE_TEXTURE(page) ((page)->texture)
+#define ATTACHMENT_REGION(attachmentType, attachment) ((AtlasRegion*)((attachmentType*)attachment)->getRegion())
+// sequence attachments draw the slot's frame from the attachment's precomputed tables
+#define SLOT_REGION(attachmentType, attachment, slot) ((AtlasRegion*)((attachmentType*)attachment)->getRegion(slot))
+#define SLOT_UVS(attachmentType, attachment, slot) (((attachmentType*)attachment)->getUVs(slot))
+#endif
 
-#define ASSIGN_TEXTURE(attachmentType, attachment) \
-    auto att = (attachmentType*)attachment; \
-    auto atlasRegion = (AtlasRegion*)att->getRendererObject(); \
-    if (atlasRegion) { \
-        auto page = atlasRegion->page; \
-        if (page->texturePath.length() > 0) { \
-            auto it = m_textureMap.find(page->texturePath.buffer()); \
-            if (it == m_textureMap.end()) { \
-                TexturePtr texture = SharedPtr<Texture>((Texture*)page->getRendererObject()); \
-                if (texture) { \
-                    m_textureMap[page->texturePath.buffer()] = texture; \
-                } \
-            } \
-            poly->getMaterial()->setTexture(m_textureMap[page->texturePath.buffer()]); \
-        } \
+#define SLOT_TEXTURE(attachmentType, attachment, slot) \
+    auto atlasRegion = SLOT_REGION(attachmentType, attachment, slot); \
+    out.texture = atlasRegion ? acquirePageTexture(atlasRegion->page) : nullptr;
+
+void collectAttachmentPages(Attachment* attachment, std::set<AtlasPage*>& pages) {
+    AtlasRegion* region = nullptr;
+    if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+        region = ATTACHMENT_REGION(RegionAttachment, attachment);
+#ifdef CONFIG_SPINE_VERSION_42
+        auto sequence = ((RegionAttachment*)attachment)->getSequence();
+        if (sequence) {
+            auto& regions = sequence->getRegions();
+            for (size_t i = 0; i < regions.size(); ++i) {
+                if (regions[i])
+                    pages.insert(((AtlasRegion*)regions[i])->page);
+            }
+        }
+#endif
+    } else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+        region = ATTACHMENT_REGION(MeshAttachment, attachment);
+#ifdef CONFIG_SPINE_VERSION_42
+        auto sequence = ((MeshAttachment*)attachment)->getSequence();
+        if (sequence) {
+            auto& regions = sequence->getRegions();
+            for (size_t i = 0; i < regions.size(); ++i) {
+                if (regions[i])
+                    pages.insert(((AtlasRegion*)regions[i])->page);
+            }
+        }
+#endif
     }
-#else
-#define ASSIGN_TEXTURE(attachmentType, attachment) \
-    auto att = (attachmentType*)attachment; \
-    auto atlasRegion = (AtlasRegion*)att->getRegion(); \
-    if (atlasRegion) { \
-        auto page = atlasRegion->page; \
-        if (page->texturePath.length() > 0) { \
-            auto it = m_textureMap.find(page->texturePath.buffer()); \
-            if (it == m_textureMap.end()) { \
-                TexturePtr texture = SharedPtr<Texture>((Texture*)page->texture); \
-                if (texture) \
-                    m_textureMap[page->texturePath.buffer()] = texture; \
-            } \
-            poly->getMaterial()->setTexture(m_textureMap[page->texturePath.buffer()]); \
-        } \
+    if (region && region->page)
+        pages.insert(region->page);
+}
+
+void collectSkinPages(Skin* skin, std::set<AtlasPage*>& pages) {
+    if (!skin)
+        return;
+    auto entries = skin->getAttachments();
+    while (entries.hasNext()) {
+        auto& entry = entries.next();
+        if (entry._attachment)
+            collectAttachmentPages(entry._attachment, pages);
     }
-#endif
+}
 
 CubicatTextureLoader SpineNode::m_sTextureLoader;
 
@@ -97,6 +133,10 @@ SpineNode::SpineNode() {
 }
 
 SpineNode::~SpineNode() {
+    if (m_pBatcher)
+        m_pBatcher->removeNode(this);
+    if (m_pScheduler)
+        m_pScheduler->removeNode(this);
     unload();
 }
 
@@ -106,22 +146,61 @@ SpineNode* SpineNode::createSpine() {
 
 void SpineNode::loadWithBinaryFile(const std::string &skeletonBinaryFile, const std::string &atlasFile, float scale) {
     unload();
-    m_pAtlas = new Atlas(atlasFile.c_str(), &m_sTextureLoader, true);
+    // pages are decoded lazily, see updatePageResidency
+    m_pAtlas = new Atlas(atlasFile.c_str(), &m_sTextureLoader, false);
     m_pAttachmentLoader = new AtlasAttachmentLoader(m_pAtlas);
 
     SkeletonBinary binary(m_pAttachmentLoader);
     binary.setScale(scale);
+#ifdef CONFIG_SPINE_VERSION_42
+    binary.setLazyAnimations(m_bLazyAnimations);
+    for (auto& name : m_vRequiredSkins)
+        binary.addRequiredSkin(name.c_str());
+    for (auto& name : m_vRequiredAnimations)
+        binary.addRequiredAnimation(name.c_str());
+    binary.setStripUnreachable(m_bStripUnreachable);
+    binary.setQuantizeAnimations(m_bQuantizeAnimations);
+#endif
     SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonBinaryFile.c_str());
     if (!skeletonData || !binary.getError().isEmpty()) {
         LOGE("Spine: Error reading skeleton data: %s", binary.getError().buffer());
         return;
     }
+#ifdef CONFIG_SPINE_VERSION_42
+    auto& report = binary.getStripReport();
+    if (report.skins || report.attachments || report.animations)
+        LOGI("Spine: stripped %d skins, %d attachments, %d animations (~%u bytes)", report.skins,
+             report.attachments, report.animations, (unsigned)report.bytes);
+    if (skeletonData->getAnimationCache())
+        skeletonData->getAnimationCache()->setBudget(m_iAnimationBudget);
+#endif
     m_pSkeleton = new Skeleton(skeletonData);
+#ifdef CONFIG_SPINE_VERSION_42
+    m_pSkeleton->setPhysicsMaxSteps(m_iPhysicsMaxSteps, m_bPhysicsDefer ? PhysicsSteps_Defer : PhysicsSteps_Drop);
+#endif
     initialize();
 }
 void SpineNode::unload() {
+    SpineHitGrid::get().remove(this);
+#ifdef CONFIG_SPINE_VERSION_42
+    clearPoses();
+#endif
+    m_vHitBoxes.clear();
+    m_bHitBoundsValid = false;
+    m_fixedUVs.clear();
+    m_bPoseCaptured = false;
+    for (auto& pose : m_aPoseVertices) {
+        pose.positions.clear();
+        pose.attachments.clear();
+        pose.starts.clear();
+    }
+    releaseImpostor();
     clearDrawables();
-    m_textureMap.clear();
+    releasePageTextures();
+    m_iEventCount = 0;
+    m_animationHandles.clear();
+    m_eventHandles.clear();
+    m_vAnimationNames.clear();
     if (m_pSkeleton) {
         delete m_pSkeleton->getData();
         delete m_pSkeleton;
@@ -151,36 +230,164 @@ void SpineNode::initialize() {
     auto& anims = m_pSkeleton->getData()->getAnimations();
     for (int i=0;i<anims.size();i++) {
         m_vAnimationNames.push_back(anims[i]->getName().buffer());
+        m_animationHandles[anims[i]] = i;
     }
+    auto& events = m_pSkeleton->getData()->getEvents();
+    for (int i = 0; i < (int)events.size(); ++i)
+        m_eventHandles[events[i]] = i;
+    if (m_bEventsEnabled)
+        m_pAnimState->setListener(&m_eventCollector);
     setSkinByIndex(0);
+    initHitBoxes();
 }
 void SpineNode::setSkinByName(const std::string &skinName) {
+    leaveImpostor();
     if (m_pSkeleton) {
-        if (!skinName.empty())
+        if (!skinName.empty()) {
             m_pSkeleton->setSkin(skinName.c_str());
+            updatePageResidency();
+        }
     }
 }
 
 void SpineNode::setSkinByIndex(int idx) {
+    leaveImpostor();
     if (m_pSkeleton) {
-        auto data = m_pSkeleton->getData();
-        auto skins = data->getSkins();
-        // remove default skin
-        skins.removeAt(0);
-        if (!skins.size())
+        auto& skins = m_pSkeleton->getData()->getSkins();
+        // skip default skin
+        int count = (int)skins.size() - 1;
+        if (count <= 0)
             return;
-        idx = idx % skins.size();
+        idx = idx % count;
         if (idx < 0)
-            idx = skins.size() + idx;
-        m_pSkeleton->setSkin(skins[idx]);
+            idx = count + idx;
+        m_pSkeleton->setSkin(skins[idx + 1]);
+        updatePageResidency();
+    }
+}
+
+TexturePtr SpineNode::acquirePageTexture(AtlasPage* page) {
+    if (!page || page->texturePath.length() == 0)
+        return nullptr;
+    auto it = m_textureMap.find(page->texturePath.buffer());
+    if (it != m_textureMap.end())
+        return it->second;
+    TexturePtr texture = m_sTextureLoader.acquirePage(*page);
+    if (texture)
+        m_textureMap[page->texturePath.buffer()] = texture;
+    return texture;
+}
+
+void SpineNode::updatePageResidency() {
+    if (!m_pSkeleton || !m_pAtlas)
+        return;
+    std::set<AtlasPage*> pages;
+    collectSkinPages(m_pSkeleton->getData()->getDefaultSkin(), pages);
+    collectSkinPages(m_pSkeleton->getSkin(), pages);
+    auto& atlasPages = m_pAtlas->getPages();
+    for (size_t i = 0; i < atlasPages.size(); ++i) {
+        AtlasPage* page = atlasPages[i];
+        if (pages.count(page)) {
+            acquirePageTexture(page);
+        } else if (PAGE_TEXTURE(page)) {
+            // drawables still holding the texture keep it alive until they switch pages
+            m_textureMap.erase(page->texturePath.buffer());
+            m_sTextureLoader.releasePage(*page);
+        }
+    }
+}
+
+void SpineNode::releasePageTextures() {
+    if (!m_pAtlas)
+        return;
+    auto& atlasPages = m_pAtlas->getPages();
+    for (size_t i = 0; i < atlasPages.size(); ++i)
+        m_sTextureLoader.releasePage(*atlasPages[i]);
+    m_textureMap.clear();
+}
+
+#ifdef CONFIG_SPINE_VERSION_42
+void SpineNode::setLazyAnimations(bool lazy, size_t budgetBytes) {
+    m_bLazyAnimations = lazy;
+    m_iAnimationBudget = budgetBytes;
+    if (m_pSkeleton && m_pSkeleton->getData()->getAnimationCache())
+        m_pSkeleton->getData()->getAnimationCache()->setBudget(budgetBytes);
+}
+void SpineNode::setLoadFilter(const std::vector<std::string>& skins, const std::vector<std::string>& animations,
+                              bool stripUnreachable) {
+    m_vRequiredSkins = skins;
+    m_vRequiredAnimations = animations;
+    m_bStripUnreachable = stripUnreachable;
+}
+void SpineNode::setPhysicsMaxSteps(int maxSteps, bool defer) {
+    m_iPhysicsMaxSteps = maxSteps;
+    m_bPhysicsDefer = defer;
+    if (m_pSkeleton)
+        m_pSkeleton->setPhysicsMaxSteps(maxSteps, defer ? PhysicsSteps_Defer : PhysicsSteps_Drop);
+}
+void SpineNode::seek(float trackTime) {
+    leaveImpostor();
+    if (!m_pSkeleton || !m_pAnimState)
+        return;
+    m_pAnimState->applyAt(*m_pSkeleton, trackTime);
+    // pose physics without stepping it, scrubbing back and forth must not build up motion
+    m_pSkeleton->updateWorldTransform(Physics_Pose);
+    poseChanged();
+}
+int SpineNode::capturePose() {
+    if (!m_pSkeleton)
+        return -1;
+    SkeletonPose* pose = new SkeletonPose();
+    pose->capture(*m_pSkeleton);
+    m_vPoses.push_back(pose);
+    return (int)m_vPoses.size() - 1;
+}
+bool SpineNode::restorePose(int index) {
+    leaveImpostor();
+    if (!m_pSkeleton || index < 0 || index >= (int)m_vPoses.size())
+        return false;
+    if (!m_vPoses[index]->restore(*m_pSkeleton)) {
+        LOGE("Spine: Pose %d was captured from another skeleton", index);
+        return false;
     }
+    poseChanged();
+    return true;
+}
+void SpineNode::clearPoses() {
+    for (auto pose : m_vPoses)
+        delete pose;
+    m_vPoses.clear();
+}
+#endif
+
+size_t SpineNode::getResidentTextureBytes() {
+    if (!m_pAtlas)
+        return 0;
+    size_t bytes = 0;
+    auto& atlasPages = m_pAtlas->getPages();
+    for (size_t i = 0; i < atlasPages.size(); ++i) {
+        if (PAGE_TEXTURE(atlasPages[i]))
+            bytes += CubicatTextureLoader::getPageBytes(*atlasPages[i]);
+    }
+    return bytes;
+}
+
+size_t SpineNode::getSharedTextureBytes() {
+    return m_sTextureLoader.getSharedBytes();
 }
 
 TrackEntry* SpineNode::setAnimation(int trackIndex, int animIndex, bool loop) {
-    auto name = getAnimationName(animIndex);
-    return setAnimation(trackIndex, name, loop);
+    if (!m_pSkeleton)
+        return nullptr;
+    int count = (int)m_pSkeleton->getData()->getAnimations().size();
+    if (count == 0)
+        return nullptr;
+    animIndex = animIndex % count;
+    if (animIndex < 0) animIndex = count + animIndex;
+    return setAnimationById(trackIndex, animIndex, loop);
 }
 TrackEntry* SpineNode::setAnimation(int trackIndex, const std::string &name, bool loop) {
+    leaveImpostor();
     if (!m_pSkeleton || !m_pAnimState)
         return nullptr;
     Animation *animation = m_pSkeleton->getData()->findAnimation(name.c_str());
@@ -191,8 +398,14 @@ TrackEntry* SpineNode::setAnimation(int trackIndex, const std::string &name, boo
     return m_pAnimState->setAnimation(trackIndex, animation, loop);
 }
 TrackEntry* SpineNode::addAnimation(int trackIndex, int animIndex, bool loop, float delay) {
-    auto name = getAnimationName(animIndex);
-    return addAnimation(trackIndex, name, loop, delay);
+    if (!m_pSkeleton)
+        return nullptr;
+    int count = (int)m_pSkeleton->getData()->getAnimations().size();
+    if (count == 0)
+        return nullptr;
+    animIndex = animIndex % count;
+    if (animIndex < 0) animIndex = count + animIndex;
+    return addAnimationById(trackIndex, animIndex, loop, delay);
 }
 TrackEntry* SpineNode::addAnimation(int trackIndex, const std::string &name, bool loop, float delay) {
     if (!m_pSkeleton || !m_pAnimState)
@@ -205,17 +418,314 @@ TrackEntry* SpineNode::addAnimation(int trackIndex, const std::string &name, boo
     return m_pAnimState->addAnimation(trackIndex, animation, loop, delay);
 }
 void SpineNode::clearTrack(int trackIndex) {
+    leaveImpostor();
     if (m_pAnimState) {
         m_pAnimState->setEmptyAnimation(trackIndex, 0);
     }
 }
+// the name to compare the data's names with, made once per search. From 4.2 it's the data's interned copy
+// when there is one, compared by pointer, otherwise name borrowed.
+static spine::String nameKey(SkeletonData* data, const std::string &name) {
+#ifdef CONFIG_SPINE_VERSION_42
+    return data->getNames().lookup(name.c_str());
+#else
+    SP_UNUSED(data);
+    return spine::String(name.c_str());
+#endif
+}
+int SpineNode::findAnimation(const std::string &name) {
+    if (!m_pSkeleton)
+        return -1;
+    auto key = nameKey(m_pSkeleton->getData(), name);
+    auto& animations = m_pSkeleton->getData()->getAnimations();
+    for (int i = 0; i < (int)animations.size(); ++i) {
+        if (animations[i]->getName() == key)
+            return i;
+    }
+    return -1;
+}
+int SpineNode::findSkin(const std::string &name) {
+    if (!m_pSkeleton)
+        return -1;
+    auto key = nameKey(m_pSkeleton->getData(), name);
+    auto& skins = m_pSkeleton->getData()->getSkins();
+    for (int i = 0; i < (int)skins.size(); ++i) {
+        if (skins[i]->getName() == key)
+            return i;
+    }
+    return -1;
+}
+int SpineNode::findBone(const std::string &name) {
+    if (!m_pSkeleton)
+        return -1;
+    auto bone = m_pSkeleton->getData()->findBone(name.c_str());
+    return bone ? bone->getIndex() : -1;
+}
+int SpineNode::findSlot(const std::string &name) {
+    if (!m_pSkeleton)
+        return -1;
+    auto slot = m_pSkeleton->getData()->findSlot(name.c_str());
+    return slot ? slot->getIndex() : -1;
+}
+TrackEntry* SpineNode::setAnimationById(int trackIndex, int animation, bool loop) {
+    leaveImpostor();
+    if (!m_pSkeleton || !m_pAnimState || trackIndex < 0)
+        return nullptr;
+    auto& animations = m_pSkeleton->getData()->getAnimations();
+    if (animation < 0 || animation >= (int)animations.size()) {
+        LOGE("Spine: Animation handle out of range: %d", animation);
+        return nullptr;
+    }
+    return m_pAnimState->setAnimation(trackIndex, animations[animation], loop);
+}
+TrackEntry* SpineNode::addAnimationById(int trackIndex, int animation, bool loop, float delay) {
+    if (!m_pSkeleton || !m_pAnimState || trackIndex < 0)
+        return nullptr;
+    auto& animations = m_pSkeleton->getData()->getAnimations();
+    if (animation < 0 || animation >= (int)animations.size()) {
+        LOGE("Spine: Animation handle out of range: %d", animation);
+        return nullptr;
+    }
+    return m_pAnimState->addAnimation(trackIndex, animations[animation], loop, delay);
+}
+void SpineNode::setSkinById(int skin) {
+    leaveImpostor();
+    if (!m_pSkeleton)
+        return;
+    auto& skins = m_pSkeleton->getData()->getSkins();
+    if (skin < 0 || skin >= (int)skins.size()) {
+        LOGE("Spine: Skin handle out of range: %d", skin);
+        return;
+    }
+    m_pSkeleton->setSkin(skins[skin]);
+    updatePageResidency();
+}
+float SpineNode::getBoneWorldX(int bone) {
+    if (!m_pSkeleton || bone < 0 || bone >= (int)m_pSkeleton->getBones().size())
+        return 0;
+    poseImpostorSkeleton();
+    return m_pSkeleton->getBones()[bone]->getWorldX();
+}
+float SpineNode::getBoneWorldY(int bone) {
+    if (!m_pSkeleton || bone < 0 || bone >= (int)m_pSkeleton->getBones().size())
+        return 0;
+    poseImpostorSkeleton();
+    return m_pSkeleton->getBones()[bone]->getWorldY();
+}
+void SpineNode::setBonePosition(int bone, float x, float y) {
+    leaveImpostor();
+    if (!m_pSkeleton || bone < 0 || bone >= (int)m_pSkeleton->getBones().size())
+        return;
+    m_pSkeleton->getBones()[bone]->setX(x);
+    m_pSkeleton->getBones()[bone]->setY(y);
+}
+void SpineNode::setSlotColor(int slot, float r, float g, float b, float a) {
+    leaveImpostor();
+    if (!m_pSkeleton || slot < 0 || slot >= (int)m_pSkeleton->getSlots().size())
+        return;
+    m_pSkeleton->getSlots()[slot]->getColor().set(r, g, b, a);
+}
+void SpineNode::enableEvents(bool enable, int capacity) {
+    m_bEventsEnabled = enable;
+    m_vEvents.resize(enable && capacity > 0 ? capacity : 0);
+    m_iEventHead = 0;
+    m_iEventCount = 0;
+    m_iDroppedEvents = 0;
+    m_eventCollector.node = this;
+    if (m_pAnimState)
+        m_pAnimState->setListener(enable ? &m_eventCollector : (AnimationStateListenerObject*)nullptr);
+}
+void SpineNode::EventCollector::callback(AnimationState* state, EventType type, TrackEntry* entry, Event* event) {
+    SP_UNUSED(state);
+    node->pushEvent(type, entry, event);
+}
+void SpineNode::pushEvent(EventType type, TrackEntry* entry, Event* event) {
+    if (type == EventType_Dispose || m_vEvents.empty())
+        return;
+    int capacity = (int)m_vEvents.size();
+    if (m_iEventCount == capacity) {
+        m_iEventHead = (m_iEventHead + 1) % capacity;
+        m_iEventCount--;
+        m_iDroppedEvents++;
+    }
+    EventRecord& record = m_vEvents[(m_iEventHead + m_iEventCount) % capacity];
+    m_iEventCount++;
+    record.type = type;
+    record.trackIndex = entry ? entry->getTrackIndex() : -1;
+    auto animation = entry ? m_animationHandles.find(entry->getAnimation()) : m_animationHandles.end();
+    record.animation = animation != m_animationHandles.end() ? animation->second : -1;
+    record.event = -1;
+    record.intValue = 0;
+    record.floatValue = 0;
+    if (event) {
+        auto handle = m_eventHandles.find(&event->getData());
+        record.event = handle != m_eventHandles.end() ? handle->second : -1;
+        record.intValue = event->getIntValue();
+        record.floatValue = event->getFloatValue();
+    }
+}
+char* SpineNode::drainEvents() {
+    m_sDrainedEvents.clear();
+    m_sDrainedEvents += '[';
+    char buf[80];
+    int capacity = (int)m_vEvents.size();
+    for (int i = 0; i < m_iEventCount; ++i) {
+        const EventRecord& r = m_vEvents[(m_iEventHead + i) % capacity];
+        snprintf(buf, sizeof(buf), "%s%d,%d,%d,%d,%d,%g", i ? "," : "", r.type, r.trackIndex, r.animation, r.event,
+                 r.intValue, r.floatValue);
+        m_sDrainedEvents += buf;
+    }
+    m_sDrainedEvents += ']';
+    m_iEventHead = 0;
+    m_iEventCount = 0;
+    m_iDroppedEvents = 0;
+    return &m_sDrainedEvents[0];
+}
+int SpineNode::getDroppedEvents() {
+    return m_iDroppedEvents;
+}
+int SpineNode::findEvent(const std::string &name) {
+    if (!m_pSkeleton)
+        return -1;
+    auto key = nameKey(m_pSkeleton->getData(), name);
+    auto& events = m_pSkeleton->getData()->getEvents();
+    for (int i = 0; i < (int)events.size(); ++i) {
+        if (events[i]->getName() == key)
+            return i;
+    }
+    return -1;
+}
+// [-]digits[.digits], the only number format commands use, cheaper than strtof
+static bool parseCommandNumber(const char*& p, float& out) {
+    const char* s = p;
+    while (*s == ' ' || *s == '\t')
+        s++;
+    bool negative = *s == '-';
+    if (negative)
+        s++;
+    if ((*s < '0' || *s > '9') && *s != '.')
+        return false;
+    float value = 0;
+    while (*s >= '0' && *s <= '9')
+        value = value * 10 + (*s++ - '0');
+    if (*s == '.') {
+        s++;
+        float scale = 0.1f;
+        while (*s >= '0' && *s <= '9') {
+            value += (*s++ - '0') * scale;
+            scale *= 0.1f;
+        }
+    }
+    out = negative ? -value : value;
+    p = s;
+    return true;
+}
+int SpineNode::runCommands(const std::string &commands) {
+    if (!m_pSkeleton || !m_pAnimState)
+        return 0;
+    int applied = 0;
+    const char* p = commands.c_str();
+    while (true) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' || *p == ';')
+            p++;
+        if (*p == '\0')
+            break;
+        char op = *p++;
+        float args[4];
+        int argc = 0;
+        while (argc < 4 && parseCommandNumber(p, args[argc]))
+            argc++;
+        while (*p == ' ' || *p == '\t' || *p == '\r')
+            p++;
+        if (*p != ';' && *p != '\n' && *p != '\0') {
+            LOGE("Spine: Bad command at offset %d", (int)(p - commands.c_str()));
+            break;
+        }
+        int expected;
+        switch (op) {
+            case SPINE_CMD_SET_ANIMATION: expected = 3; break;
+            case SPINE_CMD_ADD_ANIMATION: expected = 4; break;
+            case SPINE_CMD_SET_EMPTY_ANIMATION: expected = 2; break;
+            case SPINE_CMD_SET_SKIN: expected = 1; break;
+            case SPINE_CMD_TIME_SCALE: expected = 1; break;
+            case SPINE_CMD_TRACK_TIME_SCALE: expected = 2; break;
+            case SPINE_CMD_TRACK_ALPHA: expected = 2; break;
+            default: expected = -1; break;
+        }
+        if (argc != expected) {
+            LOGE("Spine: Bad command '%c' with %d arguments", op, argc);
+            break;
+        }
+        int track = (int)args[0];
+        TrackEntry* entry = nullptr;
+        switch (op) {
+            case SPINE_CMD_SET_ANIMATION:
+                setAnimationById(track, (int)args[1], args[2] != 0);
+                break;
+            case SPINE_CMD_ADD_ANIMATION:
+                addAnimationById(track, (int)args[1], args[2] != 0, args[3]);
+                break;
+            case SPINE_CMD_SET_EMPTY_ANIMATION:
+                if (track >= 0)
+                    m_pAnimState->setEmptyAnimation(track, args[1]);
+                break;
+            case SPINE_CMD_SET_SKIN:
+                setSkinById((int)args[0]);
+                break;
+            case SPINE_CMD_TIME_SCALE:
+                m_pAnimState->setTimeScale(args[0]);
+                break;
+            case SPINE_CMD_TRACK_TIME_SCALE:
+            case SPINE_CMD_TRACK_ALPHA:
+                entry = track >= 0 ? m_pAnimState->getCurrent(track) : nullptr;
+                if (!entry)
+                    break;
+                if (op == SPINE_CMD_TRACK_TIME_SCALE)
+                    entry->setTimeScale(args[1]);
+                else
+                    entry->setAlpha(args[1]);
+                break;
+        }
+        applied++;
+    }
+    return applied;
+}
 
 void SpineNode::update(float deltaTime, bool parentDirty) {
     Node::update(deltaTime, parentDirty);
     if (!isVisible())
      return;
 
+    if (m_bImpostor && m_pAnimState) {
+        // tracks keep their time so leaving the impostor continues where it is
+        m_pAnimState->update(deltaTime + m_fSkippedTime);
+        m_fSkippedTime = 0;
+        SpineSlotGeometry geometry;
+        if (getImpostorGeometry(geometry)) {
+            if (!m_pBatcher)
+                drawImpostor(geometry);
+            // the skeleton is only posed when something asks for it
+            m_bImpostorPoseStale = true;
+            m_bHitBoundsDirty = true;
+            if (!m_vHitBoxes.empty())
+                SpineHitGrid::get().markDirty(this);
+            return;
+        }
+        leaveImpostor();
+    }
     if (m_pSkeleton && m_pAnimState) {
+        float frameTime = deltaTime;
+        deltaTime += m_fSkippedTime;
+        m_fSkippedTime = 0;
+        if (m_pScheduler && !m_bUpdateDue && m_bPoseCaptured) {
+            m_fSkippedTime = deltaTime;
+            m_iSkippedFrames++;
+            m_fPoseAge += frameTime;
+            if (!m_pBatcher)
+                updateMesh();
+            return;
+        }
+        int64_t start = esp_timer_get_time();
         m_pAnimState->update(deltaTime);
         m_pAnimState->apply(*m_pSkeleton);
         m_pSkeleton->update(deltaTime);
@@ -226,9 +736,222 @@ void SpineNode::update(float deltaTime, bool parentDirty) {
 #else
     #error "Spine version not supported"
 #endif
+        if (!m_pScheduler) {
+            poseChanged();
+            return;
+        }
+        capturePoseVertices(true);
+        m_fPoseInterval = deltaTime;
+        m_fPoseAge = frameTime;
+        m_bUpdateDue = false;
+        m_iSkippedFrames = 0;
+        m_iLastUpdateMicros = (int)(esp_timer_get_time() - start);
+        m_iUpdateMicros = m_iUpdateMicros ? (m_iUpdateMicros * 3 + m_iLastUpdateMicros) / 4 : m_iLastUpdateMicros;
+        showPose();
+    }
+}
+void SpineNode::poseChanged() {
+    // a jump, nothing to blend from
+    if (m_pScheduler)
+        capturePoseVertices(false);
+    showPose();
+}
+void SpineNode::showPose() {
+    m_bFixedBonesDirty = true;
+    if (!m_pBatcher)
         updateMesh();
+    m_bHitBoundsDirty = true;
+    if (!m_vHitBoxes.empty())
+        SpineHitGrid::get().markDirty(this);
+}
+bool SpineNode::getSlotGeometry(Slot& slot, int slotCount, SpineSlotGeometry& out, bool computePositions) {
+    Attachment* attachment = slot.getAttachment();
+    if (nothingToDraw(slot, 0, slotCount)) {
+        m_pClipper->clipEnd(slot);
+        return false;
+    }
+    if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+        SLOT_TEXTURE(RegionAttachment, attachment, slot)
+        auto region = (RegionAttachment *)attachment;
+        // update 4 vertices position and uv
+        if (computePositions) {
+#if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+            region->computeWorldVertices(slot.getBone(), m_aQuadVertices, 0, 2);
+#elif CONFIG_SPINE_VERSION_42
+            region->computeWorldVertices(slot, m_aQuadVertices, 0, 2);
+#else
+    #error "Unknown spine version"
+#endif
+        }
+        static uint16_t indices[] = {0, 1, 2, 0, 2, 3};
+        out.positions = computePositions ? m_aQuadVertices : nullptr;
+        out.vertexCount = 4;
+        out.indices = indices;
+        out.indexCount = 6;
+        out.uvs = SLOT_UVS(RegionAttachment, region, slot);
+    } else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+        auto meshAttachment = static_cast<MeshAttachment *>(attachment);
+        SLOT_TEXTURE(MeshAttachment, attachment, slot)
+        // convert vertices position to world space
+        int vCount = meshAttachment->getWorldVerticesLength() >> 1;
+        float* vertPos = nullptr;
+        if (computePositions) {
+            vertPos = getVertexPositionsCache(vCount);
+            meshAttachment->computeWorldVertices(slot, vertPos);
+        }
+        out.positions = vertPos;
+        out.vertexCount = vCount;
+        out.indices = meshAttachment->getTriangles().buffer();
+        out.indexCount = meshAttachment->getTriangles().size();
+        out.uvs = SLOT_UVS(MeshAttachment, meshAttachment, slot);
+    } else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+        ClippingAttachment *clip = (ClippingAttachment *) attachment;
+        m_pClipper->clipStart(slot, clip);
+        return false;
+    } else {
+        // printf("Unhandled attachment type : %s\n", attachment->getRTTI().getClassName());
+        m_pClipper->clipEnd(slot);
+        return false;
+    }
+    if (slot.getData().getBlendMode() == BlendMode_Additive) {
+        out.blendMode = cubicat::BlendMode::Additive;
+    } else if (slot.getData().getBlendMode() == BlendMode_Multiply) {
+        out.blendMode = cubicat::BlendMode::Multiply;
+    } else {
+        out.blendMode = cubicat::BlendMode::Normal;
+    }
+    return true;
+}
+// rounds to nearest, clamped to the int16 range. Biased to positive so truncation rounds, without a
+// floor call or a branch on the sign, and clamped as an integer, which compiles to conditional moves.
+static inline int16_t toFixed(float v) {
+    int i = (int)(v + 32768.5f);
+    i = i < 0 ? 0 : (i > 0xffff ? 0xffff : i);
+    return (int16_t)(i - 32768);
+}
+void SpineNode::updateFixedBones() {
+    if (!m_bFixedBonesDirty)
+        return;
+    m_bFixedBonesDirty = false;
+    auto& bones = m_pSkeleton->getBones();
+    m_vFixedBones.resize(bones.size() * 6);
+    const float scale = (float)(1 << SPINE_FIXED_POSITION_BITS);
+    float n[6];
+    getNodeTransform(n);
+    for (int i = 0; i < 6; ++i)
+        n[i] *= scale;
+    float* m = m_vFixedBones.data();
+    for (size_t i = 0; i < bones.size(); ++i, m += 6) {
+        Bone* bone = bones[i];
+        float a = bone->getA(), b = bone->getB(), c = bone->getC(), d = bone->getD();
+        float x = bone->getWorldX(), y = bone->getWorldY();
+        m[0] = n[0] * a + n[1] * c;
+        m[1] = n[0] * b + n[1] * d;
+        m[2] = n[2] * a + n[3] * c;
+        m[3] = n[2] * b + n[3] * d;
+        m[4] = n[0] * x + n[1] * y + n[4];
+        m[5] = n[2] * x + n[3] * y + n[5];
     }
 }
+void SpineNode::computeFixedVertices(Slot& slot, VertexAttachment& attachment, int16_t* out) {
+    auto& deform = slot.getDeform();
+    const float* vertices = attachment.getVertices().buffer();
+    auto& boneIndices = attachment.getBones();
+    auto bones = boneIndices.buffer();
+    int count = (int)attachment.getWorldVerticesLength() >> 1;
+    if (boneIndices.size() == 0) {
+        const float* local = deform.size() > 0 ? deform.buffer() : vertices;
+        const float* m = &m_vFixedBones[slot.getBone().getData().getIndex() * 6];
+        for (int i = 0; i < count; ++i, local += 2, out += 2) {
+            out[0] = toFixed(local[0] * m[0] + local[1] * m[1] + m[4]);
+            out[1] = toFixed(local[0] * m[2] + local[1] * m[3] + m[5]);
+        }
+        return;
+    }
+    const float* matrices = m_vFixedBones.data();
+    if (deform.size() == 0) {
+        for (int i = 0, v = 0, b = 0; i < count; ++i, out += 2) {
+            float wx = 0, wy = 0;
+            int n = (int)bones[v++];
+            n += v;
+            for (; v < n; v++, b += 3) {
+                const float* m = matrices + bones[v] * 6;
+                float vx = vertices[b], vy = vertices[b + 1], weight = vertices[b + 2];
+                wx += (vx * m[0] + vy * m[1] + m[4]) * weight;
+                wy += (vx * m[2] + vy * m[3] + m[5]) * weight;
+            }
+            out[0] = toFixed(wx);
+            out[1] = toFixed(wy);
+        }
+        return;
+    }
+    const float* deformed = deform.buffer();
+    for (int i = 0, v = 0, b = 0, f = 0; i < count; ++i, out += 2) {
+        float wx = 0, wy = 0;
+        int n = (int)bones[v++];
+        n += v;
+        for (; v < n; v++, b += 3, f += 2) {
+            const float* m = matrices + bones[v] * 6;
+            float vx = vertices[b] + deformed[f], vy = vertices[b + 1] + deformed[f + 1], weight = vertices[b + 2];
+            wx += (vx * m[0] + vy * m[1] + m[4]) * weight;
+            wy += (vx * m[2] + vy * m[3] + m[5]) * weight;
+        }
+        out[0] = toFixed(wx);
+        out[1] = toFixed(wy);
+    }
+}
+const int16_t* SpineNode::getFixedUVs(const float* uvs, int vertexCount) {
+    auto& fixed = m_fixedUVs[uvs];
+    if ((int)fixed.size() != vertexCount * 2) {
+        fixed.resize(vertexCount * 2);
+        for (int i = 0; i < vertexCount * 2; ++i)
+            fixed[i] = toFixed(uvs[i] * (1 << SPINE_FIXED_UV_BITS));
+    }
+    return fixed.data();
+}
+bool SpineNode::getFixedSlotGeometry(int drawIndex, SpineFixedGeometry& out) {
+    if (!m_pSkeleton)
+        return false;
+    auto& drawOrders = m_pSkeleton->getDrawOrder();
+    int slotCount = drawOrders.size();
+    if (drawIndex < 0 || drawIndex >= slotCount)
+        return false;
+    Slot& slot = *drawOrders[drawIndex];
+    SpineSlotGeometry geometry;
+    if (!getSlotGeometry(slot, slotCount, geometry, false))
+        return false;
+    updateFixedBones();
+    // only grows, shrinking and growing again per slot would clear it each time
+    if ((int)m_vFixedPositions.size() < geometry.vertexCount * 2)
+        m_vFixedPositions.resize(geometry.vertexCount * 2);
+    Attachment* attachment = slot.getAttachment();
+    if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+        computeFixedVertices(slot, *static_cast<MeshAttachment *>(attachment), m_vFixedPositions.data());
+    } else {
+        // 4 corners, converting them costs less than folding the region offsets into the bone
+#if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+        static_cast<RegionAttachment *>(attachment)->computeWorldVertices(slot.getBone(), m_aQuadVertices, 0, 2);
+#else
+        static_cast<RegionAttachment *>(attachment)->computeWorldVertices(slot, m_aQuadVertices, 0, 2);
+#endif
+        const float scale = (float)(1 << SPINE_FIXED_POSITION_BITS);
+        float n[6];
+        getNodeTransform(n);
+        for (int i = 0; i < 8; i += 2) {
+            float x = m_aQuadVertices[i], y = m_aQuadVertices[i + 1];
+            m_vFixedPositions[i] = toFixed((x * n[0] + y * n[1] + n[4]) * scale);
+            m_vFixedPositions[i + 1] = toFixed((x * n[2] + y * n[3] + n[5]) * scale);
+        }
+    }
+    out.texture = geometry.texture;
+    out.blendMode = geometry.blendMode;
+    out.positions = m_vFixedPositions.data();
+    out.uvs = getFixedUVs(geometry.uvs, geometry.vertexCount);
+    out.vertexCount = geometry.vertexCount;
+    out.indices = geometry.indices;
+    out.indexCount = geometry.indexCount;
+    return true;
+}
 void SpineNode::updateMesh() {
     auto& drawables = getDrawables();
     auto& drawOrders = m_pSkeleton->getDrawOrder();
@@ -241,87 +964,439 @@ void SpineNode::updateMesh() {
             attachDrawable(poly);
         }
     }
+    SpineSlotGeometry geometry;
     for (int i=0; i<slotCount; ++i) {
-        Slot *slot = drawOrders[i];
-        Attachment* attachment = slot->getAttachment();
         auto poly = drawables[i]->cast<Polygon2D>();
-        auto mesh = poly->getMesh();
-        if (nothingToDraw(*slot, 0, slotCount)) {
+        if (!getDrawGeometry(i, slotCount, geometry)) {
             poly->setVisible(false);
-            m_pClipper->clipEnd(*slot);
             continue;
-        } else {
-            poly->addDirty(true);
-            poly->setVisible(true);
-            if (slot->getData().getBlendMode() == BlendMode_Additive) {
-                poly->getMaterial()->setBlendMode(cubicat::BlendMode::Additive);
-            } else if (slot->getData().getBlendMode() == BlendMode_Multiply) {
-                poly->getMaterial()->setBlendMode(cubicat::BlendMode::Multiply);
-            }
         }
-        if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
-            ASSIGN_TEXTURE(RegionAttachment, attachment)
-            auto region = (RegionAttachment *)slot->getAttachment();
-            auto& uvs = region->getUVs();
-            // update 4 vertices position and uv
-            float vertices[8];
+        poly->addDirty(true);
+        poly->setVisible(true);
+        poly->getMaterial()->setBlendMode(geometry.blendMode);
+        if (geometry.texture)
+            poly->getMaterial()->setTexture(geometry.texture);
+        auto mesh = poly->getMesh();
+        mesh->updateVertices(geometry.positions, geometry.vertexCount);
+        mesh->updateIndices(geometry.indices, geometry.indexCount);
+        mesh->updateUVs(geometry.uvs, geometry.vertexCount << 1);
+    }
+}
+void SpineNode::emitBatch(SpineBatcher& batcher) {
+    if (!m_pSkeleton || !isVisible())
+        return;
+    auto& drawOrders = m_pSkeleton->getDrawOrder();
+    int slotCount = drawOrders.size();
+    float m[6];
+    getNodeTransform(m);
+    SpineSlotGeometry geometry;
+    if (m_bImpostor && getImpostorGeometry(geometry)) {
+        batcher.addGeometry(geometry, m, m_bUseBilinearFilter);
+        return;
+    }
+    // scheduled poses are captured and blended as floats
+    if (batcher.isFixedPoint() && !m_pScheduler) {
+        SpineFixedGeometry fixedGeometry;
+        for (int i=0; i<slotCount; ++i) {
+            if (getFixedSlotGeometry(i, fixedGeometry))
+                batcher.addFixedGeometry(fixedGeometry, m_bUseBilinearFilter);
+        }
+        return;
+    }
+    for (int i=0; i<slotCount; ++i) {
+        if (getDrawGeometry(i, slotCount, geometry))
+            batcher.addGeometry(geometry, m, m_bUseBilinearFilter);
+    }
+}
+bool SpineNode::getDrawGeometry(int drawIndex, int slotCount, SpineSlotGeometry& out) {
+    Slot& slot = *m_pSkeleton->getDrawOrder()[drawIndex];
+    PoseVertices& pose = m_aPoseVertices[m_iPose];
+    // a slot changed since the capture (skin, attachment) shows as it is now
+    if (!m_pScheduler || !m_bPoseCaptured || drawIndex >= (int)pose.attachments.size() ||
+        slot.getAttachment() != pose.attachments[drawIndex])
+        return getSlotGeometry(slot, slotCount, out);
+    if (!getSlotGeometry(slot, slotCount, out, false))
+        return false;
+    const float* current = &pose.positions[pose.starts[drawIndex]];
+    out.positions = current;
+    float t = m_fPoseInterval > 0 ? m_fPoseAge / m_fPoseInterval : 1;
+    PoseVertices& previous = m_aPoseVertices[m_iPose ^ 1];
+    if (!m_bBlendPoses || t >= 1 || drawIndex >= (int)previous.attachments.size() ||
+        previous.attachments[drawIndex] != pose.attachments[drawIndex])
+        return true;
+    // same attachment, so the same vertices
+    const float* from = &previous.positions[previous.starts[drawIndex]];
+    int count = out.vertexCount * 2;
+    if ((int)m_vBlendedPositions.size() < count)
+        m_vBlendedPositions.resize(count);
+    float* blended = m_vBlendedPositions.data();
+    for (int i = 0; i < count; ++i)
+        blended[i] = from[i] + (current[i] - from[i]) * t;
+    out.positions = blended;
+    return true;
+}
+void SpineNode::capturePoseVertices(bool blend) {
+    m_bBlendPoses = blend && m_bPoseCaptured;
+    if (m_bBlendPoses)
+        m_iPose ^= 1;
+    PoseVertices& pose = m_aPoseVertices[m_iPose];
+    auto& drawOrders = m_pSkeleton->getDrawOrder();
+    int slotCount = drawOrders.size();
+    pose.positions.clear();
+    pose.attachments.assign(slotCount, nullptr);
+    pose.starts.resize(slotCount);
+    float bounds[4] = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+    SpineSlotGeometry geometry;
+    for (int i=0; i<slotCount; ++i) {
+        if (!getSlotGeometry(*drawOrders[i], slotCount, geometry))
+            continue;
+        pose.attachments[i] = drawOrders[i]->getAttachment();
+        pose.starts[i] = (int)pose.positions.size();
+        pose.positions.insert(pose.positions.end(), geometry.positions, geometry.positions + geometry.vertexCount * 2);
+        for (int v = 0; v < geometry.vertexCount * 2; v += 2) {
+            bounds[0] = std::min(bounds[0], geometry.positions[v]);
+            bounds[1] = std::min(bounds[1], geometry.positions[v + 1]);
+            bounds[2] = std::max(bounds[2], geometry.positions[v]);
+            bounds[3] = std::max(bounds[3], geometry.positions[v + 1]);
+        }
+    }
+    memcpy(m_aPoseBounds, bounds, sizeof(bounds));
+    m_bPoseCaptured = true;
+}
+void SpineNode::poseAt(Animation* animation, float time) {
+    m_pSkeleton->setToSetupPose();
+    animation->apply(*m_pSkeleton, time, time, true, nullptr, 1, MixBlend_Setup, MixDirection_In);
 #if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
-            region->computeWorldVertices(slot->getBone(), vertices, 0, 2);
-#elif CONFIG_SPINE_VERSION_42
-            region->computeWorldVertices(*slot, vertices, 0, 2);
+    m_pSkeleton->updateWorldTransform();
+#elif defined(CONFIG_SPINE_VERSION_42)
+    m_pSkeleton->updateWorldTransform(Physics_Pose);
 #else
-    #error "Unknown spine version"
-#endif    
-            mesh->updateVertices(vertices, 4);
-            static uint16_t indices[] = {0, 1, 2, 0, 2, 3};
-            mesh->updateIndices(indices, 6);
-            mesh->updateUVs(uvs.buffer(), uvs.size());
-        } else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
-            auto meshAttachment = static_cast<MeshAttachment *>(attachment);
-            ASSIGN_TEXTURE(MeshAttachment, attachment)
-            auto mesh = poly->getMesh();
-            // convert vertices position to world space 
-            int vCount = meshAttachment->getWorldVerticesLength() >> 1;
-            float* vertPos = getVertexPositionsCache(vCount);
-            meshAttachment->computeWorldVertices(*slot, vertPos);
-            mesh->updateVertices(vertPos, vCount);
-            mesh->updateIndices(meshAttachment->getTriangles().buffer(), meshAttachment->getTriangles().size());
-            mesh->updateUVs(meshAttachment->getUVs().buffer(), meshAttachment->getUVs().size());
-        } else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
-            printf("ClippingAttachment at: %d\n", i);
-            ClippingAttachment *clip = (ClippingAttachment *) slot->getAttachment();
-            m_pClipper->clipStart(*slot, clip);
-            continue;
-        } else {
-            // printf("Unhandled attachment type : %s\n", attachment->getRTTI().getClassName());
-            m_pClipper->clipEnd(*slot);
-            continue;
+    #error "Spine version not supported"
+#endif
+}
+bool SpineNode::bakeImpostor(int animation, float frameRate, float resolution) {
+    if (!m_pSkeleton || !m_pAnimState || frameRate <= 0 || resolution <= 0)
+        return false;
+    auto& animations = m_pSkeleton->getData()->getAnimations();
+    if (animation < 0 || animation >= (int)animations.size()) {
+        LOGE("Spine: Animation handle out of range: %d", animation);
+        return false;
+    }
+    releaseImpostor();
+    Animation* anim = animations[animation];
+    int frameCount = std::max(1, (int)(anim->getDuration() * frameRate + 0.5f));
+    auto& drawOrders = m_pSkeleton->getDrawOrder();
+    int slotCount = drawOrders.size();
+    SpineSlotGeometry geometry;
+    PageImage image;
+    // first pass finds the rectangle every frame fits in
+    float bounds[4] = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+    bool readable = true;
+    for (int frame = 0; frame < frameCount && readable; ++frame) {
+        poseAt(anim, frame / frameRate);
+        for (int i = 0; i < slotCount; ++i) {
+            if (!getSlotGeometry(*drawOrders[i], slotCount, geometry) || !geometry.texture)
+                continue;
+            if (!m_sTextureLoader.getPageImage(geometry.texture.get(), image)) {
+                readable = false;
+                break;
+            }
+            for (int v = 0; v < geometry.vertexCount; ++v) {
+                bounds[0] = std::min(bounds[0], geometry.positions[v * 2]);
+                bounds[1] = std::min(bounds[1], geometry.positions[v * 2 + 1]);
+                bounds[2] = std::max(bounds[2], geometry.positions[v * 2]);
+                bounds[3] = std::max(bounds[3], geometry.positions[v * 2 + 1]);
+            }
         }
     }
+    if (!readable)
+        LOGE("Spine: impostor needs atlas pages loaded from png files");
+    if (readable && bounds[0] <= bounds[2]) {
+        int width = std::max(1, (int)ceilf((bounds[2] - bounds[0]) * resolution));
+        int height = std::max(1, (int)ceilf((bounds[3] - bounds[1]) * resolution));
+        m_pImpostor = SpineImpostor::create(bounds[0], bounds[1], width, height, resolution, frameCount, frameRate);
+    }
+    if (m_pImpostor) {
+        for (int frame = 0; frame < frameCount; ++frame) {
+            poseAt(anim, frame / frameRate);
+            for (int i = 0; i < slotCount; ++i) {
+                if (getSlotGeometry(*drawOrders[i], slotCount, geometry) && geometry.texture &&
+                    m_sTextureLoader.getPageImage(geometry.texture.get(), image))
+                    m_pImpostor->drawSlot(frame, geometry, image);
+            }
+        }
+        m_pImpostor->finish();
+        m_pImpostorAnimation = anim;
+    }
+    // back to the pose of the tracks
+    m_pSkeleton->setToSetupPose();
+    m_pAnimState->apply(*m_pSkeleton);
+#if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+    m_pSkeleton->updateWorldTransform();
+#elif defined(CONFIG_SPINE_VERSION_42)
+    m_pSkeleton->updateWorldTransform(Physics_Pose);
+#endif
+    poseChanged();
+    return m_pImpostor != nullptr;
+}
+bool SpineNode::setImpostor(bool enable) {
+    if (enable && m_pImpostor)
+        m_bImpostor = true;
+    else
+        leaveImpostor();
+    return m_bImpostor;
+}
+bool SpineNode::isImpostor() {
+    return m_bImpostor;
+}
+void SpineNode::releaseImpostor() {
+    leaveImpostor();
+    m_pImpostorAnimation = nullptr;
+    if (m_pImpostor) {
+        delete m_pImpostor;
+        m_pImpostor = nullptr;
+    }
+}
+void SpineNode::setImpostorBudget(int bytes) {
+    SpineImpostor::setBudget(bytes > 0 ? bytes : 0);
+}
+int SpineNode::getImpostorBytes() {
+    return (int)SpineImpostor::getTotalBytes();
+}
+bool SpineNode::getImpostorGeometry(SpineSlotGeometry& out) {
+    TrackEntry* entry = m_pAnimState->getCurrent(0);
+    if (!m_pImpostor || !entry || entry->getAnimation() != m_pImpostorAnimation)
+        return false;
+    m_pImpostor->getGeometry(entry->getAnimationTime(), out);
+    return true;
+}
+void SpineNode::poseImpostorSkeleton() {
+    if (!m_bImpostorPoseStale)
+        return;
+    m_bImpostorPoseStale = false;
+    m_pAnimState->apply(*m_pSkeleton);
+    // physics doesn't step for a query
+#if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+    m_pSkeleton->updateWorldTransform();
+#elif defined(CONFIG_SPINE_VERSION_42)
+    m_pSkeleton->updateWorldTransform(Physics_Pose);
+#else
+    #error "Spine version not supported"
+#endif
+    m_bHitBoundsDirty = true;
+}
+void SpineNode::drawImpostor(const SpineSlotGeometry& geometry) {
+    auto& drawables = getDrawables();
+    if (drawables.empty()) {
+        auto poly = Polygon2D::create(Mesh2D::create(nullptr, 0, nullptr, 0, true));
+        poly->getMaterial()->setBilinearFilter(m_bUseBilinearFilter);
+        attachDrawable(poly);
+    }
+    for (size_t i = 1; i < drawables.size(); ++i)
+        drawables[i]->setVisible(false);
+    auto poly = drawables[0]->cast<Polygon2D>();
+    poly->addDirty(true);
+    poly->setVisible(true);
+    poly->getMaterial()->setBlendMode(geometry.blendMode);
+    poly->getMaterial()->setTexture(geometry.texture);
+    auto mesh = poly->getMesh();
+    mesh->updateVertices(geometry.positions, geometry.vertexCount);
+    mesh->updateIndices(geometry.indices, geometry.indexCount);
+    mesh->updateUVs(geometry.uvs, geometry.vertexCount << 1);
 }
 void SpineNode::setScale(const Vector2f& scale) {
     if (m_pSkeleton) {
+        // the baked frames are only valid at the scale they were rendered at
+        if (scale.x != m_pSkeleton->getScaleX() || scale.y != m_pSkeleton->getScaleY())
+            releaseImpostor();
         m_pSkeleton->setScaleX(scale.x);
         m_pSkeleton->setScaleY(scale.y);
     }
 }
 void SpineNode::setPosition(const Vector2f& pos) {
     Node2D::setPosition(pos);
+    m_bFixedBonesDirty = true;
+    if (!m_vHitBoxes.empty())
+        SpineHitGrid::get().markDirty(this);
+}
+void SpineNode::setRotation(float angle) {
+    Node2D::setRotation(angle);
+    m_bFixedBonesDirty = true;
+    if (!m_vHitBoxes.empty())
+        SpineHitGrid::get().markDirty(this);
+}
+void SpineNode::getNodeTransform(float* m) {
+    auto pos = getPosition();
+    float rotation = getRotation();
+    float cosine = MathUtil::cosDeg(rotation), sine = MathUtil::sinDeg(rotation);
+    m[0] = cosine;
+    m[1] = -sine;
+    m[2] = sine;
+    m[3] = cosine;
+    m[4] = pos.x;
+    m[5] = pos.y;
+}
+void SpineNode::toSkeletonSpace(float x, float y, float& sx, float& sy) {
+    float m[6];
+    getNodeTransform(m);
+    // a rotation, its inverse is the transpose
+    x -= m[4];
+    y -= m[5];
+    sx = m[0] * x + m[2] * y;
+    sy = m[1] * x + m[3] * y;
 }
 const std::vector<std::string>& SpineNode::getAnimationNames() {
     return m_vAnimationNames;
 }
-std::string SpineNode::getAnimationName(int idx) {
-    if (m_vAnimationNames.empty())
-        return "";
-    idx = idx % m_vAnimationNames.size();
-    if (idx < 0) idx = m_vAnimationNames.size() + idx;
-    return m_vAnimationNames[idx];
-}
 void SpineNode::useBilinearFilter(bool b) {
     m_bUseBilinearFilter = b;
     auto& drawables = getDrawables();
     for (auto& d : drawables) {
         d->getMaterial()->setBilinearFilter(b);
     }
-}
\ No newline at end of file
+}
+void SpineNode::initHitBoxes() {
+    auto& skins = m_pSkeleton->getData()->getSkins();
+    std::set<int> slots;
+    for (size_t i = 0; i < skins.size(); ++i) {
+        auto entries = skins[i]->getAttachments();
+        while (entries.hasNext()) {
+            auto& entry = entries.next();
+            if (entry._attachment && entry._attachment->getRTTI().isExactly(BoundingBoxAttachment::rtti))
+                slots.insert((int)entry._slotIndex);
+        }
+    }
+    for (int slot : slots) {
+        HitBox box;
+        box.slotIndex = slot;
+        m_vHitBoxes.push_back(box);
+    }
+    m_bHitBoundsDirty = true;
+    if (!m_vHitBoxes.empty())
+        SpineHitGrid::get().add(this);
+}
+
+bool SpineNode::updateHitBounds() {
+    if (!m_bHitBoundsDirty)
+        return m_bHitBoundsValid;
+    poseImpostorSkeleton();
+    m_bHitBoundsDirty = false;
+    m_bHitBoundsValid = false;
+    float* bounds = m_aHitAABB;
+    bounds[0] = bounds[1] = FLT_MAX;
+    bounds[2] = bounds[3] = -FLT_MAX;
+    auto& slots = m_pSkeleton->getSlots();
+    for (auto& box : m_vHitBoxes) {
+        Slot* slot = slots[box.slotIndex];
+        Attachment* attachment = slot->getAttachment();
+        box.visible = attachment && slot->getBone().isActive() &&
+                      attachment->getRTTI().isExactly(BoundingBoxAttachment::rtti);
+        if (!box.visible)
+            continue;
+        auto boundingBox = static_cast<BoundingBoxAttachment*>(attachment);
+        float* aabb = box.aabb;
+        if (boundingBox->getBones().size() == 0 && slot->getDeform().size() == 0) {
+            // unweighted boxes only move with their bone, transform the corners of the bone space AABB
+            float* local = box.localAABB;
+            if (box.attachment != attachment) {
+                auto& vertices = boundingBox->getVertices();
+                local[0] = local[1] = FLT_MAX;
+                local[2] = local[3] = -FLT_MAX;
+                for (size_t i = 0, n = boundingBox->getWorldVerticesLength(); i < n; i += 2) {
+                    local[0] = std::min(local[0], vertices[i]);
+                    local[1] = std::min(local[1], vertices[i + 1]);
+                    local[2] = std::max(local[2], vertices[i]);
+                    local[3] = std::max(local[3], vertices[i + 1]);
+                }
+                box.attachment = attachment;
+            }
+            Bone& bone = slot->getBone();
+            float a = bone.getA(), b = bone.getB(), c = bone.getC(), d = bone.getD();
+            float cx = (local[0] + local[2]) * 0.5f, cy = (local[1] + local[3]) * 0.5f;
+            float hx = (local[2] - local[0]) * 0.5f, hy = (local[3] - local[1]) * 0.5f;
+            float wx = cx * a + cy * b + bone.getWorldX(), wy = cx * c + cy * d + bone.getWorldY();
+            float ex = fabsf(a) * hx + fabsf(b) * hy, ey = fabsf(c) * hx + fabsf(d) * hy;
+            aabb[0] = wx - ex;
+            aabb[1] = wy - ey;
+            aabb[2] = wx + ex;
+            aabb[3] = wy + ey;
+        } else {
+            size_t n = boundingBox->getWorldVerticesLength();
+            m_vHitVertices.resize(n);
+            boundingBox->computeWorldVertices(*slot, 0, n, m_vHitVertices.data(), 0, 2);
+            aabb[0] = aabb[1] = FLT_MAX;
+            aabb[2] = aabb[3] = -FLT_MAX;
+            for (size_t i = 0; i < n; i += 2) {
+                aabb[0] = std::min(aabb[0], m_vHitVertices[i]);
+                aabb[1] = std::min(aabb[1], m_vHitVertices[i + 1]);
+                aabb[2] = std::max(aabb[2], m_vHitVertices[i]);
+                aabb[3] = std::max(aabb[3], m_vHitVertices[i + 1]);
+            }
+        }
+        bounds[0] = std::min(bounds[0], aabb[0]);
+        bounds[1] = std::min(bounds[1], aabb[1]);
+        bounds[2] = std::max(bounds[2], aabb[2]);
+        bounds[3] = std::max(bounds[3], aabb[3]);
+        m_bHitBoundsValid = true;
+    }
+    return m_bHitBoundsValid;
+}
+
+bool SpineNode::hitBox(HitBox& box, float x, float y) {
+    if (x < box.aabb[0] || y < box.aabb[1] || x > box.aabb[2] || y > box.aabb[3])
+        return false;
+    Slot* slot = m_pSkeleton->getSlots()[box.slotIndex];
+    auto boundingBox = static_cast<BoundingBoxAttachment*>(slot->getAttachment());
+    int n = (int)boundingBox->getWorldVerticesLength();
+    m_vHitVertices.resize(n);
+    float* vertices = m_vHitVertices.data();
+    boundingBox->computeWorldVertices(*slot, 0, n, vertices, 0, 2);
+    // same even-odd rule as SkeletonBounds::containsPoint
+    bool inside = false;
+    for (int i = 0, prev = n - 2; i < n; prev = i, i += 2) {
+        float vy = vertices[i + 1], prevY = vertices[prev + 1];
+        if ((vy < y && prevY >= y) || (prevY < y && vy >= y)) {
+            float vx = vertices[i];
+            if (vx + (y - vy) / (prevY - vy) * (vertices[prev] - vx) < x)
+                inside = !inside;
+        }
+    }
+    return inside;
+}
+
+const char* SpineNode::hitTestSkeleton(float x, float y) {
+    if (!m_pSkeleton || !updateHitBounds())
+        return nullptr;
+    if (x < m_aHitAABB[0] || y < m_aHitAABB[1] || x > m_aHitAABB[2] || y > m_aHitAABB[3])
+        return nullptr;
+    // walk the draw order backwards so the box drawn on top wins
+    auto& drawOrder = m_pSkeleton->getDrawOrder();
+    for (int i = (int)drawOrder.size() - 1; i >= 0; --i) {
+        int slotIndex = drawOrder[i]->getData().getIndex();
+        for (auto& box : m_vHitBoxes) {
+            if (box.slotIndex == slotIndex && box.visible && hitBox(box, x, y))
+                return drawOrder[i]->getAttachment()->getName().buffer();
+        }
+    }
+    return nullptr;
+}
+
+char* SpineNode::hitTest(float x, float y) {
+    if (!hitTest(x, y, m_sHitName))
+        m_sHitName.clear();
+    return &m_sHitName[0];
+}
+
+bool SpineNode::hitTest(float x, float y, std::string& name) {
+    float sx, sy;
+    toSkeletonSpace(x, y, sx, sy);
+    const char* hit = hitTestSkeleton(sx, sy);
+    if (!hit)
+        return false;
+    name = hit;
+    return true;
+}
+
+SpineNode* SpineNode::pick(float x, float y) {
+    return SpineHitGrid::get().pick(x, y, nullptr);
+}
@@ -2,16 +2,47 @@
 #define _SPINE_NODE_H_
 #include <string>
 #include <map>
+#include <set>
 #include "texture_loader.h"
+#include "spine_batcher.h"
+#include "spine_impostor.h"
+#include "spine_scheduler.h"
 #include "graphic_engine/drawable/texture.h"
 #include "graphic_engine/node2d.h"
 #include "spine/Skeleton.h"
 #include "spine/AnimationState.h"
 #include "spine/AtlasAttachmentLoader.h"
 #include "spine/SkeletonClipping.h"
+#include "spine/VertexAttachment.h"
+#include "spine/EventData.h"
+#ifdef CONFIG_SPINE_VERSION_42
+#include "spine/SkeletonPose.h"
+#endif
 
 using namespace cubicat;
 
+// Commands for SpineNode::runCommands, one letter followed by numeric arguments. Commands are
+// separated by ';' or newlines, handles come from the find* calls, booleans are 0 or 1.
+// e.g. "s 0 3 1; a 1 5 0 0.25; k 2"
+// numbers per notification in SpineNode::drainEvents
+#define SPINE_EVENT_RECORD_SIZE 6
+enum SpineCommand {
+    // s track animation loop
+    SPINE_CMD_SET_ANIMATION = 's',
+    // a track animation loop delay
+    SPINE_CMD_ADD_ANIMATION = 'a',
+    // e track mixDuration
+    SPINE_CMD_SET_EMPTY_ANIMATION = 'e',
+    // k skin
+    SPINE_CMD_SET_SKIN = 'k',
+    // t timeScale, for the whole animation state
+    SPINE_CMD_TIME_SCALE = 't',
+    // T track timeScale
+    SPINE_CMD_TRACK_TIME_SCALE = 'T',
+    // A track alpha
+    SPINE_CMD_TRACK_ALPHA = 'A',
+};
+
 class SpineNode : public Node2D
 {
 public:
@@ -29,21 +60,181 @@ public:
     TrackEntry* setAnimation(int trackIndex, const std::string &name, bool loop);
     TrackEntry* addAnimation(int trackIndex, const std::string &name, bool loop, float delay = 0.0f);
     void clearTrack(int trackIndex);
+    // handles to resolve once and pass to the *ById calls instead of names, -1 when not found
+    int findAnimation(const std::string &name);
+    int findSkin(const std::string &name);
+    int findBone(const std::string &name);
+    int findSlot(const std::string &name);
+    TrackEntry* setAnimationById(int trackIndex, int animation, bool loop);
+    TrackEntry* addAnimationById(int trackIndex, int animation, bool loop, float delay = 0.0f);
+    // skin handle from findSkin, unlike setSkinByIndex the default skin is 0
+    void setSkinById(int skin);
+    float getBoneWorldX(int bone);
+    float getBoneWorldY(int bone);
+    void setBonePosition(int bone, float x, float y);
+    void setSlotColor(int slot, float r, float g, float b, float a);
+    // run a batch of commands in one call, see SpineCommand. Stops at the first malformed command,
+    // returns how many were run.
+    int runCommands(const std::string &commands);
+    // collect start/interrupt/end/complete/event notifications for drainEvents, keeping at most
+    // capacity undrained ones. When full the oldest are dropped.
+    void enableEvents(bool enable, int capacity = 64);
+    // notifications since the last drain as a JSON array of numbers, SPINE_EVENT_RECORD_SIZE per
+    // notification: type (spine::EventType), track, animation handle, event handle, event int value,
+    // event float value. Handles are -1 when unknown. Valid until the next call.
+    char* drainEvents();
+    // notifications dropped because the buffer was full, since the last drain
+    int getDroppedEvents();
+    int findEvent(const std::string &name);
     // [JS_BINDING_END]
     TrackEntry* setAnimation(int trackIndex, int animIndex, bool loop);
     TrackEntry* addAnimation(int trackIndex, int animIndex, bool loop, float delay = 0.0f);
     // [JS_BINDING_BEGIN]
     void setScale(const Vector2f& scale);
     void setPosition(const Vector2f& pos);
+    void setRotation(float angle);
     void useBilinearFilter(bool b);
+    // name of the topmost bounding box under the point (parent space), empty when none. Valid until
+    // the next call.
+    char* hitTest(float x, float y);
+    // topmost loaded SpineNode with a bounding box under the point, or null. The nodes are expected to
+    // share a parent, the point is in its space.
+    static SpineNode* pick(float x, float y);
+    // render a looping animation once, frameRate frames per second at resolution pixels per skeleton
+    // unit, for setImpostor. False when the atlas pages can't be read back or it's over the budget.
+    bool bakeImpostor(int animation, float frameRate, float resolution);
+    // play the baked frames as one quad instead of posing the skeleton, while track 0 plays the baked
+    // animation. Hit tests and bone queries pose the skeleton first, timeline events only fire then.
+    // Setting animations, skins, bones, slot colors or the scale goes back to live rendering.
+    bool setImpostor(bool enable);
+    bool isImpostor();
+    void releaseImpostor();
+    // bytes the impostors of all nodes may hold, 0 for no limit
+    static void setImpostorBudget(int bytes);
+    static int getImpostorBytes();
     // [JS_BINDING_END]
     
+    // hitTest for C++ callers, false when no bounding box is under the point
+    bool hitTest(float x, float y, std::string& name);
     const std::vector<std::string>& getAnimationNames();
+    // bytes of atlas page textures currently decoded for this node, pages shared with other nodes included
+    size_t getResidentTextureBytes();
+    // bytes of atlas page textures decoded for all nodes, each shared page counted once
+    static size_t getSharedTextureBytes();
+    // the slot at drawIndex in draw order as 16 bit fixed point, for renderers that rasterize in integers:
+    // half the bytes of float vertices and no conversion per vertex downstream. Positions are in the
+    // parent's space like SpineBatcher's, skinned straight to fixed point with the node transform and the
+    // fraction scale folded into the bone matrices once per pose. False when the slot draws nothing.
+    // Valid until the next call.
+    bool getFixedSlotGeometry(int drawIndex, SpineFixedGeometry& out);
+#ifdef CONFIG_SPINE_VERSION_42
+    // decode animations on first use instead of at load, keeping at most budgetBytes of
+    // unused animations resident (0 for no limit). Takes effect on the next load.
+    void setLazyAnimations(bool lazy, size_t budgetBytes = 0);
+    // only read the default skin plus the listed skins and animations (empty list keeps all),
+    // optionally dropping default skin attachments nothing can show. Takes effect on the next load.
+    void setLoadFilter(const std::vector<std::string>& skins, const std::vector<std::string>& animations,
+                       bool stripUnreachable = false);
+    // keep single value and deform keys in 16 bits, which saves animation memory. tools/host/quantize_check
+    // bounds the error and reports the memory of a rig both ways. Takes effect on the next load.
+    void setQuantizeAnimations(bool quantize) { m_bQuantizeAnimations = quantize; }
+    // cap the physics steps taken per update (0 for no limit) so a long frame, like the one after a load,
+    // doesn't make the next frames late too. Time over the cap is dropped, or spread over later updates.
+    // tools/host/physics_check measures both on a hair rig.
+    void setPhysicsMaxSteps(int maxSteps, bool defer = false);
+    // pose the skeleton with every track at the given track time, without firing events or
+    // advancing the tracks, for scrubbing. The next update continues from the tracks' own times.
+    void seek(float trackTime);
+    // snapshot the current pose (transforms, attachments, deform, physics), returns its index
+    int capturePose();
+    // show a pose taken with capturePose, physics continues from its state
+    bool restorePose(int index);
+    void clearPoses();
+#endif
 private:
+    friend class SpineHitGrid;
+    friend class SpineBatcher;
+    friend class SpineBench;
+    friend class SpineScheduler;
+    // slot vertices of a pose computed under a SpineScheduler, by draw index
+    struct PoseVertices {
+        std::vector<float>          positions;
+        // what each slot drew and its first float in positions, null when it drew nothing
+        std::vector<Attachment*>    attachments;
+        std::vector<int>            starts;
+    };
+    struct HitBox {
+        int         slotIndex;
+        // attachment localAABB was computed for
+        Attachment* attachment = nullptr;
+        // bone space AABB of an unweighted box
+        float       localAABB[4];
+        // skeleton space AABB, valid while visible
+        float       aabb[4];
+        bool        visible = false;
+    };
+    struct EventRecord {
+        int         type;
+        int         trackIndex;
+        int         animation;
+        int         event;
+        int         intValue;
+        float       floatValue;
+    };
+    // forwards AnimationState notifications to the node's ring buffer
+    class EventCollector : public AnimationStateListenerObject {
+    public:
+        SpineNode*  node = nullptr;
+        void callback(AnimationState* state, EventType type, TrackEntry* entry, Event* event) override;
+    };
     SpineNode();
     void updateMesh();
+    // the slot at drawIndex as updateMesh and emitBatch draw it. Under a SpineScheduler the positions
+    // come from the captured poses, blended on frames it skipped.
+    bool getDrawGeometry(int drawIndex, int slotCount, SpineSlotGeometry& out);
+    // keep the slot vertices of the current pose, blend keeps the previous pose to blend from
+    void capturePoseVertices(bool blend);
+    // what the slot draws this frame, false when nothing. Positions stay valid until the next call.
+    // computePositions false leaves out.positions null, for callers skinning themselves
+    bool getSlotGeometry(Slot& slot, int slotCount, SpineSlotGeometry& out, bool computePositions = true);
+    // bone matrices scaled to fixed point with the node transform applied, 6 floats per bone
+    void updateFixedBones();
+    void computeFixedVertices(Slot& slot, VertexAttachment& attachment, int16_t* out);
+    // fixed point copy of a UV array, converted once
+    const int16_t* getFixedUVs(const float* uvs, int vertexCount);
+    // append the visible slots to a batcher, in draw order
+    void emitBatch(SpineBatcher& batcher);
+    // the impostor quad for the current track 0 time, false when track 0 left the baked animation
+    bool getImpostorGeometry(SpineSlotGeometry& out);
+    void drawImpostor(const SpineSlotGeometry& geometry);
+    void leaveImpostor() { m_bImpostor = false; m_bImpostorPoseStale = false; }
+    // pose the skeleton at the tracks' time while the impostor plays, for hit tests and bone queries
+    void poseImpostorSkeleton();
+    // setup pose plus one animation at time, world transforms updated
+    void poseAt(Animation* animation, float time);
+    void pushEvent(EventType type, TrackEntry* entry, Event* event);
+    // pose changed outside update, rebuild the mesh and hit bounds
+    void poseChanged();
+    void showPose();
     void initialize();
-    std::string getAnimationName(int idx);
+    // decode the page on first use, or share it with other nodes, and keep it resident until evicted
+    TexturePtr acquirePageTexture(AtlasPage* page);
+    void releasePageTextures();
+    // load pages reachable from default and current skin, evict the others
+    void updatePageResidency();
+    // find the slots that hold a bounding box in any skin
+    void initHitBoxes();
+    // refresh the box AABBs if the pose changed since the last query, false when no box is showing
+    bool updateHitBounds();
+    // exact polygon test of one box, point in skeleton space
+    bool hitBox(HitBox& box, float x, float y);
+    // name of the topmost box under the point in skeleton space, or null
+    const char* hitTestSkeleton(float x, float y);
+    // node rotation and position as a bone matrix, x' = m[0] * x + m[1] * y + m[4] and
+    // y' = m[2] * x + m[3] * y + m[5]. The skeleton scale is already in the bones.
+    void getNodeTransform(float* m);
+    // parent space point to skeleton space
+    void toSkeletonSpace(float x, float y, float& sx, float& sy);
     static CubicatTextureLoader         m_sTextureLoader;
     Skeleton*                           m_pSkeleton = nullptr;
     AnimationState*                     m_pAnimState = nullptr;
@@ -53,6 +244,70 @@ private:
     std::map<std::string,TexturePtr>    m_textureMap;
     std::vector<std::string>            m_vAnimationNames;
     bool                                m_bUseBilinearFilter = false;
+    // set while a SpineBatcher draws this node
+    SpineBatcher*                       m_pBatcher = nullptr;
+    float                               m_aQuadVertices[8];
+    std::vector<float>                  m_vFixedBones;
+    bool                                m_bFixedBonesDirty = true;
+    std::vector<int16_t>                m_vFixedPositions;
+    std::map<const float*, std::vector<int16_t>> m_fixedUVs;
+    SpineImpostor*                      m_pImpostor = nullptr;
+    Animation*                          m_pImpostorAnimation = nullptr;
+    bool                                m_bImpostor = false;
+    // the impostor advanced the tracks since the skeleton was last posed
+    bool                                m_bImpostorPoseStale = false;
+    // set while a SpineScheduler decides when this node updates
+    SpineScheduler*                     m_pScheduler = nullptr;
+    // picked by the scheduler for this frame
+    bool                                m_bUpdateDue = false;
+    // time of the frames skipped since the last update, applied by the next one
+    float                               m_fSkippedTime = 0;
+    int                                 m_iSkippedFrames = 0;
+    // microseconds of the last update and a running average of them, posing and skinning
+    int                                 m_iLastUpdateMicros = 0;
+    int                                 m_iUpdateMicros = 0;
+    // current and previous captured poses, m_iPose is the current one
+    PoseVertices                        m_aPoseVertices[2];
+    int                                 m_iPose = 0;
+    bool                                m_bPoseCaptured = false;
+    bool                                m_bBlendPoses = false;
+    // time between the two poses, and since the current one including its own frame
+    float                               m_fPoseInterval = 0;
+    float                               m_fPoseAge = 0;
+    // node space AABB of the current pose, min greater than max when nothing is drawn
+    float                               m_aPoseBounds[4];
+    std::vector<float>                  m_vBlendedPositions;
+    bool                                m_bLazyAnimations = false;
+    size_t                              m_iAnimationBudget = 0;
+    std::vector<std::string>            m_vRequiredSkins;
+    std::vector<std::string>            m_vRequiredAnimations;
+    bool                                m_bStripUnreachable = false;
+    bool                                m_bQuantizeAnimations = false;
+    int                                 m_iPhysicsMaxSteps = 0;
+    bool                                m_bPhysicsDefer = false;
+#ifdef CONFIG_SPINE_VERSION_42
+    std::vector<SkeletonPose*>          m_vPoses;
+#endif
+    std::vector<HitBox>                 m_vHitBoxes;
+    std::vector<float>                  m_vHitVertices;
+    // skeleton space union of the visible box AABBs
+    float                               m_aHitAABB[4];
+    bool                                m_bHitBoundsDirty = true;
+    bool                                m_bHitBoundsValid = false;
+    // position in SpineHitGrid, -1 when not in it
+    int                                 m_iHitGridIndex = -1;
+    EventCollector                      m_eventCollector;
+    bool                                m_bEventsEnabled = false;
+    // ring buffer, m_iEventHead is the oldest undrained record
+    std::vector<EventRecord>            m_vEvents;
+    int                                 m_iEventHead = 0;
+    int                                 m_iEventCount = 0;
+    int                                 m_iDroppedEvents = 0;
+    std::string                         m_sDrainedEvents;
+    std::string                         m_sHitName;
+    // data pointers to the handles reported in notifications
+    std::map<const Animation*, int>     m_animationHandles;
+    std::map<const EventData*, int>     m_eventHandles;
 };
 typedef SharedPtr<SpineNode> SpineAnimationPtr;
 
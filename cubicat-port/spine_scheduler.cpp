@@ -0,0 +1,108 @@
+#include "spine_scheduler.h"
+#include "spine_node.h"
+#include <algorithm>
+
+SpineScheduler::~SpineScheduler() {
+    for (auto node : m_vNodes)
+        node->m_pScheduler = nullptr;
+}
+
+SpineScheduler* SpineScheduler::createSpineScheduler() {
+    return NEW SpineScheduler();
+}
+
+void SpineScheduler::addNode(SpineNode* node) {
+    if (!node || node->m_pScheduler == this)
+        return;
+    if (node->m_pScheduler)
+        node->m_pScheduler->removeNode(node);
+    node->m_pScheduler = this;
+    node->m_bUpdateDue = true;
+    m_vNodes.push_back(node);
+}
+
+void SpineScheduler::removeNode(SpineNode* node) {
+    auto it = std::find(m_vNodes.begin(), m_vNodes.end(), node);
+    if (it == m_vNodes.end())
+        return;
+    m_vNodes.erase(it);
+    m_vPicked.erase(std::remove(m_vPicked.begin(), m_vPicked.end(), node), m_vPicked.end());
+    node->m_pScheduler = nullptr;
+}
+
+void SpineScheduler::setBudget(int micros) {
+    m_iBudget = std::max(0, micros);
+}
+
+void SpineScheduler::setView(float x, float y, float width, float height) {
+    m_bHasView = width > 0 && height > 0;
+    m_aView[0] = x;
+    m_aView[1] = y;
+    m_aView[2] = x + width;
+    m_aView[3] = y + height;
+}
+
+void SpineScheduler::setMaxSkippedFrames(int frames) {
+    m_iMaxSkippedFrames = std::max(0, frames);
+}
+
+int SpineScheduler::getUpdatedNodes() {
+    return m_iUpdatedNodes;
+}
+
+int SpineScheduler::getUsedMicros() {
+    return m_iUsedMicros;
+}
+
+float SpineScheduler::priority(SpineNode* node) {
+    const float* bounds = node->m_aPoseBounds;
+    float width = std::max(0.0f, bounds[2] - bounds[0]);
+    float height = std::max(0.0f, bounds[3] - bounds[1]);
+    bool onScreen = true;
+    if (m_bHasView) {
+        auto pos = node->getPosition();
+        onScreen = width > 0 && pos.x + bounds[0] < m_aView[2] && pos.x + bounds[2] > m_aView[0] &&
+                   pos.y + bounds[1] < m_aView[3] && pos.y + bounds[3] > m_aView[1];
+    }
+    // a node 128 units across counts double, one on screen four times
+    float weight = (1 + std::max(width, height) / 128) * (onScreen ? 4 : 1);
+    return (node->m_iSkippedFrames + 1) * weight;
+}
+
+void SpineScheduler::update(float deltaTime, bool parentDirty) {
+    Node::update(deltaTime, parentDirty);
+    // the nodes picked last frame have updated since and measured themselves
+    m_iUsedMicros = 0;
+    for (auto node : m_vPicked) {
+        if (!node->m_bUpdateDue)
+            m_iUsedMicros += node->m_iLastUpdateMicros;
+    }
+    m_vPicked.clear();
+    m_vCandidates.clear();
+    int used = 0;
+    for (auto node : m_vNodes) {
+        node->m_bUpdateDue = false;
+        // impostors and hidden nodes don't pose
+        if (!node->m_pSkeleton || !node->isVisible() || node->m_bImpostor)
+            continue;
+        bool overdue = m_iMaxSkippedFrames > 0 && node->m_iSkippedFrames >= m_iMaxSkippedFrames;
+        if (!m_iBudget || !node->m_bPoseCaptured || overdue) {
+            node->m_bUpdateDue = true;
+            m_vPicked.push_back(node);
+            used += node->m_iUpdateMicros;
+            continue;
+        }
+        m_vCandidates.push_back({node, priority(node)});
+    }
+    std::sort(m_vCandidates.begin(), m_vCandidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+    for (auto& candidate : m_vCandidates) {
+        int cost = candidate.node->m_iUpdateMicros;
+        if (used + cost > m_iBudget && !m_vPicked.empty())
+            continue;
+        candidate.node->m_bUpdateDue = true;
+        m_vPicked.push_back(candidate.node);
+        used += cost;
+    }
+    m_iUpdatedNodes = (int)m_vPicked.size();
+}
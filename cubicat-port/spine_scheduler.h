@@ -0,0 +1,63 @@
+#ifndef _SPINE_SCHEDULER_H_
+#define _SPINE_SCHEDULER_H_
+#include <vector>
+#include <stdint.h>
+#include "graphic_engine/node2d.h"
+
+using namespace cubicat;
+
+class SpineNode;
+// Spreads the skeleton updates of the added SpineNodes over frames so they fit a CPU budget. Every
+// frame it picks the nodes to update, those skipped longest first, weighted up when on screen and
+// large, until the budget is used. A skipped node keeps its time for its next update and meanwhile
+// draws its slot vertices blended between its last two updates, one update interval behind.
+// Decides for the frame it's updated in: put it under the same parent as its nodes, before them.
+class SpineScheduler : public Node2D
+{
+public:
+    DECLARE_RTTI_SUB(SpineScheduler, Node2D)
+    SharedPtr<SpineScheduler> static create() {return SharedPtr<SpineScheduler>(NEW SpineScheduler());}
+    ~SpineScheduler();
+
+    void update(float deltaTime, bool parentDirty) override;
+    // [JS_BINDING_BEGIN]
+    static SpineScheduler* createSpineScheduler();
+    // the node updates only on the frames this scheduler picks
+    void addNode(SpineNode* node);
+    // the node updates every frame again
+    void removeNode(SpineNode* node);
+    // microseconds of skeleton updates per frame, from each node's measured update time. 0 updates
+    // every node every frame. At least one node updates each frame however small the budget.
+    void setBudget(int micros);
+    // nodes overlapping this rectangle (parent space) are on screen and come first. Without one every
+    // node counts as on screen.
+    void setView(float x, float y, float width, float height);
+    // no node is skipped more than frames frames in a row, even over the budget. 0 for no limit.
+    void setMaxSkippedFrames(int frames);
+    // nodes picked by the last update
+    int getUpdatedNodes();
+    // microseconds the nodes picked the frame before the last update took
+    int getUsedMicros();
+    // [JS_BINDING_END]
+private:
+    struct Candidate {
+        SpineNode*  node;
+        float       score;
+    };
+    SpineScheduler() = default;
+    // how much updating the node now is worth, grows each frame it's skipped
+    float priority(SpineNode* node);
+    std::vector<SpineNode*>     m_vNodes;
+    std::vector<Candidate>      m_vCandidates;
+    // nodes picked by the last update, to read back their cost
+    std::vector<SpineNode*>     m_vPicked;
+    int                         m_iBudget = 0;
+    bool                        m_bHasView = false;
+    float                       m_aView[4];
+    int                         m_iMaxSkippedFrames = 0;
+    int                         m_iUpdatedNodes = 0;
+    int                         m_iUsedMicros = 0;
+};
+typedef SharedPtr<SpineScheduler> SpineSchedulerPtr;
+
+#endif
@@ -2,10 +2,38 @@
 #include "cubicat.h"
 #include "libpng/png.h"
 #include "utils/logger.h"
+#include <string.h>
 
 GetImageDataInMemory CubicatTextureLoader::m_pGetImageInMemory = nullptr;
 ResLocation CubicatTextureLoader::m_eResLocation = MEMORY;
 
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV_PRIME 0x100000001b3ull
+
+static uint64_t fnv1a(uint64_t hash, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static void* getPageTexture(AtlasPage &page) {
+#if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+    return page.getRendererObject();
+#else
+    return page.texture;
+#endif
+}
+
+static void setPageTexture(AtlasPage &page, void* texture) {
+#if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+    page.setRendererObject(texture);
+#else
+    page.texture = texture;
+#endif
+}
+
 png_voidp
 PNGCBAPI png_spine_malloc(png_structp png_ptr, png_alloc_size_t size)
 {
@@ -57,6 +85,192 @@ void CubicatTextureLoader::unload(void *texture) {
     // Texture managed by cubicat engine, do nothing
 }
 
+FILE* CubicatTextureLoader::openPage(const char* path) {
+    if (m_eResLocation == SPIFFS)
+        return CUBICAT.storage.openFileFlash(path);
+    if (m_eResLocation == SDCARD)
+        return CUBICAT.storage.openFileSD(path);
+    return nullptr;
+}
+
+uint64_t CubicatTextureLoader::sampleHash(const char* path) {
+    FILE* fp = openPage(path);
+    if (!fp)
+        return fnv1a(FNV_OFFSET_BASIS, (const uint8_t*)path, strlen(path));
+    // PNGs of different pages nearly always differ in size or in their header and first pixels, two seeks
+    // and reads sort them apart without reading the files whole
+    uint8_t buffer[256];
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t n = fread(buffer, 1, sizeof(buffer), fp);
+    hash = fnv1a(hash, buffer, n);
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    if (size > (long)(2 * sizeof(buffer)) && fseek(fp, -(long)sizeof(buffer), SEEK_END) == 0) {
+        n = fread(buffer, 1, sizeof(buffer), fp);
+        hash = fnv1a(hash, buffer, n);
+    }
+    fclose(fp);
+    return fnv1a(hash, (const uint8_t*)&size, sizeof(size));
+}
+
+uint64_t CubicatTextureLoader::contentHash(const char* path) {
+    FILE* fp = openPage(path);
+    if (!fp)
+        return fnv1a(FNV_OFFSET_BASIS, (const uint8_t*)path, strlen(path));
+    uint8_t buffer[512];
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t size = 0;
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        hash = fnv1a(hash, buffer, n);
+        size += n;
+    }
+    fclose(fp);
+    // keep file contents and path names apart, a file can't hash with its own size appended
+    return fnv1a(hash, (const uint8_t*)&size, sizeof(size));
+}
+
+uint64_t CubicatTextureLoader::getContentHash(const std::string& path, PageKey& key) {
+    if (!key.hashed) {
+        key.content = contentHash(path.c_str());
+        key.hashed = true;
+    }
+    return key.content;
+}
+
+CubicatTextureLoader::PageKey CubicatTextureLoader::pageKey(const char* path) {
+    PageKey key;
+    key.sample = sampleHash(path);
+    key.key = key.sample;
+    // only pages sampling the same can hold the same file, those are read whole to tell
+    bool candidate = false;
+    for (auto& it : m_pageKeys) {
+        if (it.second.sample != key.sample)
+            continue;
+        candidate = true;
+        if (getContentHash(it.first, it.second) == getContentHash(path, key))
+            return it.second;
+    }
+    // sampled the same as a different file, keyed apart by the content
+    if (candidate)
+        key.key = key.content;
+    return key;
+}
+
+cubicat::TexturePtr CubicatTextureLoader::acquirePage(AtlasPage &page) {
+    const char* path = page.texturePath.buffer();
+    if (!path || !path[0])
+        return nullptr;
+    auto keyIt = m_pageKeys.find(path);
+    if (keyIt == m_pageKeys.end())
+        keyIt = m_pageKeys.emplace(path, pageKey(path)).first;
+    SharedPage& shared = m_sharedPages[keyIt->second.key];
+    if (!shared.texture) {
+        m_pLastPixels = nullptr;
+        if (!getPageTexture(page))
+            load(page, page.texturePath);
+        if (!getPageTexture(page)) {
+            m_sharedPages.erase(keyIt->second.key);
+            return nullptr;
+        }
+        shared.texture = cubicat::TexturePtr((cubicat::Texture*)getPageTexture(page));
+        shared.image.pixels = m_pLastPixels;
+        shared.image.format = page.format;
+        shared.image.width = page.width;
+        shared.image.height = page.height;
+        shared.users = 0;
+    } else if (getPageTexture(page) != shared.texture.get()) {
+        setPageTexture(page, shared.texture.get());
+        page.format = shared.image.format;
+        page.width = shared.image.width;
+        page.height = shared.image.height;
+    }
+    shared.users++;
+    return shared.texture;
+}
+
+void CubicatTextureLoader::releasePage(AtlasPage &page) {
+    if (!getPageTexture(page))
+        return;
+    setPageTexture(page, nullptr);
+    auto keyIt = m_pageKeys.find(page.texturePath.buffer());
+    if (keyIt == m_pageKeys.end())
+        return;
+    auto it = m_sharedPages.find(keyIt->second.key);
+    if (it == m_sharedPages.end())
+        return;
+    // drawables still holding the texture keep it alive until they switch pages
+    if (--it->second.users <= 0)
+        m_sharedPages.erase(it);
+}
+
+size_t CubicatTextureLoader::getSharedBytes() {
+    size_t bytes = 0;
+    for (auto& it : m_sharedPages)
+        bytes += getFormatBytes(it.second.image.format, it.second.image.width, it.second.image.height);
+    return bytes;
+}
+
+bool CubicatTextureLoader::getPageImage(const cubicat::Texture* texture, PageImage& image) {
+    for (auto& it : m_sharedPages) {
+        if (it.second.texture.get() == texture) {
+            image = it.second.image;
+            return image.pixels != nullptr;
+        }
+    }
+    return false;
+}
+
+uint32_t PageImage::sample(float u, float v) const {
+    int x = (int)(u * width);
+    int y = (int)(v * height);
+    x = x < 0 ? 0 : (x >= width ? width - 1 : x);
+    y = y < 0 ? 0 : (y >= height ? height - 1 : y);
+    int i = y * width + x;
+    if (format == Format_Indexed8) {
+        size_t indexBytes = ((size_t)width * height + 3) & ~(size_t)3;
+        const uint16_t* clut = (const uint16_t*)(pixels + indexBytes);
+        const uint8_t* clutAlpha = (const uint8_t*)(clut + INDEXED_CLUT_SIZE);
+        uint8_t index = pixels[i];
+        uint16_t c = clut[index];
+        return ((uint32_t)((c >> 11) << 3) << 24) | ((uint32_t)(((c >> 5) & 0x3f) << 2) << 16) |
+               ((uint32_t)((c & 0x1f) << 3) << 8) | clutAlpha[index];
+    }
+    if (format == Format_RGB565) {
+        uint16_t c = ((const uint16_t*)pixels)[i];
+        return ((uint32_t)((c >> 11) << 3) << 24) | ((uint32_t)(((c >> 5) & 0x3f) << 2) << 16) |
+               ((uint32_t)((c & 0x1f) << 3) << 8) | 0xff;
+    }
+    return ((const uint32_t*)pixels)[i];
+}
+
+size_t CubicatTextureLoader::getPageBytes(const AtlasPage &page) {
+    return getFormatBytes(page.format, page.width, page.height);
+}
+
+size_t CubicatTextureLoader::getFormatBytes(Format format, int width, int height) {
+    size_t bytePerPixel = 4;
+    switch (format) {
+        case Format_Alpha:
+        case Format_Intensity:
+            bytePerPixel = 1;
+            break;
+        case Format_LuminanceAlpha:
+        case Format_RGB565:
+        case Format_RGBA4444:
+            bytePerPixel = 2;
+            break;
+        case Format_RGB888:
+            bytePerPixel = 3;
+            break;
+        case Format_Indexed8:
+            return (size_t)width * height + INDEXED_CLUT_BYTES;
+        default:
+            break;
+    }
+    return (size_t)width * height * bytePerPixel;
+}
+
 void CubicatTextureLoader::loadPNG(AtlasPage &page, const char* path) {
     png_structp png = png_create_read_struct_2(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr, nullptr, png_spine_malloc, png_spine_free);
     if (!png) {
@@ -79,9 +293,12 @@ void CubicatTextureLoader::loadPNG(AtlasPage &page, const char* path) {
         fclose(fp);
         return;
     }
+    // pixels being decoded when libpng longjmps back here, volatile as it's set after setjmp
+    uint8_t* volatile pixels = nullptr;
     if (setjmp(png_jmpbuf(png))) {
         png_destroy_read_struct(&png, &info, nullptr);
         fclose(fp);
+        free(pixels);
         return;
     }
     png_init_io(png, fp);
@@ -91,14 +308,29 @@ void CubicatTextureLoader::loadPNG(AtlasPage &page, const char* path) {
     auto height = png_get_image_height(png, info);
     png_byte colorType = png_get_color_type(png, info);
     png_byte bitDepth = png_get_bit_depth(png, info);
+    if (colorType == PNG_COLOR_TYPE_PALETTE) {
+        cubicat::Texture* texture = loadIndexedPNG(png, info, width, height, pixels);
+        png_destroy_read_struct(&png, &info, nullptr);
+        fclose(fp);
+        if (!texture) {
+            LOGE("decode palette png %s fail", path);
+            return;
+        }
+#if defined(CONFIG_SPINE_VERSION_38) || defined(CONFIG_SPINE_VERSION_40)
+        page.texturePath = path;
+        page.setRendererObject(texture);
+#else
+        page.texture = texture;
+#endif
+        page.width = width;
+        page.height = height;
+        page.format = Format_Indexed8;
+        return;
+    }
     if (bitDepth != 8) {
         assert(false && "not support bit depth not 8 yet");
     }
     // 处理透明度
-    if (colorType == PNG_COLOR_TYPE_PALETTE) {
-        assert(false && "not support palette yet");
-        png_set_palette_to_rgb(png);
-    }
     if (colorType == PNG_COLOR_TYPE_GRAY) {
         assert(false && "not support gray yet");
         png_set_expand_gray_1_2_4_to_8(png);
@@ -125,6 +357,7 @@ void CubicatTextureLoader::loadPNG(AtlasPage &page, const char* path) {
     for (int y = 0; y < height; ++y) {
         rowPointers[y] = imgData + y * width * bytePerPixel;
     }
+    pixels = imgData;
     png_read_image(png, rowPointers);
     if (noAlpha) {
         uint16_t* rgb565 = (uint16_t*)heap_caps_malloc(width * height * 2, MALLOC_CAP_SPIRAM);
@@ -152,6 +385,7 @@ void CubicatTextureLoader::loadPNG(AtlasPage &page, const char* path) {
             }
         }
     }
+    m_pLastPixels = imgData;
     cubicat::Texture* texture = NEW cubicat::Texture(width, height, imgData, true, 1, 1, nullptr, bitPerPixel, !noAlpha);
     png_destroy_read_struct(&png, &info, nullptr);
     fclose(fp);
@@ -163,4 +397,46 @@ void CubicatTextureLoader::loadPNG(AtlasPage &page, const char* path) {
 #endif
     page.width = width;
     page.height = height;
-}
\ No newline at end of file
+    page.format = noAlpha ? Format_RGB565 : Format_RGBA8888;
+}
+
+cubicat::Texture* CubicatTextureLoader::loadIndexedPNG(png_structp png, png_infop info, uint32_t width, uint32_t height,
+                                                       uint8_t* volatile& pixels) {
+    png_colorp palette = nullptr;
+    int paletteSize = 0;
+    if (!png_get_PLTE(png, info, &palette, &paletteSize) || paletteSize > INDEXED_CLUT_SIZE)
+        return nullptr;
+    png_bytep trans = nullptr;
+    int transSize = 0;
+    if (png_get_valid(png, info, PNG_INFO_tRNS))
+        png_get_tRNS(png, info, &trans, &transSize, nullptr);
+    // 1, 2 and 4 bit indices are unpacked to a byte each
+    png_set_packing(png);
+    png_read_update_info(png, info);
+    // indices first, the texture frees the whole block through its data pointer
+    size_t indexBytes = ((size_t)width * height + 3) & ~(size_t)3;
+    uint8_t* imgData = (uint8_t*)heap_caps_malloc(indexBytes + INDEXED_CLUT_BYTES, MALLOC_CAP_SPIRAM);
+    if (!imgData)
+        return nullptr;
+    uint16_t* clut = (uint16_t*)(imgData + indexBytes);
+    uint8_t* clutAlpha = (uint8_t*)(clut + INDEXED_CLUT_SIZE);
+    bool hasAlpha = false;
+    for (int i = 0; i < INDEXED_CLUT_SIZE; ++i) {
+        if (i < paletteSize) {
+            clut[i] = (uint16_t)(((palette[i].red >> 3) << 11) | ((palette[i].green >> 2) << 5) | (palette[i].blue >> 3));
+            clutAlpha[i] = i < transSize ? trans[i] : 255;
+            hasAlpha |= clutAlpha[i] != 255;
+        } else {
+            clut[i] = 0;
+            clutAlpha[i] = 0;
+        }
+    }
+    uint8_t* rowPointers[height];
+    for (uint32_t y = 0; y < height; ++y) {
+        rowPointers[y] = imgData + y * width;
+    }
+    pixels = imgData;
+    png_read_image(png, rowPointers);
+    m_pLastPixels = imgData;
+    return NEW cubicat::Texture(width, height, imgData, true, 1, 1, clut, 8, hasAlpha);
+}
@@ -3,11 +3,32 @@
 #include "spine/TextureLoader.h"
 #include "spine/Atlas.h"
 #include "graphic_engine/drawable/image_data.h"
+#include "graphic_engine/drawable/texture.h"
+#include "libpng/png.h"
+#include <map>
+#include <stdio.h>
+#include <string>
 
 using namespace spine;
 
 typedef const ImageData& (*GetImageDataInMemory)(const char* name);
 
+// Palette PNGs load as 8 bit indexed textures (AtlasPage::format is Format_Indexed8). The CLUT follows
+// the indices in the same block: INDEXED_CLUT_SIZE RGB565 colors, then as many 8 bit alphas.
+#define INDEXED_CLUT_SIZE 256
+#define INDEXED_CLUT_BYTES (INDEXED_CLUT_SIZE * 3)
+
+// Decoded pixels of a page, for reading pages back on the CPU
+struct PageImage {
+    // RGBA8888 words (r << 24 | g << 16 | b << 8 | a), RGB565 words, or indices followed by the CLUT
+    const uint8_t*  pixels = nullptr;
+    Format          format = Format_RGBA8888;
+    int             width = 0;
+    int             height = 0;
+    // texel at uv, clamped to the page, as RGBA8888
+    uint32_t sample(float u, float v) const;
+};
+
 enum ResLocation {
     MEMORY,
     SPIFFS,
@@ -21,10 +42,49 @@ public:
     virtual void load(AtlasPage &page, const String &path);
 
     virtual void unload(void *texture);
+    // bytes occupied by the decoded texture of a page, based on its pixel format
+    static size_t getPageBytes(const AtlasPage &page);
+    // Decoded pages are shared by every atlas loaded through this loader: a page decodes once per
+    // path, and once per file content when atlases ship identical pages under different paths.
+    // Each page holding the texture counts as one user, the texture is dropped with the last one.
+    cubicat::TexturePtr acquirePage(AtlasPage &page);
+    void releasePage(AtlasPage &page);
+    // bytes of distinct decoded pages
+    size_t getSharedBytes();
+    // pixels of a page texture acquired through this loader, false when unknown or not loaded from a file
+    bool getPageImage(const cubicat::Texture* texture, PageImage& image);
 private:
+    struct SharedPage {
+        cubicat::TexturePtr texture;
+        PageImage           image;
+        int                 users = 0;
+    };
+    struct PageKey {
+        // hash of the file size and its first and last bytes
+        uint64_t    sample = 0;
+        // hash of the whole file, computed when another page samples the same
+        uint64_t    content = 0;
+        bool        hashed = false;
+        uint64_t    key = 0;
+    };
+    static size_t getFormatBytes(Format format, int width, int height);
+    static FILE* openPage(const char* path);
+    // hashes of the page file, of the path itself when the file can't be read
+    static uint64_t sampleHash(const char* path);
+    static uint64_t contentHash(const char* path);
+    uint64_t getContentHash(const std::string& path, PageKey& key);
+    // key of the shared page, the same for files with the same content
+    PageKey pageKey(const char* path);
     void loadPNG(AtlasPage &page, const char* path);
+    // pixels is set to the block before libpng writes into it, for loadPNG to free when libpng longjmps
+    cubicat::Texture* loadIndexedPNG(png_structp png, png_infop info, uint32_t width, uint32_t height,
+                                     uint8_t* volatile& pixels);
     static ResLocation          m_eResLocation;
     static GetImageDataInMemory m_pGetImageInMemory;
+    std::map<std::string, PageKey>      m_pageKeys;
+    std::map<uint64_t, SharedPage>      m_sharedPages;
+    // pixels handed to the last texture decoded by loadPNG
+    const uint8_t*                      m_pLastPixels = nullptr;
 };
 
 #endif
\ No newline at end of file
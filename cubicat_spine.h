@@ -2,4 +2,6 @@
 #define _CUBICAT_SPINE_H_
 #include "cubicat-port/spine_extension.h"
 #include "cubicat-port/spine_node.h"
+#include "cubicat-port/spine_batcher.h"
+#include "cubicat-port/spine_scheduler.h"
 #endif
\ No newline at end of file
@@ -443,6 +443,12 @@ namespace spine {
 
         void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
     };
+
+// only pointers besides the vtable, see IsRelocatable
+template<>
+struct IsRelocatable<EventQueueEntry> {
+	static const bool value = true;
+};
 }
 
 #endif /* Spine_AnimationState_h */
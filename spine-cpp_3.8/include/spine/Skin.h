@@ -159,6 +159,12 @@ private:
 	/// Attach all attachments from this skin if the corresponding attachment from the old skin is currently attached.
 	void attachAll(Skeleton &skeleton, Skin &oldSkin);
 };
+
+// entries hold a String and pointers, see IsRelocatable
+template<>
+struct IsRelocatable<Skin::AttachmentMap::Entry> {
+	static const bool value = true;
+};
 }
 
 #endif /* Spine_Skin_h */
@@ -73,6 +73,11 @@ public:
 		}
 	}
 
+	String(String &&other) : _length(other._length), _buffer(other._buffer) {
+		other._length = 0;
+		other._buffer = NULL;
+	}
+
 	size_t length() const {
 		return _length;
 	}
@@ -132,6 +137,18 @@ public:
 		return *this;
 	}
 
+	String &operator=(String &&other) {
+		if (this == &other) return *this;
+		if (_buffer) {
+			SpineExtension::free(_buffer, __FILE__, __LINE__);
+		}
+		_length = other._length;
+		_buffer = other._buffer;
+		other._length = 0;
+		other._buffer = NULL;
+		return *this;
+	}
+
 	String &operator=(const char *chars) {
 		if (_buffer == chars) return *this;
 		if (_buffer) {
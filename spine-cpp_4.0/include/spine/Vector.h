@@ -34,15 +34,52 @@
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <assert.h>
+#include <string.h>
+#include <utility>
+#include <type_traits>
 
 namespace spine {
+	template<typename T>
+	class Vector;
+
+	/// Element types a Vector may move to another address with memcpy or realloc, without running
+	/// their copy constructor and destructor. True for trivially copyable types. Spine's containers and
+	/// strings only point at their heap buffers, never into themselves, and opt in below.
+	template<typename T>
+	struct IsRelocatable {
+		static const bool value = std::is_trivially_copyable<T>::value;
+	};
+
+	template<typename T>
+	struct IsRelocatable<Vector<T> > {
+		static const bool value = true;
+	};
+
+	template<>
+	struct IsRelocatable<String> {
+		static const bool value = true;
+	};
+
+#ifdef SPINE_VECTOR_STATS
+	/// Copy constructions of non trivial elements (strings, nested vectors, ...) and buffer reallocations
+	/// made by all Vectors, counted when built with SPINE_VECTOR_STATS defined. Reset them before the
+	/// work to measure.
+	struct SP_API VectorStats {
+		static size_t copies;
+		static size_t reallocations;
+	};
+#define SPINE_VECTOR_COUNT(counter) (++VectorStats::counter)
+#else
+#define SPINE_VECTOR_COUNT(counter) ((void) 0)
+#endif
+
 	template<typename T>
 	class SP_API Vector : public SpineObject {
 	public:
 		Vector() : _size(0), _capacity(0), _buffer(NULL) {
 		}
 
-		Vector(const Vector &inVector) : _size(inVector._size), _capacity(inVector._capacity), _buffer(NULL) {
+		Vector(const Vector &inVector) : _size(inVector._size), _capacity(inVector._size), _buffer(NULL) {
 			if (_capacity > 0) {
 				_buffer = allocate(_capacity);
 				for (size_t i = 0; i < _size; ++i) {
@@ -51,11 +88,41 @@ namespace spine {
 			}
 		}
 
+		Vector(Vector &&inVector) : _size(inVector._size), _capacity(inVector._capacity), _buffer(inVector._buffer) {
+			inVector._size = 0;
+			inVector._capacity = 0;
+			inVector._buffer = NULL;
+		}
+
 		~Vector() {
 			clear();
 			deallocate(_buffer);
 		}
 
+		Vector &operator=(const Vector &inVector) {
+			if (this == &inVector) return *this;
+			clear();
+			ensureCapacity(inVector._size);
+			for (size_t i = 0; i < inVector._size; ++i) {
+				construct(_buffer + i, inVector._buffer[i]);
+			}
+			_size = inVector._size;
+			return *this;
+		}
+
+		Vector &operator=(Vector &&inVector) {
+			if (this == &inVector) return *this;
+			clear();
+			deallocate(_buffer);
+			_size = inVector._size;
+			_capacity = inVector._capacity;
+			_buffer = inVector._buffer;
+			inVector._size = 0;
+			inVector._capacity = 0;
+			inVector._buffer = NULL;
+			return *this;
+		}
+
 		inline void clear() {
 			for (size_t i = 0; i < _size; ++i) {
 				destroy(_buffer + (_size - 1 - i));
@@ -75,12 +142,12 @@ namespace spine {
 		inline void setSize(size_t newSize, const T &defaultValue) {
 			assert(newSize >= 0);
 			size_t oldSize = _size;
-			_size = newSize;
 			if (_capacity < newSize) {
-				_capacity = (int) (_size * 1.75f);
-				if (_capacity < 8) _capacity = 8;
-				_buffer = spine::SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
+				size_t capacity = (int) (newSize * 1.75f);
+				if (capacity < 8) capacity = 8;
+				reallocate(capacity);
 			}
+			_size = newSize;
 			if (oldSize < _size) {
 				for (size_t i = oldSize; i < _size; i++) {
 					construct(_buffer + i, defaultValue);
@@ -90,8 +157,7 @@ namespace spine {
 
 		inline void ensureCapacity(size_t newCapacity = 0) {
 			if (_capacity >= newCapacity) return;
-			_capacity = newCapacity;
-			_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
+			reallocate(newCapacity);
 		}
 
 		inline void add(const T &inValue) {
@@ -101,15 +167,23 @@ namespace spine {
 				// We thus need to create a defensive copy before
 				// reallocating.
 				T valueCopy = inValue;
-				_capacity = (int) (_size * 1.75f);
-				if (_capacity < 8) _capacity = 8;
-				_buffer = spine::SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
-				construct(_buffer + _size++, valueCopy);
+				grow();
+				construct(_buffer + _size++, std::move(valueCopy));
 			} else {
 				construct(_buffer + _size++, inValue);
 			}
 		}
 
+		inline void add(T &&inValue) {
+			if (_size == _capacity) {
+				T value(std::move(inValue));
+				grow();
+				construct(_buffer + _size++, std::move(value));
+			} else {
+				construct(_buffer + _size++, std::move(inValue));
+			}
+		}
+
 		inline void addAll(Vector<T> &inValue) {
 			ensureCapacity(this->size() + inValue.size());
 			for (size_t i = 0; i < inValue.size(); i++) {
@@ -125,14 +199,16 @@ namespace spine {
 		inline void removeAt(size_t inIndex) {
 			assert(inIndex < _size);
 
-			--_size;
+			if (IsRelocatable<T>::value) {
+				destroy(_buffer + inIndex);
+				--_size;
+				memmove((void *) (_buffer + inIndex), (void *) (_buffer + inIndex + 1), (_size - inIndex) * sizeof(T));
+				return;
+			}
 
-			if (inIndex != _size) {
-				for (size_t i = inIndex; i < _size; ++i) {
-					T tmp(_buffer[i]);
-					_buffer[i] = _buffer[i + 1];
-					_buffer[i + 1] = tmp;
-				}
+			--_size;
+			for (size_t i = inIndex; i < _size; ++i) {
+				_buffer[i] = std::move(_buffer[i + 1]);
 			}
 
 			destroy(_buffer + _size);
@@ -208,14 +284,41 @@ namespace spine {
 		}
 
 		inline void construct(T *buffer, const T &val) {
+			if (!std::is_trivially_copyable<T>::value) SPINE_VECTOR_COUNT(copies);
 			new(buffer) T(val);
 		}
 
+		inline void construct(T *buffer, T &&val) {
+			new(buffer) T(std::move(val));
+		}
+
 		inline void destroy(T *buffer) {
 			buffer->~T();
 		}
 
-		// Vector &operator=(const Vector &inVector) {};
+		inline void grow() {
+			size_t capacity = (int) (_size * 1.75f);
+			if (capacity < 8) capacity = 8;
+			reallocate(capacity);
+		}
+
+		// moves the elements to a buffer of newCapacity, which holds at least _size of them. Relocatable
+		// elements move with the buffer, others are move constructed into a new one.
+		inline void reallocate(size_t newCapacity) {
+			SPINE_VECTOR_COUNT(reallocations);
+			if (IsRelocatable<T>::value) {
+				_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
+			} else {
+				T *buffer = allocate(newCapacity);
+				for (size_t i = 0; i < _size; ++i) {
+					construct(buffer + i, std::move(_buffer[i]));
+					destroy(_buffer + i);
+				}
+				deallocate(_buffer);
+				_buffer = buffer;
+			}
+			_capacity = newCapacity;
+		}
 	};
 }
 
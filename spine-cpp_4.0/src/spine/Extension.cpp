@@ -32,6 +32,7 @@
 #endif
 
 #include <spine/Extension.h>
+#include <spine/Vector.h>
 #include <spine/SpineString.h>
 
 #include <assert.h>
@@ -40,6 +41,11 @@ using namespace spine;
 
 SpineExtension *SpineExtension::_instance = NULL;
 
+#ifdef SPINE_VECTOR_STATS
+size_t VectorStats::copies = 0;
+size_t VectorStats::reallocations = 0;
+#endif
+
 void SpineExtension::setInstance(SpineExtension *inValue) {
 	assert(inValue);
 
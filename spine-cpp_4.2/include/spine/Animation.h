@@ -47,6 +47,8 @@ namespace spine {
 
 	class AnimationState;
 
+	class AnimationCache;
+
 	class SP_API Animation : public SpineObject {
 		friend class AnimationState;
 
@@ -96,6 +98,10 @@ namespace spine {
 
 		friend class TwoColorTimeline;
 
+		friend class AnimationCache;
+
+		friend class SkeletonBinary;
+
 	public:
 		Animation(const String &name, Vector<Timeline *> &timelines, float duration);
 
@@ -116,15 +122,28 @@ namespace spine {
 
 		void setDuration(float inValue);
 
+		/// False if the animation was read lazily and its timelines are not decoded yet or were released by the
+		/// AnimationCache. The timelines are decoded again the next time the animation is applied or queued.
+		bool isLoaded();
+
 		/// @param target After the first and before the last entry.
 		static int search(Vector<float> &values, float target);
 
 		static int search(Vector<float> &values, float target, int step);
 	private:
 		Vector<Timeline *> _timelines;
+		/// Concrete type of each timeline, built by AnimationState on first apply.
+		Vector<unsigned char> _timelineTypes;
 		HashMap<PropertyId, bool> _timelineIds;
 		float _duration;
 		String _name;
+		AnimationCache *_cache;
+		size_t _binaryOffset;
+		size_t _binaryLength;
+		size_t _loadedBytes;
+		unsigned int _lastUsed;
+		int _references;
+		bool _loaded;
 	};
 }
 
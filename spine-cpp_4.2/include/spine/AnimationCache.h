@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AnimationCache_h
+#define Spine_AnimationCache_h
+
+#include <spine/Animation.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class SkeletonData;
+
+	class Skin;
+
+	class Timeline;
+
+	/// Decodes the timelines of animations read with SkeletonBinary::setLazyAnimations on first use and releases
+	/// the least recently used ones when the decoded size exceeds the budget. Animations referenced by a TrackEntry
+	/// are never released. Owned by the SkeletonData, see SkeletonData::getAnimationCache.
+	class SP_API AnimationCache : public SpineObject {
+		friend class Animation;
+
+		friend class AnimationState;
+
+		friend class TrackEntry;
+
+		friend class SkeletonBinary;
+
+	public:
+		/// @param binary Must stay valid for the lifetime of the cache, eg. a memory-mapped partition,
+		/// unless setPath is used to read animations back from a file.
+		AnimationCache(SkeletonData &skeletonData, const unsigned char *binary, int length, float scale);
+
+		~AnimationCache();
+
+		/// Reads animations from the file at path instead of the binary buffer.
+		void setPath(const String &path);
+
+		/// Maximum bytes of decoded timelines to keep, 0 for no limit.
+		void setBudget(size_t inValue);
+
+		size_t getBudget();
+
+		/// Approximate bytes of the currently decoded timelines.
+		size_t getLoadedBytes();
+
+		/// Number of animations decoded so far, including reloads of released animations.
+		int getLoadCount();
+
+		/// Decodes the animation's timelines if they are not loaded.
+		/// @return false if the animation could not be read back.
+		bool load(Animation &animation);
+
+		/// Releases the animation's timelines unless a TrackEntry references it.
+		void unload(Animation &animation);
+
+		/// Releases least recently used animations until the loaded bytes fit the budget.
+		void trim();
+
+		/// Approximate heap size of the timelines, used for the budget.
+		static size_t getTimelinesBytes(Vector<Timeline *> &timelines);
+
+	private:
+		SkeletonData &_skeletonData;
+		const unsigned char *_binary;
+		int _length;
+		String _path;
+		float _scale;
+		size_t _budget;
+		size_t _loadedBytes;
+		unsigned int _clock;
+		int _loadCount;
+		/// Skins by their index in the binary, set when the reader skipped skins.
+		Vector<Skin *> _skins;
+		bool _quantize;
+
+		void use(Animation &animation) {
+			if (!animation._loaded) load(animation);
+			animation._lastUsed = ++_clock;
+		}
+
+		void retain(Animation &animation);
+
+		void release(Animation &animation);
+
+		void add(Animation &animation, size_t offset, size_t length);
+
+		void trim(Animation *keep);
+	};
+}
+
+#endif /* Spine_AnimationCache_h */
@@ -69,6 +69,8 @@ namespace spine {
 
 	class AttachmentTimeline;
 
+	class Timeline;
+
 #ifdef SPINE_USE_STD_FUNCTION
 	typedef std::function<void (AnimationState* state, EventType type, TrackEntry* entry, Event* event)> AnimationStateListener;
 #else
@@ -374,6 +376,12 @@ namespace spine {
 		/// animation state can be applied to multiple skeletons to pose them identically.
 		bool apply(Skeleton &skeleton);
 
+		/// Poses the skeleton as if every current track entry's track time were the specified time, for scrubbing and
+		/// seeking. Mixing from entries are ignored and no events are fired, queued or collected, so track entries and
+		/// listeners are left untouched. Entries with a delay are skipped. Rotations always take the shortest route.
+		/// @return True if any track entry was applied.
+		bool applyAt(Skeleton &skeleton, float trackTime);
+
 		/// Removes all animations from all tracks, leaving skeletons in their previous pose.
 		/// It may be desired to use AnimationState.setEmptyAnimations(float) to mix the skeletons back to the setup pose,
 		/// rather than leaving them in their previous pose.
@@ -484,6 +492,9 @@ namespace spine {
 
 		static Animation *getEmptyAnimation();
 
+		/// Returns the concrete type of each of the animation's timelines, see applyTimeline.
+		static unsigned char *getTimelineTypes(Animation &animation, Vector<Timeline *> &timelines);
+
 		static void
 		applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleton &skeleton, float time, float alpha, MixBlend pose,
 							Vector<float> &timelinesRotation, size_t i, bool firstFrame);
@@ -498,6 +509,9 @@ namespace spine {
 
 		void queueEvents(TrackEntry *entry, float animationTime);
 
+		/// Sets the setup attachment for slots not keyed by an attachment timeline in the last apply.
+		void setUnkeyedAttachments(Skeleton &skeleton);
+
 		/// Sets the active TrackEntry for a given track number.
 		void setCurrent(size_t index, TrackEntry *current, bool interrupt);
 
@@ -516,6 +530,12 @@ namespace spine {
 
 		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
 	};
+
+	// only pointers besides the vtable, see IsRelocatable
+	template<>
+	struct IsRelocatable<EventQueueEntry> {
+		static const bool value = true;
+	};
 }
 
 #endif /* Spine_AnimationState_h */
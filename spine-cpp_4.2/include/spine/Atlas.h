@@ -45,7 +45,9 @@ namespace spine {
 		Format_RGB565,
 		Format_RGBA4444,
 		Format_RGB888,
-		Format_RGBA8888
+		Format_RGBA8888,
+		/// 8 bit indices into a color table. Never read from atlas files, texture loaders set it for palette images.
+		Format_Indexed8
 	};
 
 	// Our TextureFilter collides with UE4's TextureFilter in unity builds. We rename
@@ -62,6 +62,8 @@ namespace spine {
 
 		friend class Skeleton;
 
+		friend class SkeletonPose;
+
 		friend class RegionAttachment;
 
 		friend class PointAttachment;
@@ -48,6 +48,8 @@ namespace spine {
 	public:
 		explicit ClippingAttachment(const String &name);
 
+		virtual ~ClippingAttachment();
+
 		SlotData *getEndSlot();
 
 		void setEndSlot(SlotData *inValue);
@@ -59,6 +61,11 @@ namespace spine {
 	private:
 		SlotData *_endSlot;
 		Color _color;
+		/// The local vertices _convexPolygons were decomposed from, to detect vertices changed after decomposition.
+		Vector<float> _decomposedVertices;
+		/// Clockwise convex polygons in bone space, each closed by repeating its first vertex. Built by SkeletonClipping on
+		/// first use for unweighted attachments.
+		Vector<Vector<float> *> _convexPolygons;
 	};
 }
 
@@ -53,8 +53,14 @@ namespace spine {
 
 		float getBezierValue(float time, size_t frame, size_t valueOffset, size_t i);
 
+		/// Empty once the timeline is quantized.
 		Vector<float> &getCurves();
 
+		bool isQuantized() { return _quantized; }
+
+		/// Approximate bytes of the quantized data, 0 if the timeline is not quantized.
+		virtual size_t getQuantizedBytes() { return _quantizedCurves.size() * sizeof(unsigned short); }
+
 	protected:
 		static const int LINEAR = 0;
 		static const int STEPPED = 1;
@@ -62,6 +68,16 @@ namespace spine {
 		static const int BEZIER_SIZE = 18;
 
 		Vector<float> _curves; // type, x, y, ...
+		Vector<unsigned short> _quantizedCurves; // type, x, y, ...
+		float _curveOffset, _curveScale;
+		bool _quantized;
+
+		/// Moves _curves into _quantizedCurves. A frame's type is LINEAR, STEPPED or BEZIER + the bezier index. Sample x
+		/// is stored relative to the frame's time span, sample y relative to the range of all samples.
+		/// @param times The time of each frame.
+		bool quantizeCurves(Vector<float> &times);
+
+		float getQuantizedBezierValue(float time, size_t frame, float time1, float value1, float time2, float value2);
 	};
 
 	class SP_API CurveTimeline1 : public CurveTimeline {
@@ -84,9 +100,25 @@ namespace spine {
 
         float getScaleValue (float time, float alpha, MixBlend blend, MixDirection direction, float current, float setup);
 
+		/// Stores values and curves in 16 bits with a per timeline offset and scale, which halves the timeline's size.
+		/// Frame times stay floats in getFrames, which then holds one entry per frame. Frames can no longer be set.
+		/// @return false if the timeline has too many beziers to be quantized.
+		bool quantize();
+
+		float getQuantizedValue(size_t frame) { return _valueOffset + _quantizedValues[frame] * _valueScale; }
+
+		virtual size_t getQuantizedBytes() {
+			return CurveTimeline::getQuantizedBytes() + _quantizedValues.size() * sizeof(unsigned short);
+		}
+
 	protected:
 		static const int ENTRIES = 2;
 		static const int VALUE = 1;
+
+		Vector<unsigned short> _quantizedValues;
+		float _valueOffset, _valueScale;
+
+		float getQuantizedCurveValue(float time);
 	};
 
 	class SP_API CurveTimeline2 : public CurveTimeline {
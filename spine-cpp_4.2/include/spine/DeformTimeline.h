@@ -49,11 +49,35 @@ namespace spine {
 		apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 			  MixDirection direction);
 
-		/// Sets the time and value of the specified keyframe.
+		/// Sets the time and value of the specified keyframe. The vertices are all of the attachment's vertices, a sparse
+		/// timeline goes back to full keys.
 		void setFrame(int frameIndex, float time, Vector<float> &vertices);
 
+		/// Once the timeline is sparse each key holds only getRangeCount() values, starting at getRangeStart(). Empty once
+		/// the timeline is quantized.
 		Vector <Vector<float>> &getVertices();
 
+		/// Trims the keys to the range of vertices that differ from the setup vertices (or from zero for weighted offsets)
+		/// in any key. Outside the range every key is the setup pose, so apply only interpolates and blends the range.
+		/// The loaders call this for every deform timeline.
+		void sparsify();
+
+		bool isSparse() { return _sparse; }
+
+		size_t getRangeStart() { return _rangeStart; }
+
+		size_t getRangeCount() { return _rangeCount; }
+
+		/// Stores each key as 16 bit deltas from the setup vertices (or from zero for weighted offsets), covering only
+		/// the changed range, with a per key scale. Curves are quantized as for CurveTimeline1. Keys are decoded when
+		/// the timeline is applied and can no longer be set.
+		bool quantize();
+
+		/// Decodes all vertices of a key into out, which is returned. Works for every storage mode.
+		Vector<float> &getFrameVertices(size_t frame, Vector<float> &out);
+
+		virtual size_t getQuantizedBytes();
+
 		VertexAttachment *getAttachment();
 
 		void setAttachment(VertexAttachment *inValue);
@@ -69,11 +93,27 @@ namespace spine {
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
 	protected:
+		struct QuantizedFrame {
+			int offset;
+			int start;
+			int count;
+			float scale;
+		};
+
 		int _slotIndex;
 
 		Vector <Vector<float>> _vertices;
 
 		VertexAttachment *_attachment;
+
+		Vector<short> _quantizedVertices;
+		Vector<QuantizedFrame> _quantizedFrames;
+		bool _sparse;
+		size_t _vertexCount, _rangeStart, _rangeCount;
+		Vector<float> _prevVertices, _nextVertices;
+
+		/// Returns the key's values for the range, decoding quantized keys into out.
+		float *getFrameRange(size_t frame, Vector<float> &out);
 	};
 }
 
@@ -70,6 +70,11 @@ namespace spine {
 			return getInstance()->_readFile(path, length);
 		}
 
+		/// Reads length bytes starting at offset, used to decode lazily loaded data back from its file.
+		static char *readFile(const String &path, int offset, int length) {
+			return getInstance()->_readFile(path, offset, length);
+		}
+
 		static void setInstance(SpineExtension *inSpineExtension);
 
 		static SpineExtension *getInstance();
@@ -88,6 +93,9 @@ namespace spine {
 
 		virtual char *_readFile(const String &path, int *length) = 0;
 
+		/// Override to read a range without loading the whole file. The default reads the whole file and copies the range.
+		virtual char *_readFile(const String &path, int offset, int length);
+
 		virtual void _beforeFree(void *ptr) { SP_UNUSED(ptr); }
 
 	protected:
@@ -113,6 +121,8 @@ namespace spine {
 		virtual void _free(void *mem, const char *file, int line) override;
 
 		virtual char *_readFile(const String &path, int *length) override;
+
+		virtual char *_readFile(const String &path, int offset, int length) override;
 	};
 
 // This function is to be implemented by engine specific runtimes to provide
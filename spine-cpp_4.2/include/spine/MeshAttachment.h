@@ -53,13 +53,13 @@ namespace spine {
 
 		virtual ~MeshAttachment();
 
-		using VertexAttachment::computeWorldVertices;
-
-		virtual void computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
-		size_t stride = 2);
-
 		void updateRegion();
 
+		/// Computes the UVs of every sequence frame and sets the region to the setup frame. Called by the loaders, call again
+		/// after changing the region UVs or sequence regions. Rendering then selects a frame per slot without changing the
+		/// attachment.
+		void updateSequence();
+
 		int getHullLength();
 
 		void setHullLength(int inValue);
@@ -69,6 +69,14 @@ namespace spine {
 		/// The UV pair for each vertex, normalized within the entire texture. See also MeshAttachment::updateRegion
 		Vector<float> &getUVs();
 
+		/// The UVs to draw the attachment with for the slot: the slot's sequence frame, or getUVs() when there is no sequence.
+		/// The frames must have been computed by updateSequence.
+		float *getUVs(Slot &slot);
+
+		/// The region to draw the attachment with for the slot: the slot's sequence frame, or getRegion() when there is no
+		/// sequence.
+		TextureRegion *getRegion(Slot &slot);
+
 		Vector<unsigned short> &getTriangles();
 
 		Color &getColor();
@@ -105,6 +113,8 @@ namespace spine {
 		MeshAttachment *newLinkedMesh();
 
 	private:
+		void computeUVs(TextureRegion *region, float *uvs);
+
 		MeshAttachment *_parentMesh;
 		Vector<float> _uvs;
 		Vector<float> _regionUVs;
@@ -97,6 +97,13 @@ namespace spine {
 
         void setToSetupPose();
 
+		/// Number of curves whose lengths were measured in the last update. Curves of a constant speed path are only
+		/// measured again when the bones or deform that position them changed.
+		int getMeasuredCurves() { return _measuredCurves; }
+
+		/// Number of curves whose segment lengths were measured in the last update.
+		int getMeasuredSegments() { return _measuredSegments; }
+
 	private:
 		static const float EPSILON;
 		static const int NONE;
@@ -114,12 +121,33 @@ namespace spine {
 		Vector<float> _world;
 		Vector<float> _curves;
 		Vector<float> _lengths;
-		Vector<float> _segments;
+
+		/// The constant speed path _world was computed for, or NULL.
+		PathAttachment *_cachedPath;
+		Slot *_cachedTarget;
+		/// Indices of the bones that position the cached path's vertices.
+		Vector<int> _pathBones;
+		/// a, b, c, d, worldX and worldY of each _pathBones entry when _world was computed.
+		Vector<float> _pathBoneState;
+		Vector<float> _pathDeform;
+		Vector<float> _prevWorld;
+		/// The 4 length terms of each curve, summed in order so the cumulative _curves round as when computed directly.
+		Vector<float> _curveTerms;
+		/// Cumulative lengths of the 10 segments of each curve.
+		Vector<float> _curveSegments;
+		/// CURVE_DIRTY, CURVE_MEASURED or CURVE_SEGMENTS for each curve.
+		Vector<unsigned char> _curveStates;
+		float _pathLength;
+		int _measuredCurves;
+		int _measuredSegments;
 
 		bool _active;
 
 		Vector<float> &computeWorldPositions(PathAttachment &path, int spacesCount, bool tangents);
 
+		/// Records the bones and deform the path depends on, returning true if its world vertices may have changed.
+		bool updatePathState(PathAttachment &path);
+
 		static void addBeforePosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o);
 
 		static void addAfterPosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o);
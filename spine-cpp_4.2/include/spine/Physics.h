@@ -44,6 +44,16 @@ namespace spine {
         /** Physics are not updated but the pose from physics is applied. */
         Physics_Pose
     };
+
+    /** Determines how physics constraints catch up when more steps are due than Skeleton::getPhysicsMaxSteps allows. */
+    enum PhysicsSteps {
+        /** The steps over the maximum are dropped, so physics briefly runs slower than the skeleton time. */
+        PhysicsSteps_Drop,
+
+        /** The steps over the maximum are taken in the next updates, at most the maximum per update. Physics catches up with
+          * the skeleton time as long as updates usually need fewer steps than the maximum. */
+        PhysicsSteps_Defer
+    };
 }
 
 #endif
\ No newline at end of file
@@ -45,6 +45,8 @@ namespace spine {
 
         friend class Skeleton;
 
+        friend class SkeletonPose;
+
         friend class PhysicsConstraintTimeline;
 
         friend class PhysicsConstraintInertiaTimeline;
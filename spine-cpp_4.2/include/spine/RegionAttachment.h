@@ -60,6 +60,12 @@ namespace spine {
 
 		void updateRegion();
 
+		/// Computes the vertex offsets and UVs of every sequence frame and sets the region to the setup frame. Called by the
+		/// loaders, call again after changing the attachment's size, transform or sequence regions. Rendering and
+		/// computeWorldVertices then select a frame per slot without changing the attachment, so skeletons sharing it can be
+		/// updated in parallel.
+		void updateSequence();
+
 		/// Transforms the attachment's four vertices to world coordinates.
 		/// @param slot The parent slot.
 		/// @param worldVertices The output world vertices. Must have a length greater than or equal to offset + 8.
@@ -115,6 +121,14 @@ namespace spine {
 
 		Vector<float> &getUVs();
 
+		/// The UVs to draw the attachment with for the slot: the slot's sequence frame, or getUVs() when there is no sequence.
+		/// The frames must have been computed by updateSequence.
+		float *getUVs(Slot &slot);
+
+		/// The region to draw the attachment with for the slot: the slot's sequence frame, or getRegion() when there is no
+		/// sequence.
+		TextureRegion *getRegion(Slot &slot);
+
 		virtual Attachment *copy();
 
 	private:
@@ -127,6 +141,11 @@ namespace spine {
 		static const int BRX;
 		static const int BRY;
 
+		void computeRegion(TextureRegion *region, float *vertexOffset, float *uvs);
+
+		/// The slot's sequence frame: NUM_UVS vertex offsets, then NUM_UVS UVs.
+		float *getSequenceFrame(Slot &slot);
+
 		float _x, _y, _rotation, _scaleX, _scaleY, _width, _height;
 		Vector<float> _vertexOffset;
 		Vector<float> _uvs;
@@ -45,6 +45,8 @@ namespace spine {
 	class SP_API Sequence : public SpineObject {
 		friend class SkeletonBinary;
 		friend class SkeletonJson;
+		friend class RegionAttachment;
+		friend class MeshAttachment;
 	public:
 		Sequence(int count);
 
@@ -52,8 +54,21 @@ namespace spine {
 
 		Sequence *copy();
 
+		/// Sets the attachment's region to the slot's frame and recomputes its UVs. This changes the attachment for every
+		/// skeleton using it, the runtime instead selects precomputed frames, see RegionAttachment::updateSequence.
 		void apply(Slot *slot, Attachment *attachment);
 
+		/// Returns the frame for a slot sequence index, which is -1 for the setup index, clamped to the last frame.
+		int getFrameIndex(int sequenceIndex) {
+			int index = sequenceIndex == -1 ? _setupIndex : sequenceIndex;
+			return index >= (int) _regions.size() ? (int) _regions.size() - 1 : index;
+		}
+
+		/// The precomputed data of a frame, laid out by the attachment owning the sequence.
+		float *getFrame(int index) { return _frames.buffer() + index * _frameStride; }
+
+		bool hasFrames() { return _frames.size() != 0; }
+
 		String getPath(const String &basePath, int index);
 
 		int getId() { return _id; }
@@ -80,6 +95,9 @@ namespace spine {
 		int _start;
 		int _digits;
 		int _setupIndex;
+		/// The vertex offsets and UVs of each frame, _frameStride floats per frame.
+		Vector<float> _frames;
+		size_t _frameStride;
 
 		int getNextID();
 	};
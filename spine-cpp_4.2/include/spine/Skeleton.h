@@ -67,6 +67,8 @@ namespace spine {
 
 		friend class SkeletonClipping;
 
+		friend class SkeletonPose;
+
 		friend class AttachmentTimeline;
 
 		friend class RGBATimeline;
@@ -123,7 +125,7 @@ namespace spine {
 		~Skeleton();
 
 		/// Caches information about bones and constraints. Must be called if bones, constraints or weighted path attachments are added
-		/// or removed.
+		/// or removed. Also discards the update caches setSkin kept for previously used skins.
 		void updateCache();
 
 		void printUpdateCache();
@@ -199,6 +201,8 @@ namespace spine {
 
 		Vector<Bone *> &getBones();
 
+		/// Entries are dispatched by the type recorded in updateCache. Replacing entries without changing the count
+		/// requires calling updateCache again.
 		Vector<Updatable *> &getUpdateCacheList();
 
 		Vector<Slot *> &getSlots();
@@ -248,7 +252,29 @@ namespace spine {
         /// Calls {@link PhysicsConstraint#rotate(float, float, float)} for each physics constraint. */
         void physicsRotate(float x, float y, float degrees);
 
+        /// Limits the steps each physics constraint takes in one update, so a long frame does not make the next frames late
+        /// too. Time over the limit is handled by the policy.
+        /// @param maxSteps 0 for no limit, the default.
+        void setPhysicsMaxSteps(int maxSteps, PhysicsSteps policy = PhysicsSteps_Drop);
+
+        int getPhysicsMaxSteps() { return _physicsMaxSteps; }
+
+        PhysicsSteps getPhysicsSteps() { return _physicsSteps; }
+
 	private:
+		/// The update cache and active states computed for a skin, restored by setSkin instead of sorting again.
+		class SkinUpdateCache : public SpineObject {
+		public:
+			Skin *_skin;
+			int _revision;
+			Vector<Updatable *> _updateCache;
+			Vector<unsigned char> _updateCacheTypes;
+			/// Bones, then IK, transform, path and physics constraints.
+			Vector<bool> _active;
+			/// The path attachment on each path constraint's target slot when sorted, or NULL.
+			Vector<Attachment *> _pathAttachments;
+		};
+
 		SkeletonData *_data;
 		Vector<Bone *> _bones;
 		Vector<Slot *> _slots;
@@ -258,11 +284,21 @@ namespace spine {
 		Vector<PathConstraint *> _pathConstraints;
         Vector<PhysicsConstraint *> _physicsConstraints;
 		Vector<Updatable *> _updateCache;
+		/// Type of each _updateCache entry, so updateWorldTransform can call update without virtual dispatch.
+		Vector<unsigned char> _updateCacheTypes;
+		/// The bones, allocated in one block in data order so world transform updates walk contiguous memory.
+		Bone *_boneBlock;
+		/// Update caches of the most recently used skins, most recent last. A single entry keyed by NULL when no bone or
+		/// constraint is skin required, since the order is then the same for every skin.
+		Vector<SkinUpdateCache *> _skinUpdateCaches;
+		bool _skinRequired;
 		Skin *_skin;
 		Color _color;
 		float _scaleX, _scaleY;
 		float _x, _y;
         float _time;
+		int _physicsMaxSteps;
+		PhysicsSteps _physicsSteps;
 
 		void sortIkConstraint(IkConstraint *constraint);
 
@@ -279,6 +315,18 @@ namespace spine {
 		void sortBone(Bone *bone);
 
 		static void sortReset(Vector<Bone *> &bones);
+
+		void updateCacheTypes();
+
+		void sortUpdateCache();
+
+		void storeUpdateCache();
+
+		bool restoreUpdateCache();
+
+		Attachment *getPathAttachment(PathConstraint *constraint);
+
+		void update(Updatable *updatable, unsigned char type, Physics physics);
 	};
 }
 
@@ -31,6 +31,7 @@
 #define Spine_SkeletonBinary_h
 
 #include <spine/Inherit.h>
+#include <spine/Property.h>
 #include <spine/Vector.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
@@ -64,7 +65,18 @@ namespace spine {
 	class Sequence;
 
 	class SP_API SkeletonBinary : public SpineObject {
+		friend class AnimationCache;
+
 	public:
+		/// What the skin and animation filters left out during the last read.
+		struct StripReport {
+			int skins;
+			int attachments;
+			int animations;
+			/// Approximate heap bytes the stripped data would have used.
+			size_t bytes;
+		};
+
 		static const int BONE_ROTATE = 0;
 		static const int BONE_TRANSLATE = 1;
 		static const int BONE_TRANSLATEX = 2;
@@ -116,6 +128,29 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// When enabled, animations are only parsed past at load and their timelines are decoded on first use by the
+		/// SkeletonData's AnimationCache. readSkeletonData keeps referencing the binary, so it must outlive the
+		/// SkeletonData; readSkeletonDataFile reads the animations back from the file instead.
+		void setLazyAnimations(bool lazy) { _lazyAnimations = lazy; }
+
+		/// Once a skin is added, only the default skin and the added skins are read. Other skins are parsed past
+		/// without creating their attachments, and their attachment timelines are dropped.
+		void addRequiredSkin(const String &name) { _requiredSkins.add(name); }
+
+		/// Once an animation is added, only the added animations are kept. Other animations are parsed past without
+		/// creating their timelines.
+		void addRequiredAnimation(const String &name) { _requiredAnimations.add(name); }
+
+		/// Also removes attachments of the default skin and the kept skins that are not reachable from the setup pose
+		/// or the kept animations. Attachments only set by name from code are removed too, so this is opt-in.
+		void setStripUnreachable(bool strip) { _stripUnreachable = strip; }
+
+		StripReport &getStripReport() { return _stripReport; }
+
+		/// Stores single value and deform timelines in 16 bits, see CurveTimeline1::quantize and
+		/// DeformTimeline::quantize. Values are within 1/65535 of each timeline's range of the float data.
+		void setQuantizeAnimations(bool quantize) { _quantizeAnimations = quantize; }
+
 		String &getError() { return _error; }
 
 	private:
@@ -129,12 +164,27 @@ namespace spine {
 		String _error;
 		float _scale;
 		const bool _ownsLoader;
+		bool _lazyAnimations;
+		Vector<String> _requiredSkins;
+		Vector<String> _requiredAnimations;
+		bool _stripUnreachable;
+		StripReport _stripReport;
+		Vector<Skin *> *_skinTable;
+		bool _quantizeAnimations;
+
+		/// Reader for animations only, used by AnimationCache.
+		explicit SkeletonBinary(float scale);
 
 		void setError(const char *value1, const char *value2);
 
 		char *readString(DataInput *input);
 
-		char *readStringRef(DataInput *input, SkeletonData *skeletonData);
+		/// Reads a string into the skeleton data's names, without allocating it.
+		const char *readAtom(DataInput *input, SkeletonData *skeletonData);
+
+		String readName(DataInput *input, SkeletonData *skeletonData);
+
+		String readStringRef(DataInput *input, SkeletonData *skeletonData);
 
 		float readFloat(DataInput *input);
 
@@ -152,6 +202,40 @@ namespace spine {
 
 		Skin *readSkin(DataInput *input, bool defaultSkin, SkeletonData *skeletonData, bool nonessential);
 
+		bool isSkinRequired(DataInput *input);
+
+		void skipSkin(DataInput *input, bool nonessential);
+
+		void skipAttachment(DataInput *input, bool nonessential);
+
+		int skipVertices(DataInput *input, bool weighted);
+
+		/// Adds the approximate bytes the timeline would use to bytes.
+		/// @return The time of the last frame.
+		float skipAttachmentTimeline(DataInput *input, unsigned int timelineType, int frameCount, size_t &bytes);
+
+		/// @return The time of the last frame.
+		float skipCurveFrames(DataInput *input, int frameCount, int valueBytes, int curves);
+
+		static void addTimelineId(Animation *animation, PropertyId id);
+
+		/// Parses past an animation without creating its timelines. When animation is not NULL, its duration and
+		/// timeline ids are set as readAnimation sets them. When names is not NULL, the attachments the timelines key
+		/// are collected like markReachable does.
+		/// @return The approximate bytes its timelines would use, or -1 on invalid data.
+		int skipAnimation(DataInput *input, SkeletonData *skeletonData, Animation *animation,
+						  Vector<Vector<String> > *names, Vector<Attachment *> *attachments);
+
+		void markReachable(Animation *animation, Vector<Vector<String> > &names, Vector<Attachment *> &attachments);
+
+		void stripUnreachable(SkeletonData *skeletonData, Vector<Vector<String> > &names, Vector<Attachment *> &attachments);
+
+		static size_t getAttachmentBytes(Attachment *attachment);
+
+		static size_t getTimelineBytes(int frameCount, int frameEntries);
+
+		static size_t getCurveTimelineBytes(int frameCount, int frameEntries, int bezierCount);
+
 		Sequence *readSequence(DataInput *input);
 
 		Attachment *readAttachment(DataInput *input, Skin *skin, int slotIndex, const String &attachmentName,
@@ -42,6 +42,8 @@ namespace spine {
 	public:
 		SkeletonClipping();
 
+		~SkeletonClipping();
+
 		size_t clipStart(Slot &slot, ClippingAttachment *clip);
 
 		void clipEnd(Slot &slot);
@@ -75,6 +77,9 @@ namespace spine {
 		Vector<float> _scratch;
 		ClippingAttachment *_clipAttachment;
 		Vector<Vector<float> *> *_clippingPolygons;
+		/// World space copies of a clipping attachment's cached convex polygons, owned by _worldPolygonPool.
+		Vector<Vector<float> *> _worldPolygons;
+		Vector<Vector<float> *> _worldPolygonPool;
 
 		/** Clips the input triangle against the convex, clockwise clipping area. If the triangle lies entirely within the clipping
 		  * area, false is returned. The clipping area must duplicate the first vertex at the end of the vertices list. */
@@ -82,6 +87,12 @@ namespace spine {
 				  Vector<float> *output);
 
 		static void makeClockwise(Vector<float> &polygon);
+
+		/// Decomposes the polygon into clockwise convex polygons, each closed by repeating its first vertex.
+		Vector<Vector<float> *> &decompose(Vector<float> &polygon);
+
+		/// Returns the attachment's cached bone space decomposition, decomposing its vertices if they changed.
+		Vector<Vector<float> *> &getConvexPolygons(ClippingAttachment *clip);
 	};
 }
 
@@ -32,6 +32,7 @@
 
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
+#include <spine/StringPool.h>
 
 namespace spine {
 	class BoneData;
@@ -52,6 +53,8 @@ namespace spine {
 
     class PhysicsConstraintData;
 
+	class AnimationCache;
+
 /// Stores the setup pose and all of the stateless data for a skeleton.
 	class SP_API SkeletonData : public SpineObject {
 		friend class SkeletonBinary;
@@ -65,7 +68,8 @@ namespace spine {
 
 		~SkeletonData();
 
-		/// Finds a bone by comparing each bone's name.
+		/// Finds a bone by comparing each bone's name. Names read by SkeletonBinary and SkeletonJson are interned in
+		/// getNames, so each comparison is a pointer or hash comparison.
 		/// It is more efficient to cache the results of this method than to call it multiple times.
 		/// @return May be NULL.
 		BoneData *findBone(const String &boneName);
@@ -117,6 +121,10 @@ namespace spine {
 
 		Vector<Animation *> &getAnimations();
 
+		/// Decodes and releases animation timelines when read with SkeletonBinary::setLazyAnimations.
+		/// @return May be NULL.
+		AnimationCache *getAnimationCache();
+
 		Vector<IkConstraintData *> &getIkConstraints();
 
 		Vector<TransformConstraintData *> &getTransformConstraints();
@@ -167,6 +175,10 @@ namespace spine {
 
 		void setFps(float inValue);
 
+		/// Holds the names of bones, slots, constraints, skins, attachments, events and animations read by
+		/// SkeletonBinary and SkeletonJson, once each. Strings sharing these names stay valid as long as this data.
+		StringPool &getNames();
+
 	private:
 		String _name;
 		Vector<BoneData *> _bones; // Ordered parents first
@@ -183,7 +195,9 @@ namespace spine {
         float _referenceScale;
 		String _version;
 		String _hash;
-		Vector<char *> _strings;
+		StringPool _names;
+		Vector<char *> _strings; // Atoms of _names.
+		AnimationCache *_animationCache;
 
 		// Nonessential.
 		float _fps;
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_SkeletonPose_h
+#define Spine_SkeletonPose_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Skeleton;
+
+	class SkeletonData;
+
+	class Attachment;
+
+	class Skin;
+
+	/// A snapshot of everything an animation or physics step changes on a skeleton: the skin, bone local and world
+	/// transforms, slot colors, attachments, sequence indices and deform, draw order, constraint mixes and physics state. Capture and restore
+	/// copy flat arrays and reuse their storage, so poses can be kept for rollback or as cached keyframes.
+	class SP_API SkeletonPose : public SpineObject {
+	public:
+		SkeletonPose();
+
+		~SkeletonPose();
+
+		/// Stores the skeleton's current pose, reusing the storage of a previous capture.
+		void capture(Skeleton &skeleton);
+
+		/// Poses the skeleton as it was when captured, including world transforms, so it can be drawn without calling
+		/// Skeleton::updateWorldTransform.
+		/// @return False if nothing was captured or the skeleton does not have the SkeletonData of the captured skeleton.
+		bool restore(Skeleton &skeleton);
+
+		/// The skeleton data of the captured skeleton, or NULL.
+		SkeletonData *getData() { return _data; }
+
+		/// The number of bytes used by the captured pose.
+		size_t getBytes();
+
+	private:
+		SkeletonData *_data;
+		Skin *_skin;
+		size_t _boneCount, _slotCount, _ikCount, _transformCount, _pathCount, _physicsCount;
+		Vector<float> _floats;
+		Vector<int> _ints;
+		Vector<Attachment *> _attachments;
+	};
+}
+
+#endif /* Spine_SkeletonPose_h */
@@ -150,21 +150,53 @@ namespace spine {
 
 		AttachmentMap::Entries getAttachments();
 
+		/// Call Skeleton::updateCache after changing the returned bones directly.
 		Vector<BoneData *> &getBones();
 
+		/// Call Skeleton::updateCache after changing the returned constraints directly.
 		Vector<ConstraintData *> &getConstraints();
 
+		/// Changes whenever attachments, bones or constraints are added or removed through this skin's methods. Unique
+		/// across all skins, so a cache keyed by a deleted skin never matches a new skin allocated at the same address.
+		int getRevision() { return _revision; }
+
         Color &getColor() { return _color; }
 
 	private:
+		/// The attachments attachAll swaps in when switching from another skin to this one, in attachAll's order.
+		class SkinTransition : public SpineObject {
+		public:
+			Skin *_from;
+			int _fromRevision;
+			int _toRevision;
+			Vector<size_t> _slots;
+			Vector<Attachment *> _fromAttachments;
+			Vector<Attachment *> _toAttachments;
+		};
+
 		const String _name;
 		AttachmentMap _attachments;
 		Vector<BoneData *> _bones;
 		Vector<ConstraintData *> _constraints;
         Color _color;
+		int _revision;
+		/// Transitions from the most recently used old skins, most recent last.
+		Vector<SkinTransition *> _transitions;
+
+		static int _nextRevision;
 
 		/// Attach all attachments from this skin if the corresponding attachment from the old skin is currently attached.
 		void attachAll(Skeleton &skeleton, Skin &oldSkin);
+
+		SkinTransition *getTransition(Skin &oldSkin);
+
+		void changed();
+	};
+
+	// entries hold a String and pointers, see IsRelocatable
+	template<>
+	struct IsRelocatable<Skin::AttachmentMap::Entry> {
+		static const bool value = true;
 	};
 }
 
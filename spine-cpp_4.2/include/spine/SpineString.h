@@ -37,132 +37,97 @@
 #include <stdio.h>
 
 namespace spine {
+	class StringPool;
+
+	/// Strings short enough to fit in place of the pointer and length, up to 10 characters on 32 bit targets, are
+	/// stored inside the String without a heap allocation.
 	class SP_API String : public SpineObject {
+		friend class StringPool;
+
 	public:
-		String() : _length(0), _buffer(NULL), _tempowner(true) {
+		String() {
+			setEmpty();
 		}
 
+		/// Copies chars, unless own is set, then the String keeps chars and frees it when tofree is set.
 		String(const char *chars, bool own = false, bool tofree = true) {
-			_tempowner = tofree;
-			if (!chars) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
-				_length = strlen(chars);
-				if (!own) {
-					_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
-					memcpy((void *) _buffer, chars, _length + 1);
-				} else {
-					_buffer = (char *) chars;
-				}
-			}
+			if (!chars)
+				setEmpty();
+			else if (!own)
+				assign(chars, strlen(chars));
+			else
+				setPointer((char *) chars, strlen(chars), tofree ? Storage_Heap : Storage_Borrowed);
 		}
 
+		/// Copies other, names interned in a StringPool are shared instead.
 		String(const String &other) {
-			_tempowner = true;
-			if (!other._buffer) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
-				_length = other._length;
-				_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, other._buffer, other._length + 1);
-			}
+			assign(other);
+		}
+
+		String(String &&other) {
+			take(other);
 		}
 
 		size_t length() const {
-			return _length;
+			return storage() == Storage_Inline ? (size_t) (flags() >> 2) : _heap.length;
 		}
 
 		bool isEmpty() const {
-			return _length == 0;
+			return length() == 0;
 		}
 
 		const char *buffer() const {
-			return _buffer;
+			return storage() == Storage_Inline ? _inline : _heap.buffer;
 		}
 
 		void own(const String &other) {
 			if (this == &other) return;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
-			_length = other._length;
-			_buffer = other._buffer;
-			other._length = 0;
-			other._buffer = NULL;
+			release();
+			take(other);
 		}
 
 		void own(const char *chars) {
-			if (_buffer == chars) return;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
-
-			if (!chars) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
-				_length = strlen(chars);
-				_buffer = (char *) chars;
-			}
+			if (buffer() == chars) return;
+			release();
+			if (!chars)
+				setEmpty();
+			else
+				setPointer((char *) chars, strlen(chars), Storage_Heap);
 		}
 
 		void unown() {
-			_length = 0;
-			_buffer = NULL;
+			setEmpty();
 		}
 
 		String &operator=(const String &other) {
 			if (this == &other) return *this;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
-			if (!other._buffer) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
-				_length = other._length;
-				_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, other._buffer, other._length + 1);
-			}
+			release();
+			assign(other);
+			return *this;
+		}
+
+		String &operator=(String &&other) {
+			if (this == &other) return *this;
+			release();
+			take(other);
 			return *this;
 		}
 
 		String &operator=(const char *chars) {
-			if (_buffer == chars) return *this;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
-			if (!chars) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
-				_length = strlen(chars);
-				_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, chars, _length + 1);
-			}
+			if (buffer() == chars) return *this;
+			// chars may point into this string
+			String copy(chars);
+			release();
+			take(copy);
 			return *this;
 		}
 
 		String &append(const char *chars) {
-			size_t len = strlen(chars);
-			size_t thisLen = _length;
-			_length = _length + len;
-			bool same = chars == _buffer;
-			_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
-			memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : chars), len + 1);
-			return *this;
+			return append(chars, strlen(chars));
 		}
 
 		String &append(const String &other) {
-			size_t len = other.length();
-			size_t thisLen = _length;
-			_length = _length + len;
-			bool same = other._buffer == _buffer;
-			_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
-			memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : other._buffer), len + 1);
-			return *this;
+			return append(other.buffer(), other.length());
 		}
 
 		String &append(int other) {
@@ -195,34 +160,32 @@ namespace spine {
         }
 
         String substring(int startIndex, int length) const {
-            if (startIndex < 0 || startIndex >= (int)_length || length < 0 || startIndex + length > (int)_length) {
+            if (startIndex < 0 || startIndex >= (int)this->length() || length < 0 || startIndex + length > (int)this->length()) {
                 return String();
             }
-            char* subStr = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
-            memcpy(subStr, _buffer + startIndex, length);
-            subStr[length] = '\0';
-            return String(subStr, true, true);
+            String subStr;
+            subStr.assign(buffer() + startIndex, length);
+            return subStr;
         }
 
         String substring(int startIndex) const {
-            if (startIndex < 0 || startIndex >= (int)_length) {
+            if (startIndex < 0 || startIndex >= (int)length()) {
                 return String();
             }
-            int length = (int)_length - startIndex;
-            char* subStr = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
-            memcpy(subStr, _buffer + startIndex, length);
-            subStr[length] = '\0';
-            return String(subStr, true, true);
+            String subStr;
+            subStr.assign(buffer() + startIndex, length() - startIndex);
+            return subStr;
         }
 
 		friend bool operator==(const String &a, const String &b) {
-			if (a._buffer == b._buffer) return true;
-			if (a._length != b._length) return false;
-			if (a._buffer && b._buffer) {
-				return strcmp(a._buffer, b._buffer) == 0;
-			} else {
-				return false;
-			}
+			const char *aBuffer = a.buffer(), *bBuffer = b.buffer();
+			if (aBuffer == bBuffer) return true;
+			size_t length = a.length();
+			if (length != b.length()) return false;
+			if (!aBuffer || !bBuffer) return false;
+			// equal atoms of one pool share their buffer, atoms with different hashes differ
+			if (a.storage() == Storage_Atom && b.storage() == Storage_Atom && atomHash(aBuffer) != atomHash(bBuffer)) return false;
+			return memcmp(aBuffer, bBuffer, length) == 0;
 		}
 
 		friend bool operator!=(const String &a, const String &b) {
@@ -230,15 +193,116 @@ namespace spine {
 		}
 
 		~String() {
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
+			release();
 		}
 
 	private:
-		mutable size_t _length;
-		mutable char *_buffer;
-		mutable bool _tempowner;
+		enum {
+			// _heap.buffer is allocated and freed with the String
+			Storage_Heap,
+			// the characters are in _inline, their count in the upper bits of the flags
+			Storage_Inline,
+			// _heap.buffer belongs to someone else, copies copy it
+			Storage_Borrowed,
+			// _heap.buffer is an atom of a StringPool, copies share it
+			Storage_Atom
+		};
+
+		// the last byte of _inline, past _heap: the storage and the length of inline characters
+		static const size_t FlagsIndex = sizeof(size_t) + sizeof(char *) + sizeof(void *) - 1;
+
+		// leaves room for the terminating zero and the flags
+		static const size_t InlineLength = FlagsIndex - 1;
+
+		// a StringPool keeps the hash of each atom in front of its characters
+		static unsigned int atomHash(const char *atom) {
+			unsigned int hash;
+			memcpy(&hash, atom - sizeof(hash), sizeof(hash));
+			return hash;
+		}
+
+		unsigned char flags() const {
+			return (unsigned char) _inline[FlagsIndex];
+		}
+
+		int storage() const {
+			return flags() & 3;
+		}
+
+		void setEmpty() const {
+			setPointer(NULL, 0, Storage_Heap);
+		}
+
+		void setPointer(char *buffer, size_t length, int storage) const {
+			_heap.length = length;
+			_heap.buffer = buffer;
+			_inline[FlagsIndex] = (char) storage;
+		}
+
+		void release() {
+			if (storage() == Storage_Heap && _heap.buffer) {
+				SpineExtension::free(_heap.buffer, __FILE__, __LINE__);
+			}
+		}
+
+		void assign(const char *chars, size_t length) {
+			if (length <= InlineLength) {
+				memmove(_inline, chars, length);
+				_inline[length] = '\0';
+				_inline[FlagsIndex] = (char) (Storage_Inline | (length << 2));
+			} else {
+				char *buffer = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+				memcpy(buffer, chars, length);
+				buffer[length] = '\0';
+				setPointer(buffer, length, Storage_Heap);
+			}
+		}
+
+		void assign(const String &other) {
+			if (other.storage() == Storage_Atom)
+				setPointer(other._heap.buffer, other._heap.length, Storage_Atom);
+			else if (!other.buffer())
+				setEmpty();
+			else
+				assign(other.buffer(), other.length());
+		}
+
+		void take(const String &other) {
+			memcpy(_inline, other._inline, sizeof(_inline));
+			other.setEmpty();
+		}
+
+		String &append(const char *chars, size_t length) {
+			size_t thisLength = this->length(), newLength = thisLength + length;
+			int thisStorage = storage();
+			if (newLength <= InlineLength && (thisStorage == Storage_Inline || !_heap.buffer)) {
+				// chars may be the inline characters themselves
+				memmove(_inline + thisLength, chars, length);
+				_inline[newLength] = '\0';
+				_inline[FlagsIndex] = (char) (Storage_Inline | (newLength << 2));
+			} else if (thisStorage == Storage_Heap && _heap.buffer) {
+				bool same = chars == _heap.buffer;
+				char *buffer = SpineExtension::realloc(_heap.buffer, newLength + 1, __FILE__, __LINE__);
+				memcpy(buffer + thisLength, same ? buffer : chars, length);
+				buffer[newLength] = '\0';
+				setPointer(buffer, newLength, Storage_Heap);
+			} else {
+				char *buffer = SpineExtension::alloc<char>(newLength + 1, __FILE__, __LINE__);
+				if (thisLength) memcpy(buffer, this->buffer(), thisLength);
+				memcpy(buffer + thisLength, chars, length);
+				buffer[newLength] = '\0';
+				setPointer(buffer, newLength, Storage_Heap);
+			}
+			return *this;
+		}
+
+		union {
+			mutable struct {
+				size_t length;
+				char *buffer;
+			} _heap;
+			mutable char _inline[FlagsIndex + 1];
+		};
 	};
 }
 
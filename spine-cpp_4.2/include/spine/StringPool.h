@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_StringPool_h
+#define Spine_StringPool_h
+
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+
+namespace spine {
+	/// Interns names: keeps one copy of each distinct string, packed into large blocks instead of one allocation
+	/// per string. A String made by atom shares the pool's copy, copies of it share it too and compare with other
+	/// atoms by pointer and hash. Such Strings must not outlive the pool. The SkeletonData owns the pool its
+	/// names are interned in, see SkeletonData::getNames.
+	class SP_API StringPool : public SpineObject {
+	public:
+		StringPool();
+
+		~StringPool();
+
+		/// The pool's copy of the length characters at chars, which need no terminating zero. Added if the pool
+		/// doesn't hold them yet. Valid until the pool is destroyed.
+		const char *intern(const char *chars, size_t length);
+
+		const char *intern(const char *chars);
+
+		/// A String sharing the pool's copy of chars, empty for NULL.
+		String atom(const char *chars, size_t length);
+
+		String atom(const char *chars);
+
+		String atom(const String &name);
+
+		/// A String sharing atom, which intern returned.
+		static String share(const char *atom);
+
+		/// The pool's atom equal to name if there is one, else name borrowed, valid as long as name. Looking either
+		/// up in a list of names interned here costs a pointer or hash comparison per name instead of a string
+		/// comparison.
+		String lookup(const String &name) const;
+
+		String lookup(const char *chars) const;
+
+		/// Number of distinct strings.
+		size_t getCount();
+
+		/// Bytes allocated for the strings and the table finding them.
+		size_t getBytes();
+
+	private:
+		struct Block {
+			Block *next;
+			size_t used;
+			size_t capacity;
+		};
+
+		StringPool(const StringPool &);
+
+		StringPool &operator=(const StringPool &);
+
+		static unsigned int hash(const char *chars, size_t length);
+
+		const char *find(const char *chars, size_t length, unsigned int hash) const;
+
+		char *allocate(size_t size);
+
+		void grow();
+
+		Block *_blocks;
+		const char **_table;
+		size_t _tableSize;
+		size_t _count;
+		size_t _bytes;
+	};
+}
+
+#endif /* Spine_StringPool_h */
@@ -31,6 +31,7 @@
 #define SPINE_SPINE_H_
 
 #include <spine/Animation.h>
+#include <spine/AnimationCache.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
 #include <spine/Atlas.h>
@@ -93,6 +94,7 @@
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SkeletonPose.h>
 #include <spine/SkeletonRenderer.h>
 #include <spine/Skin.h>
 #include <spine/Slot.h>
@@ -100,6 +102,7 @@
 #include <spine/SpacingMode.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
+#include <spine/StringPool.h>
 #include <spine/TextureLoader.h>
 #include <spine/Timeline.h>
 #include <spine/TransformConstraint.h>
@@ -28,6 +28,7 @@
  *****************************************************************************/
 
 #include <spine/Animation.h>
+#include <spine/AnimationCache.h>
 #include <spine/Event.h>
 #include <spine/Skeleton.h>
 #include <spine/Timeline.h>
@@ -41,7 +42,14 @@ using namespace spine;
 Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) : _timelines(timelines),
 																						  _timelineIds(),
 																						  _duration(duration),
-																						  _name(name) {
+																						  _name(name),
+																						  _cache(NULL),
+																						  _binaryOffset(0),
+																						  _binaryLength(0),
+																						  _loadedBytes(0),
+																						  _lastUsed(0),
+																						  _references(0),
+																						  _loaded(true) {
 	assert(_name.length() > 0);
 	for (size_t i = 0; i < timelines.size(); i++) {
 		Vector<PropertyId> propertyIds = timelines[i]->getPropertyIds();
@@ -63,6 +71,8 @@ Animation::~Animation() {
 
 void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
 					  MixBlend blend, MixDirection direction) {
+	if (_cache) _cache->use(*this);
+
 	if (loop && _duration != 0) {
 		time = MathUtil::fmod(time, _duration);
 		if (lastTime > 0) {
@@ -80,6 +90,7 @@ const String &Animation::getName() {
 }
 
 Vector<Timeline *> &Animation::getTimelines() {
+	if (_cache) _cache->use(*this);
 	return _timelines;
 }
 
@@ -91,6 +102,10 @@ void Animation::setDuration(float inValue) {
 	_duration = inValue;
 }
 
+bool Animation::isLoaded() {
+	return _loaded;
+}
+
 int Animation::search(Vector<float> &frames, float target) {
 	size_t n = (int) frames.size();
 	for (size_t i = 1; i < n; i++) {
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/AnimationCache.h>
+
+#include <spine/ContainerUtil.h>
+#include <spine/CurveTimeline.h>
+#include <spine/DeformTimeline.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonData.h>
+#include <spine/Timeline.h>
+
+using namespace spine;
+
+AnimationCache::AnimationCache(SkeletonData &skeletonData, const unsigned char *binary, int length, float scale)
+	: _skeletonData(skeletonData),
+	  _binary(binary),
+	  _length(length),
+	  _path(),
+	  _scale(scale),
+	  _budget(0),
+	  _loadedBytes(0),
+	  _clock(0),
+	  _loadCount(0),
+	  _quantize(false) {
+}
+
+AnimationCache::~AnimationCache() {
+}
+
+void AnimationCache::setPath(const String &path) {
+	_path = path;
+	_binary = NULL;
+}
+
+void AnimationCache::setBudget(size_t inValue) {
+	_budget = inValue;
+	trim(NULL);
+}
+
+size_t AnimationCache::getBudget() {
+	return _budget;
+}
+
+size_t AnimationCache::getLoadedBytes() {
+	return _loadedBytes;
+}
+
+int AnimationCache::getLoadCount() {
+	return _loadCount;
+}
+
+bool AnimationCache::load(Animation &animation) {
+	if (animation._loaded) return true;
+
+	const unsigned char *binary;
+	char *buffer = NULL;
+	if (_binary) {
+		if ((int) (animation._binaryOffset + animation._binaryLength) > _length) return false;
+		binary = _binary + animation._binaryOffset;
+	} else {
+		buffer = SpineExtension::readFile(_path, (int) animation._binaryOffset, (int) animation._binaryLength);
+		if (!buffer) return false;
+		binary = (const unsigned char *) buffer;
+	}
+
+	SkeletonBinary reader(_scale);
+	if (_skins.size() > 0) reader._skinTable = &_skins;
+	reader._quantizeAnimations = _quantize;
+	SkeletonBinary::DataInput input;
+	input.cursor = binary;
+	input.end = binary + animation._binaryLength;
+	Animation *decoded = reader.readAnimation(animation._name, &input, &_skeletonData);
+	if (buffer) SpineExtension::free(buffer, __FILE__, __LINE__);
+	if (!decoded) return false;
+
+	animation._timelines.clearAndAddAll(decoded->_timelines);
+	decoded->_timelines.clear();
+	delete decoded;
+
+	animation._loaded = true;
+	animation._loadedBytes = getTimelinesBytes(animation._timelines);
+	animation._lastUsed = ++_clock;
+	_loadedBytes += animation._loadedBytes;
+	_loadCount++;
+	trim(&animation);
+	return true;
+}
+
+void AnimationCache::unload(Animation &animation) {
+	if (!animation._loaded || animation._references > 0) return;
+	ContainerUtil::cleanUpVectorOfPointers(animation._timelines);
+	_loadedBytes -= animation._loadedBytes;
+	animation._loadedBytes = 0;
+	animation._loaded = false;
+}
+
+void AnimationCache::trim() {
+	trim(NULL);
+}
+
+void AnimationCache::trim(Animation *keep) {
+	Vector<Animation *> &animations = _skeletonData.getAnimations();
+	while (_budget > 0 && _loadedBytes > _budget) {
+		Animation *oldest = NULL;
+		for (size_t i = 0, n = animations.size(); i < n; ++i) {
+			Animation *animation = animations[i];
+			if (animation == keep || animation->_cache != this || !animation->_loaded || animation->_references > 0)
+				continue;
+			if (!oldest || animation->_lastUsed < oldest->_lastUsed) oldest = animation;
+		}
+		if (!oldest) break;
+		unload(*oldest);
+	}
+}
+
+void AnimationCache::retain(Animation &animation) {
+	animation._references++;
+	use(animation);
+}
+
+void AnimationCache::release(Animation &animation) {
+	if (animation._references > 0) animation._references--;
+	if (animation._references == 0) trim(NULL);
+}
+
+void AnimationCache::add(Animation &animation, size_t offset, size_t length) {
+	animation._cache = this;
+	animation._binaryOffset = offset;
+	animation._binaryLength = length;
+	ContainerUtil::cleanUpVectorOfPointers(animation._timelines);
+	animation._loadedBytes = 0;
+	animation._loaded = false;
+}
+
+size_t AnimationCache::getTimelinesBytes(Vector<Timeline *> &timelines) {
+	size_t bytes = 0;
+	for (size_t i = 0, n = timelines.size(); i < n; ++i) {
+		Timeline *timeline = timelines[i];
+		bytes += sizeof(Timeline) + timeline->getFrames().size() * sizeof(float);
+		if (timeline->getRTTI().instanceOf(CurveTimeline::rtti)) {
+			CurveTimeline *curveTimeline = static_cast<CurveTimeline *>(timeline);
+			bytes += curveTimeline->getCurves().size() * sizeof(float) + curveTimeline->getQuantizedBytes();
+		}
+		if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+			Vector<Vector<float> > &vertices = static_cast<DeformTimeline *>(timeline)->getVertices();
+			for (size_t ii = 0, nn = vertices.size(); ii < nn; ++ii)
+				bytes += sizeof(Vector<float>) + vertices[ii].size() * sizeof(float);
+		}
+	}
+	return bytes;
+}
@@ -29,23 +29,125 @@
 
 #include <spine/AnimationState.h>
 #include <spine/Animation.h>
+#include <spine/AnimationCache.h>
 #include <spine/AnimationStateData.h>
 #include <spine/AttachmentTimeline.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/ColorTimeline.h>
+#include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
 #include <spine/EventTimeline.h>
+#include <spine/IkConstraintTimeline.h>
+#include <spine/PathConstraintMixTimeline.h>
+#include <spine/PathConstraintPositionTimeline.h>
+#include <spine/PathConstraintSpacingTimeline.h>
 #include <spine/RotateTimeline.h>
+#include <spine/ScaleTimeline.h>
+#include <spine/ShearTimeline.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonData.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
+#include <spine/TransformConstraintTimeline.h>
+#include <spine/TranslateTimeline.h>
 
 #include <float.h>
 
 using namespace spine;
 
+enum TimelineType {
+	TimelineType_Other,
+	TimelineType_Attachment,
+	TimelineType_Rotate,
+	TimelineType_DrawOrder,
+	TimelineType_Translate,
+	TimelineType_TranslateX,
+	TimelineType_TranslateY,
+	TimelineType_Scale,
+	TimelineType_ScaleX,
+	TimelineType_ScaleY,
+	TimelineType_Shear,
+	TimelineType_ShearX,
+	TimelineType_ShearY,
+	TimelineType_RGBA,
+	TimelineType_Alpha,
+	TimelineType_Deform,
+	TimelineType_Event,
+	TimelineType_IkConstraint,
+	TimelineType_TransformConstraint,
+	TimelineType_PathConstraintPosition,
+	TimelineType_PathConstraintSpacing,
+	TimelineType_PathConstraintMix
+};
+
+unsigned char *AnimationState::getTimelineTypes(Animation &animation, Vector<Timeline *> &timelines) {
+	Vector<unsigned char> &types = animation._timelineTypes;
+	if (types.size() == timelines.size()) return types.buffer();
+	static const RTTI *rttis[] = {NULL, &AttachmentTimeline::rtti, &RotateTimeline::rtti, &DrawOrderTimeline::rtti,
+								  &TranslateTimeline::rtti, &TranslateXTimeline::rtti, &TranslateYTimeline::rtti,
+								  &ScaleTimeline::rtti, &ScaleXTimeline::rtti, &ScaleYTimeline::rtti,
+								  &ShearTimeline::rtti, &ShearXTimeline::rtti, &ShearYTimeline::rtti,
+								  &RGBATimeline::rtti, &AlphaTimeline::rtti, &DeformTimeline::rtti,
+								  &EventTimeline::rtti, &IkConstraintTimeline::rtti, &TransformConstraintTimeline::rtti,
+								  &PathConstraintPositionTimeline::rtti, &PathConstraintSpacingTimeline::rtti,
+								  &PathConstraintMixTimeline::rtti};
+	types.setSize(timelines.size(), TimelineType_Other);
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		const RTTI &rtti = timelines[i]->getRTTI();
+		types[i] = TimelineType_Other;
+		for (size_t type = 1; type < sizeof(rttis) / sizeof(rttis[0]); type++) {
+			if (rtti.isExactly(*rttis[type])) {
+				types[i] = (unsigned char) type;
+				break;
+			}
+		}
+	}
+	return types.buffer();
+}
+
+#define APPLY_TIMELINE(Type) \
+	static_cast<Type *>(timeline)->Type::apply(skeleton, lastTime, time, events, alpha, blend, direction); \
+	break;
+
+/// Calls the timeline's apply without virtual dispatch for the common timeline types.
+static inline void applyTimeline(Timeline *timeline, unsigned char type, Skeleton &skeleton, float lastTime, float time,
+								 Vector<Event *> *events, float alpha, MixBlend blend, MixDirection direction) {
+#ifdef SPINE_VIRTUAL_TIMELINES
+	// Every timeline through its virtual apply, as before the switch. Built by tools/host/build.sh for apply_check.
+	SP_UNUSED(type);
+	timeline->apply(skeleton, lastTime, time, events, alpha, blend, direction);
+#else
+	switch (type) {
+		case TimelineType_Rotate: APPLY_TIMELINE(RotateTimeline)
+		case TimelineType_Translate: APPLY_TIMELINE(TranslateTimeline)
+		case TimelineType_TranslateX: APPLY_TIMELINE(TranslateXTimeline)
+		case TimelineType_TranslateY: APPLY_TIMELINE(TranslateYTimeline)
+		case TimelineType_Scale: APPLY_TIMELINE(ScaleTimeline)
+		case TimelineType_ScaleX: APPLY_TIMELINE(ScaleXTimeline)
+		case TimelineType_ScaleY: APPLY_TIMELINE(ScaleYTimeline)
+		case TimelineType_Shear: APPLY_TIMELINE(ShearTimeline)
+		case TimelineType_ShearX: APPLY_TIMELINE(ShearXTimeline)
+		case TimelineType_ShearY: APPLY_TIMELINE(ShearYTimeline)
+		case TimelineType_RGBA: APPLY_TIMELINE(RGBATimeline)
+		case TimelineType_Alpha: APPLY_TIMELINE(AlphaTimeline)
+		case TimelineType_Deform: APPLY_TIMELINE(DeformTimeline)
+		case TimelineType_DrawOrder: APPLY_TIMELINE(DrawOrderTimeline)
+		case TimelineType_Event: APPLY_TIMELINE(EventTimeline)
+		case TimelineType_IkConstraint: APPLY_TIMELINE(IkConstraintTimeline)
+		case TimelineType_TransformConstraint: APPLY_TIMELINE(TransformConstraintTimeline)
+		case TimelineType_PathConstraintPosition: APPLY_TIMELINE(PathConstraintPositionTimeline)
+		case TimelineType_PathConstraintSpacing: APPLY_TIMELINE(PathConstraintSpacingTimeline)
+		case TimelineType_PathConstraintMix: APPLY_TIMELINE(PathConstraintMixTimeline)
+		default:
+			timeline->apply(skeleton, lastTime, time, events, alpha, blend, direction);
+	}
+#endif
+}
+
+#undef APPLY_TIMELINE
+
 void dummyOnAnimationEventFunc(AnimationState *state, spine::EventType type, TrackEntry *entry, Event *event = NULL) {
 	SP_UNUSED(state);
 	SP_UNUSED(type);
@@ -191,6 +293,7 @@ void TrackEntry::setListener(AnimationStateListenerObject *inValue) {
 }
 
 void TrackEntry::reset() {
+	if (_animation && _animation->_cache) _animation->_cache->release(*_animation);
 	_animation = NULL;
 	_previous = NULL;
 	_next = NULL;
@@ -461,15 +564,17 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		}
 		size_t timelineCount = current._animation->_timelines.size();
 		Vector<Timeline *> &timelines = current._animation->_timelines;
+		unsigned char *timelineTypes = getTimelineTypes(*current._animation, timelines);
 		if ((i == 0 && alpha == 1) || blend == MixBlend_Add) {
 			if (i == 0) attachments = true;
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
 				Timeline *timeline = timelines[ii];
-				if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
+				if (timelineTypes[ii] == TimelineType_Attachment)
 					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, blend,
 											attachments);
 				else
-					timeline->apply(skeleton, animationLast, applyTime, applyEvents, alpha, blend, MixDirection_In);
+					applyTimeline(timeline, timelineTypes[ii], skeleton, animationLast, applyTime, applyEvents, alpha,
+								  blend, MixDirection_In);
 			}
 		} else {
 			Vector<int> &timelineMode = current._timelineMode;
@@ -485,15 +590,15 @@ bool AnimationState::apply(Skeleton &skeleton) {
 
 				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
 
-				if (!shortestRotation && timeline->getRTTI().isExactly(RotateTimeline::rtti))
+				if (!shortestRotation && timelineTypes[ii] == TimelineType_Rotate)
 					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, applyTime, alpha,
 										timelineBlend, timelinesRotation, ii << 1, firstFrame);
-				else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
+				else if (timelineTypes[ii] == TimelineType_Attachment)
 					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime,
 											blend, attachments);
 				else
-					timeline->apply(skeleton, animationLast, applyTime, applyEvents, alpha, timelineBlend,
-									MixDirection_In);
+					applyTimeline(timeline, timelineTypes[ii], skeleton, animationLast, applyTime, applyEvents, alpha,
+								  timelineBlend, MixDirection_In);
 			}
 		}
 
@@ -503,6 +608,60 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		current._nextTrackLast = current._trackTime;
 	}
 
+	setUnkeyedAttachments(skeleton);
+
+	_queue->drain();
+	return applied;
+}
+
+bool AnimationState::applyAt(Skeleton &skeleton, float trackTime) {
+	if (_animationsChanged) {
+		animationsChanged();
+	}
+
+	bool applied = false;
+	for (size_t i = 0, n = _tracks.size(); i < n; ++i) {
+		TrackEntry *currentP = _tracks[i];
+		if (currentP == NULL || currentP->_delay > 0) {
+			continue;
+		}
+
+		TrackEntry &current = *currentP;
+
+		applied = true;
+		MixBlend blend = i == 0 ? MixBlend_First : current._mixBlend;
+		float alpha = current._alpha;
+		bool attachments = i == 0 || alpha >= current._alphaAttachmentThreshold;
+
+		float time;
+		if (current._loop) {
+			float duration = current._animationEnd - current._animationStart;
+			time = duration == 0 ? current._animationStart : MathUtil::fmod(trackTime, duration) + current._animationStart;
+		} else
+			time = MathUtil::min(trackTime + current._animationStart, current._animationEnd);
+		if (current._reverse) time = current._animation->getDuration() - time;
+
+		size_t timelineCount = current._animation->_timelines.size();
+		Vector<Timeline *> &timelines = current._animation->_timelines;
+		unsigned char *timelineTypes = getTimelineTypes(*current._animation, timelines);
+		bool firstOrAdd = (i == 0 && alpha == 1) || blend == MixBlend_Add;
+		for (size_t ii = 0; ii < timelineCount; ++ii) {
+			Timeline *timeline = timelines[ii];
+			MixBlend timelineBlend = firstOrAdd || current._timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
+			if (timelineTypes[ii] == TimelineType_Attachment)
+				applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, time, blend,
+										attachments);
+			else
+				applyTimeline(timeline, timelineTypes[ii], skeleton, time, time, NULL, alpha, timelineBlend,
+							  MixDirection_In);
+		}
+	}
+
+	setUnkeyedAttachments(skeleton);
+	return applied;
+}
+
+void AnimationState::setUnkeyedAttachments(Skeleton &skeleton) {
 	int setupState = _unkeyedState + Setup;
 	Vector<Slot *> &slots = skeleton.getSlots();
 	for (int i = 0, n = (int) slots.size(); i < n; i++) {
@@ -513,9 +672,6 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		}
 	}
 	_unkeyedState += 2;
-
-	_queue->drain();
-	return applied;
 }
 
 void AnimationState::clearTracks() {
@@ -844,9 +1000,11 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 		if (mix < from->_eventThreshold) events = &_events;
 	}
 
+	unsigned char *timelineTypes = getTimelineTypes(*from->_animation, timelines);
 	if (blend == MixBlend_Add) {
 		for (size_t i = 0; i < timelineCount; i++)
-			timelines[i]->apply(skeleton, animationLast, applyTime, events, alphaMix, blend, MixDirection_Out);
+			applyTimeline(timelines[i], timelineTypes[i], skeleton, animationLast, applyTime, events, alphaMix, blend,
+						  MixDirection_Out);
 	} else {
 		Vector<int> &timelineMode = from->_timelineMode;
 		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
@@ -865,7 +1023,7 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 			float alpha;
 			switch (timelineMode[i]) {
 				case Subsequent:
-					if (!drawOrder && (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))) continue;
+					if (!drawOrder && timelineTypes[i] == TimelineType_DrawOrder) continue;
 					timelineBlend = blend;
 					alpha = alphaMix;
 					break;
@@ -888,17 +1046,17 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 					break;
 			}
 			from->_totalAlpha += alpha;
-			if (!shortestRotation && (timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
+			if (!shortestRotation && timelineTypes[i] == TimelineType_Rotate) {
 				applyRotateTimeline((RotateTimeline *) timeline, skeleton, applyTime, alpha, timelineBlend,
 									timelinesRotation, i << 1, firstFrame);
-			} else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
+			} else if (timelineTypes[i] == TimelineType_Attachment) {
 				applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, timelineBlend,
 										attachments && alpha >= from->_alphaAttachmentThreshold);
 			} else {
-				if (drawOrder && timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) &&
-					timelineBlend == MixBlend_Setup)
+				if (drawOrder && timelineTypes[i] == TimelineType_DrawOrder && timelineBlend == MixBlend_Setup)
 					direction = MixDirection_In;
-				timeline->apply(skeleton, animationLast, applyTime, events, alpha, timelineBlend, direction);
+				applyTimeline(timeline, timelineTypes[i], skeleton, animationLast, applyTime, events, alpha,
+							  timelineBlend, direction);
 			}
 		}
 	}
@@ -992,6 +1150,7 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 
 	entry._trackIndex = (int) trackIndex;
 	entry._animation = animation;
+	if (animation->_cache) animation->_cache->retain(*animation);
 	entry._loop = loop;
 	entry._holdPrevious = 0;
 
@@ -30,6 +30,7 @@
 #include <spine/ClippingAttachment.h>
 
 #include <spine/SlotData.h>
+#include <spine/ContainerUtil.h>
 
 using namespace spine;
 
@@ -38,6 +39,10 @@ RTTI_IMPL(ClippingAttachment, VertexAttachment)
 ClippingAttachment::ClippingAttachment(const String &name) : VertexAttachment(name), _endSlot(NULL), _color() {
 }
 
+ClippingAttachment::~ClippingAttachment() {
+	ContainerUtil::cleanUpVectorOfPointers(_convexPolygons);
+}
+
 SlotData *ClippingAttachment::getEndSlot() {
 	return _endSlot;
 }
@@ -36,7 +36,9 @@ using namespace spine;
 RTTI_IMPL(CurveTimeline, Timeline)
 
 CurveTimeline::CurveTimeline(size_t frameCount, size_t frameEntries, size_t bezierCount) : Timeline(frameCount,
-																									frameEntries) {
+																									frameEntries),
+																						  _curveOffset(0), _curveScale(0),
+																						  _quantized(false) {
 	_curves.setSize(frameCount + bezierCount * BEZIER_SIZE, 0);
 	_curves[frameCount - 1] = STEPPED;
 }
@@ -94,11 +96,72 @@ Vector<float> &CurveTimeline::getCurves() {
 	return _curves;
 }
 
+static unsigned short quantizeUnit(float value) {
+	if (!(value > 0)) return 0;
+	if (value >= 1) return 65535;
+	return (unsigned short) (value * 65535 + 0.5f);
+}
+
+bool CurveTimeline::quantizeCurves(Vector<float> &times) {
+	size_t frameCount = times.size();
+	size_t bezierCount = (_curves.size() - frameCount) / BEZIER_SIZE;
+	if (bezierCount > 65535 - BEZIER) return false;
+
+	float min = 0, max = 0;
+	for (size_t i = frameCount + 1, n = _curves.size(); i < n; i += 2) {
+		float y = _curves[i];
+		if (i == frameCount + 1 || y < min) min = y;
+		if (i == frameCount + 1 || y > max) max = y;
+	}
+	_curveOffset = min;
+	_curveScale = (max - min) / 65535;
+
+	_quantizedCurves.setSize(_curves.size(), 0);
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		int type = (int) _curves[frame];
+		if (type < BEZIER) {
+			_quantizedCurves[frame] = (unsigned short) type;
+			continue;
+		}
+		size_t i = type - BEZIER, bezier = (i - frameCount) / BEZIER_SIZE;
+		_quantizedCurves[frame] = (unsigned short) (BEZIER + bezier);
+		float time1 = times[frame], span = times[frame + 1] - time1;
+		for (size_t n = i + BEZIER_SIZE; i < n; i += 2) {
+			_quantizedCurves[i] = span > 0 ? quantizeUnit((_curves[i] - time1) / span) : 0;
+			_quantizedCurves[i + 1] = _curveScale > 0 ? quantizeUnit((_curves[i + 1] - min) / (max - min)) : 0;
+		}
+	}
+	_curves.clear();
+	_curves.shrink();
+	_quantized = true;
+	return true;
+}
+
+float CurveTimeline::getQuantizedBezierValue(float time, size_t frame, float time1, float value1, float time2,
+											 float value2) {
+	unsigned short *samples = _quantizedCurves.buffer() + getFrameCount() +
+							  (_quantizedCurves[frame] - BEZIER) * BEZIER_SIZE;
+	float span = (time2 - time1) / 65535, offset = _curveOffset, scale = _curveScale;
+	float x = time1 + samples[0] * span;
+	if (x > time) return value1 + (time - time1) / (x - time1) * (offset + samples[1] * scale - value1);
+	for (int i = 2; i < BEZIER_SIZE; i += 2) {
+		x = time1 + samples[i] * span;
+		if (x >= time) {
+			float px = time1 + samples[i - 2] * span, py = offset + samples[i - 1] * scale;
+			return py + (time - px) / (x - px) * (offset + samples[i + 1] * scale - py);
+		}
+	}
+	x = time1 + samples[BEZIER_SIZE - 2] * span;
+	float y = offset + samples[BEZIER_SIZE - 1] * scale;
+	return y + (time - x) / (time2 - x) * (value2 - y);
+}
+
 RTTI_IMPL(CurveTimeline1, CurveTimeline)
 
 CurveTimeline1::CurveTimeline1(size_t frameCount, size_t bezierCount) : CurveTimeline(frameCount,
 																					  CurveTimeline1::ENTRIES,
-																					  bezierCount) {
+																					  bezierCount),
+																		_valueOffset(0), _valueScale(0) {
 }
 
 CurveTimeline1::~CurveTimeline1() {
@@ -111,6 +174,7 @@ void CurveTimeline1::setFrame(size_t frame, float time, float value) {
 }
 
 float CurveTimeline1::getCurveValue(float time) {
+	if (_quantized) return getQuantizedCurveValue(time);
 	int i = (int) _frames.size() - 2;
 	for (int ii = 2; ii <= i; ii += 2) {
 		if (_frames[ii] > time) {
@@ -132,6 +196,52 @@ float CurveTimeline1::getCurveValue(float time) {
 	return getBezierValue(time, i, CurveTimeline1::VALUE, curveType - CurveTimeline1::BEZIER);
 }
 
+bool CurveTimeline1::quantize() {
+	if (_quantized) return true;
+	size_t frameCount = getFrameCount();
+	Vector<float> times;
+	times.setSize(frameCount, 0);
+	float min = _frames[CurveTimeline1::VALUE], max = min;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		float value = _frames[frame * CurveTimeline1::ENTRIES + CurveTimeline1::VALUE];
+		times[frame] = _frames[frame * CurveTimeline1::ENTRIES];
+		if (value < min) min = value;
+		if (value > max) max = value;
+	}
+	if (!quantizeCurves(times)) return false;
+
+	_valueOffset = min;
+	_valueScale = (max - min) / 65535;
+	_quantizedValues.setSize(frameCount, 0);
+	for (size_t frame = 0; _valueScale > 0 && frame < frameCount; frame++)
+		_quantizedValues[frame] = quantizeUnit((_frames[frame * CurveTimeline1::ENTRIES + CurveTimeline1::VALUE] - min) / (max - min));
+	_frames.clearAndAddAll(times);
+	_frames.shrink();
+	_frameEntries = 1;
+	return true;
+}
+
+float CurveTimeline1::getQuantizedCurveValue(float time) {
+	int i = (int) _frames.size() - 1;
+	for (int ii = 1; ii <= i; ii++) {
+		if (_frames[ii] > time) {
+			i = ii - 1;
+			break;
+		}
+	}
+
+	float value = getQuantizedValue(i);
+	switch (_quantizedCurves[i]) {
+		case CurveTimeline::LINEAR: {
+			float before = _frames[i];
+			return value + (time - before) / (_frames[i + 1] - before) * (getQuantizedValue(i + 1) - value);
+		}
+		case CurveTimeline::STEPPED:
+			return value;
+	}
+	return getQuantizedBezierValue(time, i, _frames[i], value, _frames[i + 1], getQuantizedValue(i + 1));
+}
+
 float CurveTimeline1::getRelativeValue(float time, float alpha, MixBlend blend, float current, float setup) {
 	if (time < _frames[0]) {
 		switch (blend) {
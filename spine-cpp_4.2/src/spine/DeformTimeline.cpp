@@ -36,6 +36,7 @@
 
 #include <spine/Animation.h>
 #include <spine/Bone.h>
+#include <spine/MathUtil.h>
 #include <spine/Property.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
@@ -44,8 +45,29 @@ using namespace spine;
 
 RTTI_IMPL(DeformTimeline, CurveTimeline)
 
+// Sets [start, end) to the setup vertices, or to zero when setup is NULL (weighted offsets).
+static void setToSetup(float *deform, const float *setup, size_t start, size_t end) {
+	if (start >= end) return;
+	if (setup)
+		memcpy(deform + start, setup + start, (end - start) * sizeof(float));
+	else
+		memset(deform + start, 0, (end - start) * sizeof(float));
+}
+
+// Blends [start, end) toward the setup vertices, or toward zero when setup is NULL (weighted offsets).
+static void mixToSetup(float *deform, const float *setup, size_t start, size_t end, float alpha) {
+	if (setup) {
+		for (size_t i = start; i < end; i++)
+			deform[i] += (setup[i] - deform[i]) * alpha;
+	} else {
+		for (size_t i = start; i < end; i++)
+			deform[i] += (0 - deform[i]) * alpha;
+	}
+}
+
 DeformTimeline::DeformTimeline(size_t frameCount, size_t bezierCount, int slotIndex, VertexAttachment *attachment)
-	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _attachment(attachment) {
+	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _attachment(attachment), _sparse(false),
+	  _vertexCount(0), _rangeStart(0), _rangeCount(0) {
 	PropertyId ids[] = {((PropertyId) Property_Deform << 32) | ((slotIndex << 16 | attachment->_id) & 0xffffffff)};
 	setPropertyIds(ids, 1);
 
@@ -81,8 +103,7 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		blend = MixBlend_Setup;
 	}
 
-	Vector<Vector<float>> &vertices = _vertices;
-	size_t vertexCount = vertices[0].size();
+	size_t vertexCount = _vertexCount;
 
 	Vector<float> &frames = _frames;
 	if (time < _frames[0]) {
@@ -117,142 +138,69 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	deformArray.setSize(vertexCount, 0);
-	Vector<float> &deform = deformArray;
+	float *deform = deformArray.buffer();
+	float *setupVertices = attachment->getBones().size() == 0 ? attachment->getVertices().buffer() : NULL;
 
-	if (time >= frames[frames.size() - 1]) {// Time is after last frame.
-		Vector<float> &lastVertices = vertices[frames.size() - 1];
-		if (alpha == 1) {
-			if (blend == MixBlend_Add) {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] - setupVertices[i];
-				} else {
-					// Weighted deform offsets, no alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i];
-				}
-			} else {
-				// Vertex positions or deform offsets, no alpha.
-				memcpy(deform.buffer(), lastVertices.buffer(), vertexCount * sizeof(float));
+	// Keys covering the range, the last key twice when time is after the last frame.
+	const float *prevVertices, *nextVertices;
+	float percent = 0;
+	if (time >= frames[frames.size() - 1]) {
+		prevVertices = nextVertices = getFrameRange(frames.size() - 1, _prevVertices);
+	} else {
+		int frame = Animation::search(frames, time);
+		percent = getCurvePercent(time, frame);
+		prevVertices = getFrameRange(frame, _prevVertices);
+		nextVertices = getFrameRange(frame + 1, _nextVertices);
+	}
+
+	// Outside the range every key is the setup pose: vertex positions for unweighted attachments, zero offsets for
+	// weighted ones. Blending that is done without reading the keys and adding it is a no-op.
+	size_t start = _rangeStart, end = _rangeStart + _rangeCount, n = _rangeCount;
+	float *rangeDeform = deform + start;
+	const float *rangeSetup = setupVertices ? setupVertices + start : NULL;
+	if (blend == MixBlend_Add) {
+		if (rangeSetup) {
+			// Unweighted vertex positions.
+			for (size_t i = 0; i < n; i++) {
+				float prev = prevVertices[i];
+				rangeDeform[i] += (prev + (nextVertices[i] - prev) * percent - rangeSetup[i]) * alpha;
 			}
 		} else {
-			switch (blend) {
-				case MixBlend_Setup: {
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, with alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++) {
-							float setup = setupVertices[i];
-							deform[i] = setup + (lastVertices[i] - setup) * alpha;
-						}
-					} else {
-						// Weighted deform offsets, with alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] = lastVertices[i] * alpha;
-					}
-					break;
-				}
-				case MixBlend_First:
-				case MixBlend_Replace:
-					// Vertex positions or deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (lastVertices[i] - deform[i]) * alpha;
-					break;
-				case MixBlend_Add:
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, no alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-					} else {
-						// Weighted deform offsets, alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += lastVertices[i] * alpha;
-					}
+			// Weighted deform offsets.
+			for (size_t i = 0; i < n; i++) {
+				float prev = prevVertices[i];
+				rangeDeform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
 			}
 		}
-		return;
-	}
-
-	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::search(frames, time);
-	float percent = getCurvePercent(time, frame);
-	Vector<float> &prevVertices = vertices[frame];
-	Vector<float> &nextVertices = vertices[frame + 1];
-
-	if (alpha == 1) {
-		if (blend == MixBlend_Add) {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, no alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
-			} else {
-				// Weighted deform offsets, no alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent;
-				}
+	} else if (alpha == 1 || blend == MixBlend_Setup) {
+		setToSetup(deform, setupVertices, 0, start);
+		setToSetup(deform, setupVertices, end, vertexCount);
+		if (alpha == 1) {
+			// Vertex positions or deform offsets, no alpha.
+			for (size_t i = 0; i < n; i++) {
+				float prev = prevVertices[i];
+				rangeDeform[i] = prev + (nextVertices[i] - prev) * percent;
+			}
+		} else if (rangeSetup) {
+			// Unweighted vertex positions, with alpha.
+			for (size_t i = 0; i < n; i++) {
+				float prev = prevVertices[i], setup = rangeSetup[i];
+				rangeDeform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
 			}
 		} else {
-			// Vertex positions or deform offsets, no alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
+			// Weighted deform offsets, with alpha.
+			for (size_t i = 0; i < n; i++) {
 				float prev = prevVertices[i];
-				deform[i] = prev + (nextVertices[i] - prev) * percent;
+				rangeDeform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
 			}
 		}
 	} else {
-		switch (blend) {
-			case MixBlend_Setup: {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i], setup = setupVertices[i];
-						deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-				break;
-			}
-			case MixBlend_First:
-			case MixBlend_Replace:
-				// Vertex positions or deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
-				}
-				break;
-			case MixBlend_Add:
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
+		// First or replace, vertex positions or deform offsets, with alpha.
+		mixToSetup(deform, setupVertices, 0, start, alpha);
+		mixToSetup(deform, setupVertices, end, vertexCount, alpha);
+		for (size_t i = 0; i < n; i++) {
+			float prev = prevVertices[i];
+			rangeDeform[i] += (prev + (nextVertices[i] - prev) * percent - rangeDeform[i]) * alpha;
 		}
 	}
 }
@@ -281,6 +229,17 @@ void DeformTimeline::setBezier(size_t bezier, size_t frame, float value, float t
 }
 
 float DeformTimeline::getCurvePercent(float time, int frame) {
+	if (_quantized) {
+		switch (_quantizedCurves[frame]) {
+			case DeformTimeline::LINEAR: {
+				float x = _frames[frame];
+				return (time - x) / (_frames[frame + 1] - x);
+			}
+			case DeformTimeline::STEPPED:
+				return 0;
+		}
+		return getQuantizedBezierValue(time, frame, _frames[frame], 0, _frames[frame + 1], 1);
+	}
 	int i = (int) _curves[frame];
 	switch (i) {
 		case DeformTimeline::LINEAR: {
@@ -310,15 +269,132 @@ float DeformTimeline::getCurvePercent(float time, int frame) {
 }
 
 void DeformTimeline::setFrame(int frame, float time, Vector<float> &vertices) {
+	if (_sparse) {
+		// The new key can change any vertex, go back to full keys.
+		Vector<float> full;
+		for (size_t i = 0, n = _vertices.size(); i < n; i++)
+			_vertices[i].clearAndAddAll(getFrameVertices(i, full));
+		_sparse = false;
+	}
 	_frames[frame] = time;
 	_vertices[frame].clear();
 	_vertices[frame].addAll(vertices);
+	_vertexCount = vertices.size();
+	_rangeStart = 0;
+	_rangeCount = _vertexCount;
 }
 
 Vector<Vector<float>> &DeformTimeline::getVertices() {
 	return _vertices;
 }
 
+void DeformTimeline::sparsify() {
+	if (_sparse || _quantized) return;
+	size_t frameCount = _vertices.size();
+	float *setupVertices = _attachment->_bones.size() > 0 ? NULL : _attachment->_vertices.buffer();
+	size_t start = _vertexCount, end = 0;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		float *vertices = _vertices[frame].buffer();
+		for (size_t i = 0; i < start; i++) {
+			if (vertices[i] != (setupVertices ? setupVertices[i] : 0)) {
+				start = i;
+				break;
+			}
+		}
+		for (size_t i = _vertexCount; i > end; i--) {
+			if (vertices[i - 1] != (setupVertices ? setupVertices[i - 1] : 0)) {
+				end = i;
+				break;
+			}
+		}
+	}
+	if (start >= end) start = end = 0;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		Vector<float> &vertices = _vertices[frame];
+		if (start > 0) memmove(vertices.buffer(), vertices.buffer() + start, (end - start) * sizeof(float));
+		vertices.setSize(end - start, 0);
+		vertices.shrink();
+	}
+	_rangeStart = start;
+	_rangeCount = end - start;
+	_sparse = true;
+}
+
+bool DeformTimeline::quantize() {
+	if (_quantized) return true;
+	if (!quantizeCurves(_frames)) return false;
+
+	sparsify();
+	size_t frameCount = _vertices.size();
+	bool weighted = _attachment->_bones.size() > 0;
+	float *setupVertices = _attachment->_vertices.buffer() + _rangeStart;
+	_quantizedFrames.setSize(frameCount, QuantizedFrame());
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		Vector<float> &vertices = _vertices[frame];
+		int start = -1, end = 0;
+		float max = 0;
+		for (size_t i = 0; i < _rangeCount; i++) {
+			float delta = MathUtil::abs(weighted ? vertices[i] : vertices[i] - setupVertices[i]);
+			if (delta == 0) continue;
+			if (start == -1) start = (int) i;
+			end = (int) i + 1;
+			if (delta > max) max = delta;
+		}
+		QuantizedFrame &quantized = _quantizedFrames[frame];
+		quantized.offset = (int) _quantizedVertices.size();
+		quantized.start = (int) _rangeStart + (start == -1 ? 0 : start);
+		quantized.count = start == -1 ? 0 : end - start;
+		quantized.scale = max / 32767;
+		for (int i = start, n = start + quantized.count; i < n; i++) {
+			float delta = weighted ? vertices[i] : vertices[i] - setupVertices[i];
+			_quantizedVertices.add((short) MathUtil::clamp(delta / quantized.scale + (delta < 0 ? -0.5f : 0.5f), -32767, 32767));
+		}
+	}
+	_quantizedVertices.shrink();
+	_vertices.clear();
+	_vertices.shrink();
+	return true;
+}
+
+Vector<float> &DeformTimeline::getFrameVertices(size_t frame, Vector<float> &out) {
+	out.setSize(_vertexCount, 0);
+	if (_attachment->_bones.size() > 0)
+		memset(out.buffer(), 0, _vertexCount * sizeof(float));
+	else
+		memcpy(out.buffer(), _attachment->_vertices.buffer(), _vertexCount * sizeof(float));
+	if (!_quantized) {
+		memcpy(out.buffer() + _rangeStart, _vertices[frame].buffer(), _rangeCount * sizeof(float));
+		return out;
+	}
+	QuantizedFrame &quantized = _quantizedFrames[frame];
+	float *vertices = out.buffer() + quantized.start, scale = quantized.scale;
+	short *deltas = _quantizedVertices.buffer() + quantized.offset;
+	for (int i = 0, n = quantized.count; i < n; i++)
+		vertices[i] += deltas[i] * scale;
+	return out;
+}
+
+float *DeformTimeline::getFrameRange(size_t frame, Vector<float> &out) {
+	if (!_quantized) return _vertices[frame].buffer();
+	out.setSize(_rangeCount, 0);
+	float *vertices = out.buffer();
+	if (_attachment->_bones.size() > 0)
+		memset(vertices, 0, _rangeCount * sizeof(float));
+	else
+		memcpy(vertices, _attachment->_vertices.buffer() + _rangeStart, _rangeCount * sizeof(float));
+	QuantizedFrame &quantized = _quantizedFrames[frame];
+	float *keyVertices = vertices + (quantized.start - (int) _rangeStart), scale = quantized.scale;
+	short *deltas = _quantizedVertices.buffer() + quantized.offset;
+	for (int i = 0, n = quantized.count; i < n; i++)
+		keyVertices[i] += deltas[i] * scale;
+	return vertices;
+}
+
+size_t DeformTimeline::getQuantizedBytes() {
+	return CurveTimeline::getQuantizedBytes() + _quantizedVertices.size() * sizeof(short) +
+		   _quantizedFrames.size() * sizeof(QuantizedFrame);
+}
+
 VertexAttachment *DeformTimeline::getAttachment() {
 	return _attachment;
 }
@@ -28,6 +28,7 @@
  *****************************************************************************/
 
 #include <spine/Extension.h>
+#include <spine/Vector.h>
 #include <spine/SpineString.h>
 
 #include <assert.h>
@@ -36,6 +37,11 @@ using namespace spine;
 
 SpineExtension *SpineExtension::_instance = NULL;
 
+#ifdef SPINE_VECTOR_STATS
+size_t VectorStats::copies = 0;
+size_t VectorStats::reallocations = 0;
+#endif
+
 void SpineExtension::setInstance(SpineExtension *inValue) {
 	assert(inValue);
 
@@ -55,6 +61,20 @@ SpineExtension::~SpineExtension() {
 SpineExtension::SpineExtension() {
 }
 
+char *SpineExtension::_readFile(const String &path, int offset, int length) {
+	int fileLength = 0;
+	char *file = _readFile(path, &fileLength);
+	if (!file) return NULL;
+	if (offset < 0 || length <= 0 || offset + length > fileLength) {
+		_free(file, __FILE__, __LINE__);
+		return NULL;
+	}
+	char *data = (char *) _alloc(length, __FILE__, __LINE__);
+	if (data) memcpy(data, file + offset, length);
+	_free(file, __FILE__, __LINE__);
+	return data;
+}
+
 DefaultSpineExtension::~DefaultSpineExtension() {
 }
 
@@ -123,5 +143,23 @@ char *DefaultSpineExtension::_readFile(const String &path, int *length) {
 #endif
 }
 
+char *DefaultSpineExtension::_readFile(const String &path, int offset, int length) {
+#ifndef __EMSCRIPTEN__
+	FILE *file = fopen(path.buffer(), "rb");
+	if (!file) return 0;
+
+	char *data = SpineExtension::alloc<char>(length, __FILE__, __LINE__);
+	if (fseek(file, offset, SEEK_SET) != 0 || fread(data, 1, length, file) != (size_t) length) {
+		SpineExtension::free(data, __FILE__, __LINE__);
+		data = NULL;
+	}
+	fclose(file);
+
+	return data;
+#else
+	return nullptr;
+#endif
+}
+
 DefaultSpineExtension::DefaultSpineExtension() : SpineExtension() {
 }
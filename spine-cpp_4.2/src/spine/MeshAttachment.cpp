@@ -28,6 +28,9 @@
  *****************************************************************************/
 
 #include <spine/MeshAttachment.h>
+#include <spine/Slot.h>
+
+#include <assert.h>
 
 using namespace spine;
 
@@ -51,64 +54,80 @@ void MeshAttachment::updateRegion() {
 	if (_uvs.size() != _regionUVs.size()) {
 		_uvs.setSize(_regionUVs.size(), 0);
 	}
+	computeUVs(_region, _uvs.buffer());
+}
+
+void MeshAttachment::updateSequence() {
+	if (_sequence == NULL) return;
+	Vector<TextureRegion *> &regions = _sequence->getRegions();
+	_sequence->_frameStride = _regionUVs.size();
+	_sequence->_frames.setSize(regions.size() * _regionUVs.size(), 0);
+	for (size_t i = 0, n = regions.size(); i < n; i++)
+		computeUVs(regions[i], _sequence->getFrame((int) i));
+	if (regions.size() != 0) {
+		_region = regions[_sequence->getFrameIndex(-1)];
+		updateRegion();
+	}
+}
 
-	if (_region == nullptr) {
+void MeshAttachment::computeUVs(TextureRegion *region, float *uvs) {
+	if (region == nullptr) {
 		return;
 	}
 
 	int i = 0, n = (int) _regionUVs.size();
-	float u = _region->u, v = _region->v;
+	float u = region->u, v = region->v;
 	float width = 0, height = 0;
-	switch (_region->degrees) {
+	switch (region->degrees) {
 		case 90: {
-			float textureWidth = _region->height / (_region->u2 - _region->u);
-			float textureHeight = _region->width / (_region->v2 - _region->v);
-			u -= (_region->originalHeight - _region->offsetY - _region->height) / textureWidth;
-			v -= (_region->originalWidth - _region->offsetX - _region->width) / textureHeight;
-			width = _region->originalHeight / textureWidth;
-			height = _region->originalWidth / textureHeight;
+			float textureWidth = region->height / (region->u2 - region->u);
+			float textureHeight = region->width / (region->v2 - region->v);
+			u -= (region->originalHeight - region->offsetY - region->height) / textureWidth;
+			v -= (region->originalWidth - region->offsetX - region->width) / textureHeight;
+			width = region->originalHeight / textureWidth;
+			height = region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + _regionUVs[i + 1] * width;
-				_uvs[i + 1] = v + (1 - _regionUVs[i]) * height;
+				uvs[i] = u + _regionUVs[i + 1] * width;
+				uvs[i + 1] = v + (1 - _regionUVs[i]) * height;
 			}
 			return;
 		}
 		case 180: {
-			float textureWidth = _region->width / (_region->u2 - _region->u);
-			float textureHeight = _region->height / (_region->v2 - _region->v);
-			u -= (_region->originalWidth - _region->offsetX - _region->width) / textureWidth;
-			v -= _region->offsetY / textureHeight;
-			width = _region->originalWidth / textureWidth;
-			height = _region->originalHeight / textureHeight;
+			float textureWidth = region->width / (region->u2 - region->u);
+			float textureHeight = region->height / (region->v2 - region->v);
+			u -= (region->originalWidth - region->offsetX - region->width) / textureWidth;
+			v -= region->offsetY / textureHeight;
+			width = region->originalWidth / textureWidth;
+			height = region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + (1 - _regionUVs[i]) * width;
-				_uvs[i + 1] = v + (1 - _regionUVs[i + 1]) * height;
+				uvs[i] = u + (1 - _regionUVs[i]) * width;
+				uvs[i + 1] = v + (1 - _regionUVs[i + 1]) * height;
 			}
 			return;
 		}
 		case 270: {
-			float textureHeight = _region->height / (_region->v2 - _region->v);
-			float textureWidth = _region->width / (_region->u2 - _region->u);
-			u -= _region->offsetY / textureWidth;
-			v -= _region->offsetX / textureHeight;
-			width = _region->originalHeight / textureWidth;
-			height = _region->originalWidth / textureHeight;
+			float textureHeight = region->height / (region->v2 - region->v);
+			float textureWidth = region->width / (region->u2 - region->u);
+			u -= region->offsetY / textureWidth;
+			v -= region->offsetX / textureHeight;
+			width = region->originalHeight / textureWidth;
+			height = region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + (1 - _regionUVs[i + 1]) * width;
-				_uvs[i + 1] = v + _regionUVs[i] * height;
+				uvs[i] = u + (1 - _regionUVs[i + 1]) * width;
+				uvs[i + 1] = v + _regionUVs[i] * height;
 			}
 			return;
 		}
 		default: {
-			float textureWidth = _region->width / (_region->u2 - _region->u);
-			float textureHeight = _region->height / (_region->v2 - _region->v);
-			u -= _region->offsetX / textureWidth;
-			v -= (_region->originalHeight - _region->offsetY - _region->height) / textureHeight;
-			width = _region->originalWidth / textureWidth;
-			height = _region->originalHeight / textureHeight;
+			float textureWidth = region->width / (region->u2 - region->u);
+			float textureHeight = region->height / (region->v2 - region->v);
+			u -= region->offsetX / textureWidth;
+			v -= (region->originalHeight - region->offsetY - region->height) / textureHeight;
+			width = region->originalWidth / textureWidth;
+			height = region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + _regionUVs[i] * width;
-				_uvs[i + 1] = v + _regionUVs[i + 1] * height;
+				uvs[i] = u + _regionUVs[i] * width;
+				uvs[i + 1] = v + _regionUVs[i + 1] * height;
 			}
 		}
 	}
@@ -130,6 +149,17 @@ Vector<float> &MeshAttachment::getUVs() {
 	return _uvs;
 }
 
+float *MeshAttachment::getUVs(Slot &slot) {
+	if (_sequence == NULL) return _uvs.buffer();
+	// drawing doesn't write to the attachment, the frames come from the loaders, copy and newLinkedMesh
+	assert(_sequence->hasFrames() || _regionUVs.size() == 0);
+	return _sequence->getFrame(_sequence->getFrameIndex(slot.getSequenceIndex()));
+}
+
+TextureRegion *MeshAttachment::getRegion(Slot &slot) {
+	return _sequence ? _sequence->getRegions()[_sequence->getFrameIndex(slot.getSequenceIndex())] : _region;
+}
+
 Vector<unsigned short> &MeshAttachment::getTriangles() {
 	return _triangles;
 }
@@ -230,12 +260,10 @@ MeshAttachment *MeshAttachment::newLinkedMesh() {
 	copy->_color.set(_color);
 	copy->_timelineAttachment = this->_timelineAttachment;
 	copy->setParentMesh(_parentMesh ? _parentMesh : this);
-	if (copy->_region) copy->updateRegion();
+	if (_sequence) {
+		copy->_sequence = _sequence->copy();
+		copy->updateSequence();
+	} else if (copy->_region)
+		copy->updateRegion();
 	return copy;
 }
-
-void MeshAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
-										  size_t stride) {
-	if (_sequence) _sequence->apply(&slot, this);
-	VertexAttachment::computeWorldVertices(slot, start, count, worldVertices, offset, stride);
-}
@@ -38,6 +38,8 @@
 #include <spine/BoneData.h>
 #include <spine/SlotData.h>
 
+#include <string.h>
+
 using namespace spine;
 
 RTTI_IMPL(PathConstraint, Updatable)
@@ -47,6 +49,12 @@ const int PathConstraint::NONE = -1;
 const int PathConstraint::BEFORE = -2;
 const int PathConstraint::AFTER = -3;
 
+enum CurveState {
+	CURVE_DIRTY,
+	CURVE_MEASURED,
+	CURVE_SEGMENTS
+};
+
 PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : Updatable(),
 																			   _data(data),
 																			   _target(skeleton.findSlot(
@@ -56,17 +64,23 @@ PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : U
 																			   _mixRotate(data.getMixRotate()),
 																			   _mixX(data.getMixX()),
 																			   _mixY(data.getMixY()),
+																			   _cachedPath(NULL),
+																			   _cachedTarget(NULL),
+																			   _pathLength(0),
+																			   _measuredCurves(0),
+																			   _measuredSegments(0),
 																			   _active(false) {
 	_bones.ensureCapacity(_data.getBones().size());
 	for (size_t i = 0; i < _data.getBones().size(); i++) {
 		BoneData *boneData = _data.getBones()[i];
 		_bones.add(skeleton.findBone(boneData->getName()));
 	}
-
-	_segments.setSize(10, 0);
 }
 
 void PathConstraint::update(Physics) {
+	_measuredCurves = 0;
+	_measuredSegments = 0;
+
 	Attachment *baseAttachment = _target->getAttachment();
 	if (baseAttachment == NULL || !baseAttachment->getRTTI().instanceOf(PathAttachment::rtti)) {
 		return;
@@ -308,6 +322,8 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 				multiplier = 1;
 		}
 
+		// _world is used as scratch here.
+		_cachedPath = NULL;
 		world.setSize(8, 0);
 		for (int i = 0, o = 0, curve = 0; i < spacesCount; i++, o += 3) {
 			float space = _spaces[i] * multiplier;
@@ -367,57 +383,90 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 		return out;
 	}
 
-	// World vertices.
-	if (closed) {
+	// World vertices, reused while the bones and deform that position them are unchanged.
+	if (closed)
 		verticesLength += 2;
-		world.setSize(verticesLength, 0);
-		path.computeWorldVertices(target, 2, verticesLength - 4, world, 0);
-		path.computeWorldVertices(target, 0, 2, world, verticesLength - 4);
-		world[verticesLength - 2] = world[0];
-		world[verticesLength - 1] = world[1];
-	} else {
+	else {
 		curveCount--;
 		verticesLength -= 4;
+	}
+	bool changed = updatePathState(path);
+	if (changed) {
+		_prevWorld.clearAndAddAll(world);
 		world.setSize(verticesLength, 0);
-		path.computeWorldVertices(target, 2, verticesLength, world, 0);
+		if (closed) {
+			path.computeWorldVertices(target, 2, verticesLength - 4, world, 0);
+			path.computeWorldVertices(target, 0, 2, world, verticesLength - 4);
+			world[verticesLength - 2] = world[0];
+			world[verticesLength - 1] = world[1];
+		} else
+			path.computeWorldVertices(target, 2, verticesLength, world, 0);
+
+		// Only curves whose vertices moved are measured again.
+		if (_prevWorld.size() != world.size() || _curveStates.size() != (size_t) curveCount) {
+			_curveTerms.setSize(curveCount * 4, 0);
+			_curveSegments.setSize(curveCount * 10, 0);
+			_curveStates.setSize(curveCount, CURVE_DIRTY);
+			for (int i = 0; i < curveCount; i++)
+				_curveStates[i] = CURVE_DIRTY;
+		} else {
+			for (int i = 0, w = 0; i < curveCount; i++, w += 6) {
+				if (memcmp(world.buffer() + w, _prevWorld.buffer() + w, 8 * sizeof(float)) != 0)
+					_curveStates[i] = CURVE_DIRTY;
+			}
+		}
 	}
 
 	// Curve lengths.
-	_curves.setSize(curveCount, 0);
-	pathLength = 0;
+	float *curveTerms = _curveTerms.buffer();
 	float x1 = world[0], y1 = world[1], cx1 = 0, cy1 = 0, cx2 = 0, cy2 = 0, x2 = 0, y2 = 0;
 	float tmpx, tmpy, dddfx, dddfy, ddfx, ddfy, dfx, dfy;
-	for (int i = 0, w = 2; i < curveCount; i++, w += 6) {
-		cx1 = world[w];
-		cy1 = world[w + 1];
-		cx2 = world[w + 2];
-		cy2 = world[w + 3];
-		x2 = world[w + 4];
-		y2 = world[w + 5];
-		tmpx = (x1 - cx1 * 2 + cx2) * 0.1875f;
-		tmpy = (y1 - cy1 * 2 + cy2) * 0.1875f;
-		dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.09375f;
-		dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.09375f;
-		ddfx = tmpx * 2 + dddfx;
-		ddfy = tmpy * 2 + dddfy;
-		dfx = (cx1 - x1) * 0.75f + tmpx + dddfx * 0.16666667f;
-		dfy = (cy1 - y1) * 0.75f + tmpy + dddfy * 0.16666667f;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx;
-		dfy += ddfy;
-		ddfx += dddfx;
-		ddfy += dddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx;
-		dfy += ddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx + dddfx;
-		dfy += ddfy + dddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		_curves[i] = pathLength;
-		x1 = x2;
-		y1 = y2;
-	}
+	if (changed) {
+		_curves.setSize(curveCount, 0);
+		pathLength = 0;
+		for (int i = 0, w = 2; i < curveCount; i++, w += 6) {
+			float *terms = curveTerms + i * 4;
+			if (_curveStates[i] == CURVE_DIRTY) {
+				x1 = world[w - 2];
+				y1 = world[w - 1];
+				cx1 = world[w];
+				cy1 = world[w + 1];
+				cx2 = world[w + 2];
+				cy2 = world[w + 3];
+				x2 = world[w + 4];
+				y2 = world[w + 5];
+				tmpx = (x1 - cx1 * 2 + cx2) * 0.1875f;
+				tmpy = (y1 - cy1 * 2 + cy2) * 0.1875f;
+				dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.09375f;
+				dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.09375f;
+				ddfx = tmpx * 2 + dddfx;
+				ddfy = tmpy * 2 + dddfy;
+				dfx = (cx1 - x1) * 0.75f + tmpx + dddfx * 0.16666667f;
+				dfy = (cy1 - y1) * 0.75f + tmpy + dddfy * 0.16666667f;
+				terms[0] = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				dfx += ddfx;
+				dfy += ddfy;
+				ddfx += dddfx;
+				ddfy += dddfy;
+				terms[1] = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				dfx += ddfx;
+				dfy += ddfy;
+				terms[2] = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				dfx += ddfx + dddfx;
+				dfy += ddfy + dddfy;
+				terms[3] = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				_curveStates[i] = CURVE_MEASURED;
+				_measuredCurves++;
+			}
+			pathLength += terms[0];
+			pathLength += terms[1];
+			pathLength += terms[2];
+			pathLength += terms[3];
+			_curves[i] = pathLength;
+		}
+		_pathLength = pathLength;
+	} else
+		pathLength = _pathLength;
 
 	if (_data._positionMode == PositionMode_Percent) position *= pathLength;
 
@@ -433,7 +482,7 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			multiplier = 1;
 	}
 
-	float curveLength = 0;
+	float curveLength = 0, *segments = NULL;
 	for (int i = 0, o = 0, curve = 0, segment = 0; i < spacesCount; i++, o += 3) {
 		float space = _spaces[i] * multiplier;
 		position += space;
@@ -476,44 +525,50 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			cy2 = world[ii + 5];
 			x2 = world[ii + 6];
 			y2 = world[ii + 7];
-			tmpx = (x1 - cx1 * 2 + cx2) * 0.03f;
-			tmpy = (y1 - cy1 * 2 + cy2) * 0.03f;
-			dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.006f;
-			dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.006f;
-			ddfx = tmpx * 2 + dddfx;
-			ddfy = tmpy * 2 + dddfy;
-			dfx = (cx1 - x1) * 0.3f + tmpx + dddfx * 0.16666667f;
-			dfy = (cy1 - y1) * 0.3f + tmpy + dddfy * 0.16666667f;
-			curveLength = MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[0] = curveLength;
-			for (ii = 1; ii < 8; ii++) {
+			segments = _curveSegments.buffer() + curve * 10;
+			if (_curveStates[curve] != CURVE_SEGMENTS) {
+				tmpx = (x1 - cx1 * 2 + cx2) * 0.03f;
+				tmpy = (y1 - cy1 * 2 + cy2) * 0.03f;
+				dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.006f;
+				dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.006f;
+				ddfx = tmpx * 2 + dddfx;
+				ddfy = tmpy * 2 + dddfy;
+				dfx = (cx1 - x1) * 0.3f + tmpx + dddfx * 0.16666667f;
+				dfy = (cy1 - y1) * 0.3f + tmpy + dddfy * 0.16666667f;
+				curveLength = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				segments[0] = curveLength;
+				for (ii = 1; ii < 8; ii++) {
+					dfx += ddfx;
+					dfy += ddfy;
+					ddfx += dddfx;
+					ddfy += dddfy;
+					curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+					segments[ii] = curveLength;
+				}
 				dfx += ddfx;
 				dfy += ddfy;
-				ddfx += dddfx;
-				ddfy += dddfy;
 				curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-				_segments[ii] = curveLength;
+				segments[8] = curveLength;
+				dfx += ddfx + dddfx;
+				dfy += ddfy + dddfy;
+				curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				segments[9] = curveLength;
+				_curveStates[curve] = CURVE_SEGMENTS;
+				_measuredSegments++;
 			}
-			dfx += ddfx;
-			dfy += ddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[8] = curveLength;
-			dfx += ddfx + dddfx;
-			dfy += ddfy + dddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[9] = curveLength;
+			curveLength = segments[9];
 			segment = 0;
 		}
 
 		// Weight by segment length.
 		p *= curveLength;
 		for (;; segment++) {
-			float length = _segments[segment];
+			float length = segments[segment];
 			if (p > length) continue;
 			if (segment == 0)
 				p /= length;
 			else {
-				float prev = _segments[segment - 1];
+				float prev = segments[segment - 1];
 				p = segment + (p - prev) / (length - prev);
 			}
 			break;
@@ -525,6 +580,54 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 	return out;
 }
 
+bool PathConstraint::updatePathState(PathAttachment &path) {
+	Slot &target = *_target;
+	bool changed = false;
+	if (_cachedPath != &path || _cachedTarget != &target) {
+		_cachedPath = &path;
+		_cachedTarget = &target;
+		_pathBones.clear();
+		Vector<int> &bones = path.getBones();
+		if (bones.size() == 0)
+			_pathBones.add(target.getBone().getData().getIndex());
+		else {
+			for (size_t i = 0, n = bones.size(); i < n;) {
+				size_t nn = bones[i++];
+				for (nn += i; i < nn; i++)
+					if (!_pathBones.contains(bones[i])) _pathBones.add(bones[i]);
+			}
+		}
+		_pathBoneState.setSize(_pathBones.size() * 6, 0);
+		_pathDeform.clear();
+		_curveStates.clear();
+		changed = true;
+	}
+
+	Vector<Bone *> &skeletonBones = target.getBone()._skeleton.getBones();
+	float *state = _pathBoneState.buffer();
+	for (size_t i = 0, n = _pathBones.size(); i < n; i++, state += 6) {
+		Bone &bone = *skeletonBones[_pathBones[i]];
+		if (state[0] != bone._a || state[1] != bone._b || state[2] != bone._c || state[3] != bone._d ||
+			state[4] != bone._worldX || state[5] != bone._worldY) {
+			state[0] = bone._a;
+			state[1] = bone._b;
+			state[2] = bone._c;
+			state[3] = bone._d;
+			state[4] = bone._worldX;
+			state[5] = bone._worldY;
+			changed = true;
+		}
+	}
+
+	Vector<float> &deform = target.getDeform();
+	if (deform.size() != _pathDeform.size() ||
+		(deform.size() > 0 && memcmp(deform.buffer(), _pathDeform.buffer(), deform.size() * sizeof(float)) != 0)) {
+		_pathDeform.clearAndAddAll(deform);
+		changed = true;
+	}
+	return changed;
+}
+
 void PathConstraint::addBeforePosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o) {
 	float x1 = temp[i];
 	float y1 = temp[i + 1];
@@ -328,13 +328,23 @@ void PhysicsConstraint::update(Physics physics) {
 			_remaining += delta;
 			_lastTime = _skeleton.getTime();
 
+			// Half a step is left over when capped, so rounding in the step loops can't cost a step.
+			float t = _data._step, deferred = 0;
+			int maxSteps = _skeleton.getPhysicsMaxSteps();
+			if (maxSteps > 0 && _remaining >= t * (maxSteps + 1)) {
+				float capped = t * (maxSteps + 0.5f);
+				if (_skeleton.getPhysicsSteps() == PhysicsSteps_Defer) deferred = _remaining - capped;
+				_remaining = capped;
+			}
+
 			float bx = bone->_worldX, by = bone->_worldY;
 			if (_reset) {
 				_reset = false;
 				_ux = bx;
 				_uy = by;
+				_remaining += deferred;
 			} else {
-				float a = _remaining, i = _inertia, t = _data._step, f = _skeleton.getData()->getReferenceScale();
+				float a = _remaining, i = _inertia, f = _skeleton.getData()->getReferenceScale();
 				float qx = _data._limit * delta, qy = qx * MathUtil::abs(_skeleton.getScaleX());
 				qx *= MathUtil::abs(_skeleton.getScaleY());
 				if (x || y) {
@@ -423,7 +433,7 @@ void PhysicsConstraint::update(Physics physics) {
 						}
 					}
 				}
-				_remaining = a;
+				_remaining = a + deferred;
 			}
 
 			_cx = bone->_worldX;
@@ -68,24 +68,49 @@ RegionAttachment::~RegionAttachment() {
 }
 
 void RegionAttachment::updateRegion() {
-	if (_region == NULL) {
-		_uvs[BLX] = 0;
-		_uvs[BLY] = 0;
-		_uvs[ULX] = 0;
-		_uvs[ULY] = 1;
-		_uvs[URX] = 1;
-		_uvs[URY] = 1;
-		_uvs[BRX] = 1;
-		_uvs[BRY] = 0;
+	computeRegion(_region, _vertexOffset.buffer(), _uvs.buffer());
+}
+
+void RegionAttachment::updateSequence() {
+	if (_sequence == NULL) return;
+	Vector<TextureRegion *> &regions = _sequence->getRegions();
+	_sequence->_frameStride = NUM_UVS * 2;
+	_sequence->_frames.setSize(regions.size() * NUM_UVS * 2, 0);
+	for (size_t i = 0, n = regions.size(); i < n; i++) {
+		float *frame = _sequence->getFrame((int) i);
+		computeRegion(regions[i], frame, frame + NUM_UVS);
+	}
+	if (regions.size() != 0) {
+		_region = regions[_sequence->getFrameIndex(-1)];
+		updateRegion();
+	}
+}
+
+float *RegionAttachment::getSequenceFrame(Slot &slot) {
+	// drawing doesn't write to the attachment, the frames come from the loaders and copy
+	assert(_sequence->hasFrames());
+	return _sequence->getFrame(_sequence->getFrameIndex(slot.getSequenceIndex()));
+}
+
+void RegionAttachment::computeRegion(TextureRegion *region, float *vertexOffset, float *uvs) {
+	if (region == NULL) {
+		uvs[BLX] = 0;
+		uvs[BLY] = 0;
+		uvs[ULX] = 0;
+		uvs[ULY] = 1;
+		uvs[URX] = 1;
+		uvs[URY] = 1;
+		uvs[BRX] = 1;
+		uvs[BRY] = 0;
 		return;
 	}
 
-	float regionScaleX = _width / _region->originalWidth * _scaleX;
-	float regionScaleY = _height / _region->originalHeight * _scaleY;
-	float localX = -_width / 2 * _scaleX + _region->offsetX * regionScaleX;
-	float localY = -_height / 2 * _scaleY + _region->offsetY * regionScaleY;
-	float localX2 = localX + _region->width * regionScaleX;
-	float localY2 = localY + _region->height * regionScaleY;
+	float regionScaleX = _width / region->originalWidth * _scaleX;
+	float regionScaleY = _height / region->originalHeight * _scaleY;
+	float localX = -_width / 2 * _scaleX + region->offsetX * regionScaleX;
+	float localY = -_height / 2 * _scaleY + region->offsetY * regionScaleY;
+	float localX2 = localX + region->width * regionScaleX;
+	float localY2 = localY + region->height * regionScaleY;
 	float cos = MathUtil::cosDeg(_rotation);
 	float sin = MathUtil::sinDeg(_rotation);
 	float localXCos = localX * cos + _x;
@@ -97,33 +122,33 @@ void RegionAttachment::updateRegion() {
 	float localY2Cos = localY2 * cos + _y;
 	float localY2Sin = localY2 * sin;
 
-	_vertexOffset[BLX] = localXCos - localYSin;
-	_vertexOffset[BLY] = localYCos + localXSin;
-	_vertexOffset[ULX] = localXCos - localY2Sin;
-	_vertexOffset[ULY] = localY2Cos + localXSin;
-	_vertexOffset[URX] = localX2Cos - localY2Sin;
-	_vertexOffset[URY] = localY2Cos + localX2Sin;
-	_vertexOffset[BRX] = localX2Cos - localYSin;
-	_vertexOffset[BRY] = localYCos + localX2Sin;
-
-	if (_region->degrees == 90) {
-		_uvs[URX] = _region->u;
-		_uvs[URY] = _region->v2;
-		_uvs[BRX] = _region->u;
-		_uvs[BRY] = _region->v;
-		_uvs[BLX] = _region->u2;
-		_uvs[BLY] = _region->v;
-		_uvs[ULX] = _region->u2;
-		_uvs[ULY] = _region->v2;
+	vertexOffset[BLX] = localXCos - localYSin;
+	vertexOffset[BLY] = localYCos + localXSin;
+	vertexOffset[ULX] = localXCos - localY2Sin;
+	vertexOffset[ULY] = localY2Cos + localXSin;
+	vertexOffset[URX] = localX2Cos - localY2Sin;
+	vertexOffset[URY] = localY2Cos + localX2Sin;
+	vertexOffset[BRX] = localX2Cos - localYSin;
+	vertexOffset[BRY] = localYCos + localX2Sin;
+
+	if (region->degrees == 90) {
+		uvs[URX] = region->u;
+		uvs[URY] = region->v2;
+		uvs[BRX] = region->u;
+		uvs[BRY] = region->v;
+		uvs[BLX] = region->u2;
+		uvs[BLY] = region->v;
+		uvs[ULX] = region->u2;
+		uvs[ULY] = region->v2;
 	} else {
-		_uvs[ULX] = _region->u;
-		_uvs[ULY] = _region->v2;
-		_uvs[URX] = _region->u;
-		_uvs[URY] = _region->v;
-		_uvs[BRX] = _region->u2;
-		_uvs[BRY] = _region->v;
-		_uvs[BLX] = _region->u2;
-		_uvs[BLY] = _region->v2;
+		uvs[ULX] = region->u;
+		uvs[ULY] = region->v2;
+		uvs[URX] = region->u;
+		uvs[URY] = region->v;
+		uvs[BRX] = region->u2;
+		uvs[BRY] = region->v;
+		uvs[BLX] = region->u2;
+		uvs[BLY] = region->v2;
 	}
 }
 
@@ -133,33 +158,33 @@ void RegionAttachment::computeWorldVertices(Slot &slot, Vector<float> &worldVert
 }
 
 void RegionAttachment::computeWorldVertices(Slot &slot, float *worldVertices, size_t offset, size_t stride) {
-	if (_sequence) _sequence->apply(&slot, this);
+	float *vertexOffset = _sequence ? getSequenceFrame(slot) : _vertexOffset.buffer();
 
 	Bone &bone = slot.getBone();
 	float x = bone.getWorldX(), y = bone.getWorldY();
 	float a = bone.getA(), b = bone.getB(), c = bone.getC(), d = bone.getD();
 	float offsetX, offsetY;
 
-	offsetX = _vertexOffset[BRX];
-	offsetY = _vertexOffset[BRY];
+	offsetX = vertexOffset[BRX];
+	offsetY = vertexOffset[BRY];
 	worldVertices[offset] = offsetX * a + offsetY * b + x;// br
 	worldVertices[offset + 1] = offsetX * c + offsetY * d + y;
 	offset += stride;
 
-	offsetX = _vertexOffset[BLX];
-	offsetY = _vertexOffset[BLY];
+	offsetX = vertexOffset[BLX];
+	offsetY = vertexOffset[BLY];
 	worldVertices[offset] = offsetX * a + offsetY * b + x;// bl
 	worldVertices[offset + 1] = offsetX * c + offsetY * d + y;
 	offset += stride;
 
-	offsetX = _vertexOffset[ULX];
-	offsetY = _vertexOffset[ULY];
+	offsetX = vertexOffset[ULX];
+	offsetY = vertexOffset[ULY];
 	worldVertices[offset] = offsetX * a + offsetY * b + x;// ul
 	worldVertices[offset + 1] = offsetX * c + offsetY * d + y;
 	offset += stride;
 
-	offsetX = _vertexOffset[URX];
-	offsetY = _vertexOffset[URY];
+	offsetX = vertexOffset[URX];
+	offsetY = vertexOffset[URY];
 	worldVertices[offset] = offsetX * a + offsetY * b + x;// ur
 	worldVertices[offset + 1] = offsetX * c + offsetY * d + y;
 }
@@ -252,6 +277,14 @@ Vector<float> &RegionAttachment::getUVs() {
 	return _uvs;
 }
 
+float *RegionAttachment::getUVs(Slot &slot) {
+	return _sequence ? getSequenceFrame(slot) + NUM_UVS : _uvs.buffer();
+}
+
+TextureRegion *RegionAttachment::getRegion(Slot &slot) {
+	return _sequence ? _sequence->getRegions()[_sequence->getFrameIndex(slot.getSequenceIndex())] : _region;
+}
+
 spine::Color &RegionAttachment::getColor() {
 	return _color;
 }
@@ -39,7 +39,8 @@ Sequence::Sequence(int count) : _id(Sequence::getNextID()),
 								_regions(),
 								_start(0),
 								_digits(0),
-								_setupIndex(0) {
+								_setupIndex(0),
+								_frameStride(0) {
 	_regions.setSize(count, NULL);
 }
 
@@ -54,14 +55,13 @@ Sequence *Sequence::copy() {
 	copy->_start = _start;
 	copy->_digits = _digits;
 	copy->_setupIndex = _setupIndex;
+	copy->_frames.clearAndAddAll(_frames);
+	copy->_frameStride = _frameStride;
 	return copy;
 }
 
 void Sequence::apply(Slot *slot, Attachment *attachment) {
-	int index = slot->getSequenceIndex();
-	if (index == -1) index = _setupIndex;
-	if (index >= (int) _regions.size()) index = (int) _regions.size() - 1;
-	TextureRegion *region = _regions[index];
+	TextureRegion *region = _regions[getFrameIndex(slot->getSequenceIndex())];
 
 	if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
 		RegionAttachment *regionAttachment = static_cast<RegionAttachment *>(attachment);
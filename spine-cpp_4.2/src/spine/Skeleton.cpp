@@ -58,18 +58,21 @@
 using namespace spine;
 
 Skeleton::Skeleton(SkeletonData *skeletonData)
-	: _data(skeletonData), _skin(NULL), _color(1, 1, 1, 1), _scaleX(1),
-	  _scaleY(1), _x(0), _y(0), _time(0) {
+	: _data(skeletonData), _boneBlock(NULL), _skinRequired(false), _skin(NULL), _color(1, 1, 1, 1), _scaleX(1),
+	  _scaleY(1), _x(0), _y(0), _time(0),
+	  _physicsMaxSteps(0), _physicsSteps(PhysicsSteps_Drop) {
 	_bones.ensureCapacity(_data->getBones().size());
+	if (_data->getBones().size() > 0)
+		_boneBlock = SpineExtension::alloc<Bone>(_data->getBones().size(), __FILE__, __LINE__);
 	for (size_t i = 0; i < _data->getBones().size(); ++i) {
 		BoneData *data = _data->getBones()[i];
 
 		Bone *bone;
 		if (data->getParent() == NULL) {
-			bone = new (__FILE__, __LINE__) Bone(*data, *this, NULL);
+			bone = new (_boneBlock + i) Bone(*data, *this, NULL);
 		} else {
 			Bone *parent = _bones[data->getParent()->getIndex()];
-			bone = new (__FILE__, __LINE__) Bone(*data, *this, parent);
+			bone = new (_boneBlock + i) Bone(*data, *this, parent);
 			parent->getChildren().add(bone);
 		}
 
@@ -132,15 +135,37 @@ Skeleton::Skeleton(SkeletonData *skeletonData)
 }
 
 Skeleton::~Skeleton() {
-	ContainerUtil::cleanUpVectorOfPointers(_bones);
+	for (size_t i = 0, n = _bones.size(); i < n; ++i)
+		_bones[i]->~Bone();
+	SpineExtension::free(_boneBlock, __FILE__, __LINE__);
 	ContainerUtil::cleanUpVectorOfPointers(_slots);
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_physicsConstraints);
+	ContainerUtil::cleanUpVectorOfPointers(_skinUpdateCaches);
 }
 
 void Skeleton::updateCache() {
+	ContainerUtil::cleanUpVectorOfPointers(_skinUpdateCaches);
+
+	_skinRequired = false;
+	for (size_t i = 0, n = _bones.size(); i < n && !_skinRequired; ++i)
+		_skinRequired = _bones[i]->_data.isSkinRequired();
+	for (size_t i = 0, n = _ikConstraints.size(); i < n && !_skinRequired; ++i)
+		_skinRequired = _ikConstraints[i]->_data.isSkinRequired();
+	for (size_t i = 0, n = _transformConstraints.size(); i < n && !_skinRequired; ++i)
+		_skinRequired = _transformConstraints[i]->_data.isSkinRequired();
+	for (size_t i = 0, n = _pathConstraints.size(); i < n && !_skinRequired; ++i)
+		_skinRequired = _pathConstraints[i]->_data.isSkinRequired();
+	for (size_t i = 0, n = _physicsConstraints.size(); i < n && !_skinRequired; ++i)
+		_skinRequired = _physicsConstraints[i]->_data.isSkinRequired();
+
+	sortUpdateCache();
+	storeUpdateCache();
+}
+
+void Skeleton::sortUpdateCache() {
 	_updateCache.clear();
 
 	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
@@ -211,6 +236,58 @@ continue_outer:
 	for (i = 0; i < n; ++i) {
 		sortBone(_bones[i]);
 	}
+
+	updateCacheTypes();
+}
+
+enum UpdateType {
+	UpdateType_Other,
+	UpdateType_Bone,
+	UpdateType_Ik,
+	UpdateType_Transform,
+	UpdateType_Path,
+	UpdateType_Physics
+};
+
+void Skeleton::updateCacheTypes() {
+	_updateCacheTypes.setSize(_updateCache.size(), UpdateType_Other);
+	for (size_t i = 0, n = _updateCache.size(); i < n; i++) {
+		const RTTI &rtti = _updateCache[i]->getRTTI();
+		unsigned char type = UpdateType_Other;
+		if (rtti.isExactly(Bone::rtti))
+			type = UpdateType_Bone;
+		else if (rtti.isExactly(IkConstraint::rtti))
+			type = UpdateType_Ik;
+		else if (rtti.isExactly(TransformConstraint::rtti))
+			type = UpdateType_Transform;
+		else if (rtti.isExactly(PathConstraint::rtti))
+			type = UpdateType_Path;
+		else if (rtti.isExactly(PhysicsConstraint::rtti))
+			type = UpdateType_Physics;
+		_updateCacheTypes[i] = type;
+	}
+}
+
+inline void Skeleton::update(Updatable *updatable, unsigned char type, Physics physics) {
+	switch (type) {
+		case UpdateType_Bone:
+			static_cast<Bone *>(updatable)->Bone::update(physics);
+			break;
+		case UpdateType_Ik:
+			static_cast<IkConstraint *>(updatable)->IkConstraint::update(physics);
+			break;
+		case UpdateType_Transform:
+			static_cast<TransformConstraint *>(updatable)->TransformConstraint::update(physics);
+			break;
+		case UpdateType_Path:
+			static_cast<PathConstraint *>(updatable)->PathConstraint::update(physics);
+			break;
+		case UpdateType_Physics:
+			static_cast<PhysicsConstraint *>(updatable)->PhysicsConstraint::update(physics);
+			break;
+		default:
+			updatable->update(physics);
+	}
 }
 
 void Skeleton::printUpdateCache() {
@@ -246,10 +323,13 @@ void Skeleton::updateWorldTransform(Physics physics) {
 		bone->_ashearY = bone->_shearY;
 	}
 
-	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
-		Updatable *updatable = _updateCache[i];
-		updatable->update(physics);
-	}
+	// The cache list is public, entries added since updateCache get their type here.
+	size_t n = _updateCache.size();
+	if (_updateCacheTypes.size() != n) updateCacheTypes();
+	Updatable **updateCache = _updateCache.buffer();
+	unsigned char *types = _updateCacheTypes.buffer();
+	for (size_t i = 0; i < n; ++i)
+		update(updateCache[i], types[i], physics);
 }
 
 void Skeleton::updateWorldTransform(Physics physics, Bone *parent) {
@@ -273,10 +353,12 @@ void Skeleton::updateWorldTransform(Physics physics, Bone *parent) {
 
 	// Update everything except root bone.
 	Bone *rb = getRootBone();
-	for (size_t i = 0, n = _updateCache.size(); i < n; i++) {
+	size_t n = _updateCache.size();
+	if (_updateCacheTypes.size() != n) updateCacheTypes();
+	for (size_t i = 0; i < n; i++) {
 		Updatable *updatable = _updateCache[i];
 		if (updatable != rb)
-			updatable->update(physics);
+			update(updatable, _updateCacheTypes[i], physics);
 	}
 }
 
@@ -319,11 +401,11 @@ void Skeleton::setSlotsToSetupPose() {
 }
 
 Bone *Skeleton::findBone(const String &boneName) {
-	return ContainerUtil::findWithDataName(_bones, boneName);
+	return ContainerUtil::findWithDataName(_bones, _data->getNames().lookup(boneName));
 }
 
 Slot *Skeleton::findSlot(const String &slotName) {
-	return ContainerUtil::findWithDataName(_slots, slotName);
+	return ContainerUtil::findWithDataName(_slots, _data->getNames().lookup(slotName));
 }
 
 void Skeleton::setSkin(const String &skinName) {
@@ -354,7 +436,94 @@ void Skeleton::setSkin(Skin *newSkin) {
 	}
 
 	_skin = newSkin;
-	updateCache();
+	if (!restoreUpdateCache()) {
+		sortUpdateCache();
+		storeUpdateCache();
+	}
+}
+
+/// Number of skins whose update caches setSkin keeps.
+static const size_t MAX_SKIN_UPDATE_CACHES = 8;
+
+Attachment *Skeleton::getPathAttachment(PathConstraint *constraint) {
+	Attachment *attachment = constraint->_target->getAttachment();
+	return attachment != NULL && attachment->getRTTI().instanceOf(PathAttachment::rtti) ? attachment : NULL;
+}
+
+void Skeleton::storeUpdateCache() {
+	Skin *skin = _skinRequired ? _skin : NULL;
+	SkinUpdateCache *cache = NULL;
+	for (size_t i = 0, n = _skinUpdateCaches.size(); i < n; i++) {
+		if (_skinUpdateCaches[i]->_skin == skin) {
+			cache = _skinUpdateCaches[i];
+			_skinUpdateCaches.removeAt(i);
+			break;
+		}
+	}
+	if (!cache) {
+		if (_skinUpdateCaches.size() == MAX_SKIN_UPDATE_CACHES) {
+			cache = _skinUpdateCaches[0];
+			_skinUpdateCaches.removeAt(0);
+		} else
+			cache = new (__FILE__, __LINE__) SkinUpdateCache();
+		cache->_skin = skin;
+	}
+	_skinUpdateCaches.add(cache);
+
+	cache->_revision = skin ? skin->_revision : 0;
+	cache->_updateCache.clearAndAddAll(_updateCache);
+	cache->_updateCacheTypes.clearAndAddAll(_updateCacheTypes);
+	Vector<bool> &active = cache->_active;
+	active.clear();
+	for (size_t i = 0, n = _bones.size(); i < n; i++)
+		active.add(_bones[i]->_active);
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; i++)
+		active.add(_ikConstraints[i]->_active);
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; i++)
+		active.add(_transformConstraints[i]->_active);
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; i++)
+		active.add(_pathConstraints[i]->_active);
+	for (size_t i = 0, n = _physicsConstraints.size(); i < n; i++)
+		active.add(_physicsConstraints[i]->_active);
+	cache->_pathAttachments.clear();
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; i++)
+		cache->_pathAttachments.add(getPathAttachment(_pathConstraints[i]));
+}
+
+bool Skeleton::restoreUpdateCache() {
+	Skin *skin = _skinRequired ? _skin : NULL;
+	SkinUpdateCache *cache = NULL;
+	size_t index = 0;
+	for (size_t n = _skinUpdateCaches.size(); index < n; index++) {
+		if (_skinUpdateCaches[index]->_skin == skin) {
+			cache = _skinUpdateCaches[index];
+			break;
+		}
+	}
+	if (!cache || cache->_revision != (skin ? skin->_revision : 0)) return false;
+	// A path attachment that is in no skin adds bones to the order, so the cache only holds for the same ones.
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; i++)
+		if (cache->_pathAttachments[i] != getPathAttachment(_pathConstraints[i])) return false;
+
+	_skinUpdateCaches.removeAt(index);
+	_skinUpdateCaches.add(cache);
+
+	_updateCache.clearAndAddAll(cache->_updateCache);
+	_updateCacheTypes.clearAndAddAll(cache->_updateCacheTypes);
+	bool *active = cache->_active.buffer();
+	for (size_t i = 0, n = _bones.size(); i < n; i++) {
+		_bones[i]->_active = *active++;
+		_bones[i]->_sorted = true;
+	}
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; i++)
+		_ikConstraints[i]->_active = *active++;
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; i++)
+		_transformConstraints[i]->_active = *active++;
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; i++)
+		_pathConstraints[i]->_active = *active++;
+	for (size_t i = 0, n = _physicsConstraints.size(); i < n; i++)
+		_physicsConstraints[i]->_active = *active++;
+	return true;
 }
 
 Attachment *Skeleton::getAttachment(const String &slotName,
@@ -771,3 +940,8 @@ void Skeleton::physicsRotate(float x, float y, float degrees) {
 		_physicsConstraints[i]->rotate(x, y, degrees);
 	}
 }
+
+void Skeleton::setPhysicsMaxSteps(int maxSteps, PhysicsSteps policy) {
+	_physicsMaxSteps = maxSteps;
+	_physicsSteps = policy;
+}
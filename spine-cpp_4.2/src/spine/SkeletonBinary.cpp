@@ -30,6 +30,7 @@
 #include <spine/SkeletonBinary.h>
 
 #include <spine/Animation.h>
+#include <spine/AnimationCache.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
@@ -78,17 +79,27 @@ using namespace spine;
 
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
 															new (__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)),
-													_error(), _scale(1), _ownsLoader(true) {
+													_error(), _scale(1), _ownsLoader(true), _lazyAnimations(false),
+													_stripUnreachable(false), _skinTable(NULL),
+													_quantizeAnimations(false) {
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(
 																							  attachmentLoader),
 																					  _error(),
 																					  _scale(1),
-																					  _ownsLoader(ownsLoader) {
+																					  _ownsLoader(ownsLoader),
+																					  _lazyAnimations(false),
+																					  _stripUnreachable(false), _skinTable(NULL),
+																					  _quantizeAnimations(false) {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonBinary::SkeletonBinary(float scale) : _attachmentLoader(NULL), _error(), _scale(scale), _ownsLoader(false),
+											  _lazyAnimations(false), _stripUnreachable(false), _skinTable(NULL),
+											  _quantizeAnimations(false) {
+}
+
 SkeletonBinary::~SkeletonBinary() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 	_linkedMeshes.clear();
@@ -105,6 +116,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	input->end = binary + length;
 
 	_linkedMeshes.clear();
+	memset(&_stripReport, 0, sizeof(_stripReport));
 
 	skeletonData = new (__FILE__, __LINE__) SkeletonData();
 
@@ -146,15 +158,15 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 
 	int numStrings = readVarint(input, true);
 	for (int i = 0; i < numStrings; i++)
-		skeletonData->_strings.add(readString(input));
+		skeletonData->_strings.add((char *) readAtom(input, skeletonData));
 
 	/* Bones. */
 	int numBones = readVarint(input, true);
 	skeletonData->_bones.setSize(numBones, 0);
 	for (int i = 0; i < numBones; ++i) {
-		const char *name = readString(input);
+		String name = readName(input, skeletonData);
 		BoneData *parent = i == 0 ? 0 : skeletonData->_bones[readVarint(input, true)];
-		BoneData *data = new (__FILE__, __LINE__) BoneData(i, String(name, true), parent);
+		BoneData *data = new (__FILE__, __LINE__) BoneData(i, name, parent);
 		data->_rotation = readFloat(input);
 		data->_x = readFloat(input) * _scale;
 		data->_y = readFloat(input) * _scale;
@@ -177,7 +189,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	int slotsCount = readVarint(input, true);
 	skeletonData->_slots.setSize(slotsCount, 0);
 	for (int i = 0; i < slotsCount; ++i) {
-		String slotName = String(readString(input), true);
+		String slotName = readName(input, skeletonData);
 		BoneData *boneData = skeletonData->_bones[readVarint(input, true)];
 		SlotData *slotData = new (__FILE__, __LINE__) SlotData(i, slotName, *boneData);
 
@@ -202,8 +214,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	int ikConstraintsCount = readVarint(input, true);
 	skeletonData->_ikConstraints.setSize(ikConstraintsCount, 0);
 	for (int i = 0; i < ikConstraintsCount; ++i) {
-		const char *name = readString(input);
-		IkConstraintData *data = new (__FILE__, __LINE__) IkConstraintData(String(name, true));
+		IkConstraintData *data = new (__FILE__, __LINE__) IkConstraintData(readName(input, skeletonData));
 		data->setOrder(readVarint(input, true));
 		int bonesCount = readVarint(input, true);
 		data->_bones.setSize(bonesCount, 0);
@@ -226,8 +237,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	int transformConstraintsCount = readVarint(input, true);
 	skeletonData->_transformConstraints.setSize(transformConstraintsCount, 0);
 	for (int i = 0; i < transformConstraintsCount; ++i) {
-		const char *name = readString(input);
-		TransformConstraintData *data = new (__FILE__, __LINE__) TransformConstraintData(String(name, true));
+		TransformConstraintData *data = new (__FILE__, __LINE__) TransformConstraintData(readName(input, skeletonData));
 		data->setOrder(readVarint(input, true));
 		int bonesCount = readVarint(input, true);
 		data->_bones.setSize(bonesCount, 0);
@@ -259,8 +269,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	int pathConstraintsCount = readVarint(input, true);
 	skeletonData->_pathConstraints.setSize(pathConstraintsCount, 0);
 	for (int i = 0; i < pathConstraintsCount; ++i) {
-		const char *name = readString(input);
-		PathConstraintData *data = new (__FILE__, __LINE__) PathConstraintData(String(name, true));
+		PathConstraintData *data = new (__FILE__, __LINE__) PathConstraintData(readName(input, skeletonData));
 		data->setOrder(readVarint(input, true));
 		data->setSkinRequired(readBoolean(input));
 		int bonesCount = readVarint(input, true);
@@ -288,8 +297,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	int physicsConstraintsCount = readVarint(input, true);
 	skeletonData->_physicsConstraints.setSize(physicsConstraintsCount, 0);
 	for (int i = 0; i < physicsConstraintsCount; i++) {
-		const char *name = readString(input);
-		PhysicsConstraintData *data = new (__FILE__, __LINE__) PhysicsConstraintData(String(name, true));
+		PhysicsConstraintData *data = new (__FILE__, __LINE__) PhysicsConstraintData(readName(input, skeletonData));
 		data->_order = readVarint(input, true);
 		data->_bone = skeletonData->_bones[readVarint(input, true)];
 		int flags = readByte(input);
@@ -332,8 +340,13 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		return NULL;
 	}
 
-	/* Skins. */
+	/* Skins. Skipped skins keep a NULL entry until the animations are read, so skin indices stay valid. */
 	for (size_t i = 0, n = (size_t) readVarint(input, true); i < n; ++i) {
+		if (!isSkinRequired(input)) {
+			skipSkin(input, nonessential);
+			skeletonData->_skins.add(NULL);
+			continue;
+		}
 		Skin *skin = readSkin(input, false, skeletonData, nonessential);
 		if (skin)
 			skeletonData->_skins.add(skin);
@@ -348,6 +361,12 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	for (int i = 0, n = (int) _linkedMeshes.size(); i < n; ++i) {
 		LinkedMesh *linkedMesh = _linkedMeshes[i];
 		Skin *skin = skeletonData->_skins[linkedMesh->_skinIndex];
+		if (skin == NULL) {
+			delete input;
+			delete skeletonData;
+			setError("Parent mesh is in a skipped skin: ", linkedMesh->_parent.buffer());
+			return NULL;
+		}
 		Attachment *parent = skin->getAttachment(linkedMesh->_slotIndex, linkedMesh->_parent);
 		if (parent == NULL) {
 			delete input;
@@ -358,7 +377,8 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		linkedMesh->_mesh->_timelineAttachment = linkedMesh->_inheritTimeline ? static_cast<VertexAttachment *>(parent)
 																			  : linkedMesh->_mesh;
 		linkedMesh->_mesh->setParentMesh(static_cast<MeshAttachment *>(parent));
-		if (linkedMesh->_mesh->_region) linkedMesh->_mesh->updateRegion();
+		if (linkedMesh->_mesh->_sequence) linkedMesh->_mesh->updateSequence();
+		else if (linkedMesh->_mesh->_region) linkedMesh->_mesh->updateRegion();
 		_attachmentLoader->configureAttachment(linkedMesh->_mesh);
 	}
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
@@ -368,8 +388,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	int eventsCount = readVarint(input, true);
 	skeletonData->_events.setSize(eventsCount, 0);
 	for (int i = 0; i < eventsCount; ++i) {
-		const char *name = readString(input);
-		EventData *eventData = new (__FILE__, __LINE__) EventData(String(name, true));
+		EventData *eventData = new (__FILE__, __LINE__) EventData(readName(input, skeletonData));
 		eventData->_intValue = readVarint(input, false);
 		eventData->_floatValue = readFloat(input);
 		eventData->_stringValue.own(readString(input));
@@ -382,19 +401,58 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	}
 
 	/* Animations. */
+	if (_lazyAnimations)
+		skeletonData->_animationCache = new (__FILE__, __LINE__) AnimationCache(*skeletonData, binary, length, _scale);
+	if (_lazyAnimations) skeletonData->_animationCache->_quantize = _quantizeAnimations;
+	Vector<Vector<String> > reachableNames;
+	Vector<Attachment *> reachableAttachments;
+	if (_stripUnreachable) reachableNames.setSize(skeletonData->_slots.size(), Vector<String>());
 	int animationsCount = readVarint(input, true);
-	skeletonData->_animations.setSize(animationsCount, 0);
+	skeletonData->_animations.ensureCapacity(animationsCount);
 	for (int i = 0; i < animationsCount; ++i) {
-		String name(readString(input), true);
-		Animation *animation = readAnimation(name, input, skeletonData);
-		if (!animation) {
-			delete input;
-			delete skeletonData;
-			return NULL;
+		String name = readName(input, skeletonData);
+		if (_requiredAnimations.size() > 0 && !_requiredAnimations.contains(name)) {
+			int bytes = skipAnimation(input, skeletonData, NULL, NULL, NULL);
+			if (bytes < 0) {
+				delete input;
+				delete skeletonData;
+				return NULL;
+			}
+			_stripReport.animations++;
+			_stripReport.bytes += bytes;
+			continue;
+		}
+		Animation *animation;
+		if (_lazyAnimations) {
+			// Only the duration and timeline ids are read now, the timelines are decoded on first use.
+			size_t offset = (size_t) (input->cursor - binary);
+			Vector<Timeline *> timelines;
+			animation = new (__FILE__, __LINE__) Animation(name, timelines, 0);
+			if (skipAnimation(input, skeletonData, animation, _stripUnreachable ? &reachableNames : NULL,
+							  &reachableAttachments) < 0) {
+				delete animation;
+				delete input;
+				delete skeletonData;
+				return NULL;
+			}
+			skeletonData->_animationCache->add(*animation, offset, (size_t) (input->cursor - binary) - offset);
+		} else {
+			animation = readAnimation(name, input, skeletonData);
+			if (!animation) {
+				delete input;
+				delete skeletonData;
+				return NULL;
+			}
+			if (_stripUnreachable) markReachable(animation, reachableNames, reachableAttachments);
 		}
-		skeletonData->_animations[i] = animation;
+		skeletonData->_animations.add(animation);
 	}
 
+	if (_lazyAnimations && _stripReport.skins > 0) skeletonData->_animationCache->_skins.clearAndAddAll(skeletonData->_skins);
+	for (int i = (int) skeletonData->_skins.size() - 1; i >= 0; --i)
+		if (skeletonData->_skins[i] == NULL) skeletonData->_skins.removeAt(i);
+	if (_stripUnreachable) stripUnreachable(skeletonData, reachableNames, reachableAttachments);
+
 	delete input;
 	return skeletonData;
 }
@@ -409,6 +467,7 @@ SkeletonData *SkeletonBinary::readSkeletonDataFile(const String &path) {
 	}
 	skeletonData = readSkeletonData((unsigned char *) binary, length);
 	SpineExtension::free(binary, __FILE__, __LINE__);
+	if (skeletonData && skeletonData->_animationCache) skeletonData->_animationCache->setPath(path);
 	return skeletonData;
 }
 
@@ -432,9 +491,21 @@ char *SkeletonBinary::readString(DataInput *input) {
 	return string;
 }
 
-char *SkeletonBinary::readStringRef(DataInput *input, SkeletonData *skeletonData) {
+const char *SkeletonBinary::readAtom(DataInput *input, SkeletonData *skeletonData) {
+	int length = readVarint(input, true);
+	if (length == 0) return NULL;
+	const char *atom = skeletonData->_names.intern((const char *) input->cursor, length - 1);
+	input->cursor += length - 1;
+	return atom;
+}
+
+String SkeletonBinary::readName(DataInput *input, SkeletonData *skeletonData) {
+	return StringPool::share(readAtom(input, skeletonData));
+}
+
+String SkeletonBinary::readStringRef(DataInput *input, SkeletonData *skeletonData) {
 	int index = readVarint(input, true);
-	return index == 0 ? NULL : skeletonData->_strings[index - 1];
+	return index == 0 ? String() : StringPool::share(skeletonData->_strings[index - 1]);
 }
 
 float SkeletonBinary::readFloat(DataInput *input) {
@@ -502,9 +573,9 @@ Skin *SkeletonBinary::readSkin(DataInput *input, bool defaultSkin, SkeletonData
 	if (defaultSkin) {
 		slotCount = readVarint(input, true);
 		if (slotCount == 0) return NULL;
-		skin = new (__FILE__, __LINE__) Skin("default");
+		skin = new (__FILE__, __LINE__) Skin(skeletonData->_names.atom("default"));
 	} else {
-		skin = new (__FILE__, __LINE__) Skin(String(readString(input), true));
+		skin = new (__FILE__, __LINE__) Skin(readName(input, skeletonData));
 
 		if (nonessential) readColor(input, skin->getColor());
 
@@ -543,10 +614,10 @@ Skin *SkeletonBinary::readSkin(DataInput *input, bool defaultSkin, SkeletonData
 	for (int i = 0; i < slotCount; ++i) {
 		int slotIndex = readVarint(input, true);
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
-			String name(readStringRef(input, skeletonData));
+			String name = readStringRef(input, skeletonData);
 			Attachment *attachment = readAttachment(input, skin, slotIndex, name, skeletonData, nonessential);
 			if (attachment)
-				skin->setAttachment(slotIndex, String(name), attachment);
+				skin->setAttachment(slotIndex, name, attachment);
 			else {
 				delete skin;
 				return NULL;
@@ -599,6 +670,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			region->getColor().set(color);
 			region->_sequence = sequence;
 			if (sequence == NULL) region->updateRegion();
+			else region->updateSequence();
 			_attachmentLoader->configureAttachment(region);
 			return region;
 		}
@@ -656,6 +728,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			if (sequence == NULL) mesh->updateRegion();
 			mesh->_hullLength = hullLength;
 			mesh->_sequence = sequence;
+			if (sequence != NULL) mesh->updateSequence();
 			if (nonessential) {
 				mesh->_edges.addAll(edges);
 				mesh->_width = width;
@@ -671,7 +744,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			Sequence *sequence = (flags & 64) != 0 ? readSequence(input) : nullptr;
 			bool inheritTimelines = (flags & 128) != 0;
 			int skinIndex = readVarint(input, true);
-			String parent(readStringRef(input, skeletonData));
+			String parent = readStringRef(input, skeletonData);
 			float width = 0, height = 0;
 			if (nonessential) {
 				width = readFloat(input) * _scale;
@@ -798,6 +871,536 @@ void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &ar
 	}
 }
 
+bool SkeletonBinary::isSkinRequired(DataInput *input) {
+	if (_requiredSkins.size() == 0) return true;
+	const unsigned char *start = input->cursor;
+	String name(readString(input), true);
+	input->cursor = start;
+	return _requiredSkins.contains(name);
+}
+
+void SkeletonBinary::skipSkin(DataInput *input, bool nonessential) {
+	SpineExtension::free(readString(input), __FILE__, __LINE__);
+	if (nonessential) input->cursor += 4;
+	/* Bones, IK, transform, path and physics constraints. */
+	for (int list = 0; list < 5; list++) {
+		for (int i = 0, n = readVarint(input, true); i < n; i++)
+			readVarint(input, true);
+	}
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			skipAttachment(input, nonessential);
+		}
+	}
+	_stripReport.skins++;
+	_stripReport.bytes += sizeof(Skin);
+}
+
+void SkeletonBinary::skipAttachment(DataInput *input, bool nonessential) {
+	int flags = readByte(input);
+	if ((flags & 8) != 0) readVarint(input, true);
+	size_t bytes = 0;
+	switch (static_cast<AttachmentType>(flags & 0x7)) {
+		case AttachmentType_Region:
+			if ((flags & 16) != 0) readVarint(input, true);
+			if ((flags & 32) != 0) input->cursor += 4;
+			if ((flags & 64) != 0) delete readSequence(input);
+			if ((flags & 128) != 0) input->cursor += 4;
+			input->cursor += 6 * 4;
+			bytes = sizeof(RegionAttachment) + 16 * sizeof(float);
+			break;
+		case AttachmentType_Boundingbox: {
+			int verticesLength = skipVertices(input, (flags & 16) != 0);
+			if (nonessential) input->cursor += 4;
+			bytes = sizeof(BoundingBoxAttachment) + verticesLength * sizeof(float);
+			break;
+		}
+		case AttachmentType_Mesh: {
+			if ((flags & 16) != 0) readVarint(input, true);
+			if ((flags & 32) != 0) input->cursor += 4;
+			if ((flags & 64) != 0) delete readSequence(input);
+			int hullLength = readVarint(input, true);
+			int verticesLength = skipVertices(input, (flags & 128) != 0);
+			input->cursor += verticesLength * 4;
+			int trianglesLength = (verticesLength - hullLength - 2) * 3;
+			for (int i = 0; i < trianglesLength; i++)
+				readVarint(input, true);
+			int edgesLength = 0;
+			if (nonessential) {
+				edgesLength = readVarint(input, true);
+				for (int i = 0; i < edgesLength; i++)
+					readVarint(input, true);
+				input->cursor += 2 * 4;
+			}
+			bytes = sizeof(MeshAttachment) + verticesLength * 3 * sizeof(float) +
+					(trianglesLength + edgesLength) * sizeof(unsigned short);
+			break;
+		}
+		case AttachmentType_Linkedmesh:
+			if ((flags & 16) != 0) readVarint(input, true);
+			if ((flags & 32) != 0) input->cursor += 4;
+			if ((flags & 64) != 0) delete readSequence(input);
+			readVarint(input, true);
+			readVarint(input, true);
+			if (nonessential) input->cursor += 2 * 4;
+			bytes = sizeof(MeshAttachment);
+			break;
+		case AttachmentType_Path: {
+			int verticesLength = skipVertices(input, (flags & 64) != 0);
+			input->cursor += verticesLength / 6 * 4;
+			if (nonessential) input->cursor += 4;
+			bytes = sizeof(PathAttachment) + (verticesLength + verticesLength / 6) * sizeof(float);
+			break;
+		}
+		case AttachmentType_Point:
+			input->cursor += 3 * 4;
+			if (nonessential) input->cursor += 4;
+			bytes = sizeof(PointAttachment);
+			break;
+		case AttachmentType_Clipping: {
+			readVarint(input, true);
+			int verticesLength = skipVertices(input, (flags & 16) != 0);
+			if (nonessential) input->cursor += 4;
+			bytes = sizeof(ClippingAttachment) + verticesLength * sizeof(float);
+			break;
+		}
+	}
+	_stripReport.attachments++;
+	_stripReport.bytes += bytes;
+}
+
+int SkeletonBinary::skipVertices(DataInput *input, bool weighted) {
+	int vertexCount = readVarint(input, true);
+	int verticesLength = vertexCount << 1;
+	if (!weighted) {
+		input->cursor += verticesLength * 4;
+		return verticesLength;
+	}
+	for (int i = 0; i < vertexCount; ++i) {
+		for (int ii = 0, boneCount = readVarint(input, true); ii < boneCount; ++ii) {
+			readVarint(input, true);
+			input->cursor += 3 * 4;
+		}
+	}
+	return verticesLength;
+}
+
+float SkeletonBinary::skipAttachmentTimeline(DataInput *input, unsigned int timelineType, int frameCount,
+											size_t &bytes) {
+	float time = 0;
+	switch (timelineType) {
+		case ATTACHMENT_DEFORM: {
+			int bezierCount = readVarint(input, true);
+			time = readFloat(input);
+			bytes += getCurveTimelineBytes(frameCount, 1, bezierCount);
+			for (int frame = 0, frameLast = frameCount - 1;; ++frame) {
+				int end = readVarint(input, true);
+				if (end != 0) {
+					readVarint(input, true);
+					input->cursor += end * 4;
+				}
+				bytes += sizeof(Vector<float>) + end * sizeof(float);
+				if (frame == frameLast) break;
+				time = readFloat(input);
+				if (readSByte(input) == CURVE_BEZIER) input->cursor += 4 * 4;
+			}
+			break;
+		}
+		case ATTACHMENT_SEQUENCE:
+			for (int frame = 0; frame < frameCount; frame++) {
+				time = readFloat(input);
+				input->cursor += 2 * 4;
+			}
+			bytes += getTimelineBytes(frameCount, SequenceTimeline::ENTRIES);
+			break;
+	}
+	return time;
+}
+
+float SkeletonBinary::skipCurveFrames(DataInput *input, int frameCount, int valueBytes, int curves) {
+	float time = readFloat(input);
+	input->cursor += valueBytes;
+	for (int frame = 1; frame < frameCount; ++frame) {
+		time = readFloat(input);
+		input->cursor += valueBytes;
+		if (readSByte(input) == CURVE_BEZIER) input->cursor += curves * 4 * 4;
+	}
+	return time;
+}
+
+void SkeletonBinary::addTimelineId(Animation *animation, PropertyId id) {
+	if (animation) animation->_timelineIds.put(id, true);
+}
+
+int SkeletonBinary::skipAnimation(DataInput *input, SkeletonData *skeletonData, Animation *animation,
+								  Vector<Vector<String> > *names, Vector<Attachment *> *attachments) {
+	size_t bytes = 0;
+	float duration = 0;
+	readVarint(input, true);
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int slotIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == SLOT_ATTACHMENT) {
+				for (int frame = 0; frame < frameCount; ++frame) {
+					duration = MathUtil::max(duration, readFloat(input));
+					String attachmentName = readStringRef(input, skeletonData);
+					if (names && !attachmentName.isEmpty() && !(*names)[slotIndex].contains(attachmentName))
+						(*names)[slotIndex].add(attachmentName);
+				}
+				addTimelineId(animation, ((PropertyId) Property_Attachment << 32) | slotIndex);
+				bytes += getTimelineBytes(frameCount, 1) + frameCount * sizeof(String);
+				continue;
+			}
+			int channels;
+			switch (timelineType) {
+				case SLOT_RGBA:
+					channels = 4;
+					addTimelineId(animation, ((PropertyId) Property_Rgb << 32) | slotIndex);
+					addTimelineId(animation, ((PropertyId) Property_Alpha << 32) | slotIndex);
+					break;
+				case SLOT_RGB:
+					channels = 3;
+					addTimelineId(animation, ((PropertyId) Property_Rgb << 32) | slotIndex);
+					break;
+				case SLOT_RGBA2:
+					channels = 7;
+					addTimelineId(animation, ((PropertyId) Property_Rgb << 32) | slotIndex);
+					addTimelineId(animation, ((PropertyId) Property_Alpha << 32) | slotIndex);
+					addTimelineId(animation, ((PropertyId) Property_Rgb2 << 32) | slotIndex);
+					break;
+				case SLOT_RGB2:
+					channels = 6;
+					addTimelineId(animation, ((PropertyId) Property_Rgb << 32) | slotIndex);
+					addTimelineId(animation, ((PropertyId) Property_Rgb2 << 32) | slotIndex);
+					break;
+				case SLOT_ALPHA:
+					channels = 1;
+					addTimelineId(animation, ((PropertyId) Property_Alpha << 32) | slotIndex);
+					break;
+				default:
+					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
+					return -1;
+			}
+			int bezierCount = readVarint(input, true);
+			duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, channels, channels));
+			bytes += getCurveTimelineBytes(frameCount, 1 + channels, bezierCount);
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int boneIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == BONE_INHERIT) {
+				for (int frame = 0; frame < frameCount; frame++) {
+					duration = MathUtil::max(duration, readFloat(input));
+					readByte(input);
+				}
+				addTimelineId(animation, ((PropertyId) Property_Inherit << 32) | boneIndex);
+				bytes += getTimelineBytes(frameCount, InheritTimeline::ENTRIES);
+				continue;
+			}
+			int values = 1;
+			switch (timelineType) {
+				case BONE_ROTATE:
+					addTimelineId(animation, ((PropertyId) Property_Rotate << 32) | boneIndex);
+					break;
+				case BONE_TRANSLATE:
+					values = 2;
+					addTimelineId(animation, ((PropertyId) Property_X << 32) | boneIndex);
+					addTimelineId(animation, ((PropertyId) Property_Y << 32) | boneIndex);
+					break;
+				case BONE_TRANSLATEX:
+					addTimelineId(animation, ((PropertyId) Property_X << 32) | boneIndex);
+					break;
+				case BONE_TRANSLATEY:
+					addTimelineId(animation, ((PropertyId) Property_Y << 32) | boneIndex);
+					break;
+				case BONE_SCALE:
+					values = 2;
+					addTimelineId(animation, ((PropertyId) Property_ScaleX << 32) | boneIndex);
+					addTimelineId(animation, ((PropertyId) Property_ScaleY << 32) | boneIndex);
+					break;
+				case BONE_SCALEX:
+					addTimelineId(animation, ((PropertyId) Property_ScaleX << 32) | boneIndex);
+					break;
+				case BONE_SCALEY:
+					addTimelineId(animation, ((PropertyId) Property_ScaleY << 32) | boneIndex);
+					break;
+				case BONE_SHEAR:
+					values = 2;
+					addTimelineId(animation, ((PropertyId) Property_ShearX << 32) | boneIndex);
+					addTimelineId(animation, ((PropertyId) Property_ShearY << 32) | boneIndex);
+					break;
+				case BONE_SHEARX:
+				case BONE_SHEARY:
+					// ShearYTimeline uses the ShearX property id.
+					addTimelineId(animation, ((PropertyId) Property_ShearX << 32) | boneIndex);
+					break;
+				default:
+					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
+					return -1;
+			}
+			int bezierCount = readVarint(input, true);
+			duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, values * 4, values));
+			bytes += getCurveTimelineBytes(frameCount, 1 + values, bezierCount);
+		}
+	}
+
+	// IK timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int index = readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		int bezierCount = readVarint(input, true);
+		for (int frame = 0; frame < frameCount; frame++) {
+			int flags = readByte(input);
+			duration = MathUtil::max(duration, readFloat(input));
+			if ((flags & 1) != 0 && (flags & 2) != 0) input->cursor += 4;
+			if ((flags & 4) != 0) input->cursor += 4;
+			if (frame > 0 && (flags & 64) == 0 && (flags & 128) != 0) input->cursor += 2 * 4 * 4;
+		}
+		addTimelineId(animation, ((PropertyId) Property_IkConstraint << 32) | index);
+		bytes += getCurveTimelineBytes(frameCount, IkConstraintTimeline::ENTRIES, bezierCount);
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int index = readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		int bezierCount = readVarint(input, true);
+		duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 6 * 4, 6));
+		addTimelineId(animation, ((PropertyId) Property_TransformConstraint << 32) | index);
+		bytes += getCurveTimelineBytes(frameCount, TransformConstraintTimeline::ENTRIES, bezierCount);
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int index = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, true);
+			int bezierCount = readVarint(input, true);
+			switch (type) {
+				case PATH_POSITION:
+				case PATH_SPACING:
+					duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 4, 1));
+					addTimelineId(animation, ((PropertyId) (type == PATH_POSITION ? Property_PathConstraintPosition
+																				  : Property_PathConstraintSpacing)
+											  << 32) | index);
+					bytes += getCurveTimelineBytes(frameCount, 2, bezierCount);
+					break;
+				case PATH_MIX:
+					duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 3 * 4, 3));
+					addTimelineId(animation, ((PropertyId) Property_PathConstraintMix << 32) | index);
+					bytes += getCurveTimelineBytes(frameCount, PathConstraintMixTimeline::ENTRIES, bezierCount);
+			}
+		}
+	}
+
+	// Physics timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; i++) {
+		int index = readVarint(input, true) - 1;
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (type == PHYSICS_RESET) {
+				for (int frame = 0; frame < frameCount; frame++)
+					duration = MathUtil::max(duration, readFloat(input));
+				addTimelineId(animation, ((PropertyId) Property_PhysicsConstraintReset) << 32);
+				bytes += getTimelineBytes(frameCount, 1);
+				continue;
+			}
+			int bezierCount = readVarint(input, true);
+			Property property;
+			switch (type) {
+				case PHYSICS_INERTIA:
+					property = Property_PhysicsConstraintInertia;
+					break;
+				case PHYSICS_STRENGTH:
+					property = Property_PhysicsConstraintStrength;
+					break;
+				case PHYSICS_DAMPING:
+					property = Property_PhysicsConstraintDamping;
+					break;
+				case PHYSICS_MASS:
+					property = Property_PhysicsConstraintMass;
+					break;
+				case PHYSICS_WIND:
+					property = Property_PhysicsConstraintWind;
+					break;
+				case PHYSICS_GRAVITY:
+					property = Property_PhysicsConstraintGravity;
+					break;
+				case PHYSICS_MIX:
+					property = Property_PhysicsConstraintMix;
+					break;
+				default:
+					continue;
+			}
+			duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 4, 1));
+			addTimelineId(animation, ((PropertyId) property << 32) | index);
+			bytes += getCurveTimelineBytes(frameCount, 2, bezierCount);
+		}
+	}
+
+	// Attachment timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		Skin *skin = (_skinTable ? *_skinTable : skeletonData->_skins)[readVarint(input, true)];
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			int slotIndex = readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				String attachmentName = readStringRef(input, skeletonData);
+				unsigned int timelineType = readByte(input);
+				int frameCount = readVarint(input, true);
+				// Timelines of skipped skins are not created either way.
+				size_t timelineBytes = 0;
+				float time = skipAttachmentTimeline(input, timelineType, frameCount, timelineBytes);
+				if (!skin) continue;
+				bytes += timelineBytes;
+				if (!animation && !names) continue;
+				Attachment *attachment = skin->getAttachment(slotIndex, attachmentName);
+				if (!attachment) {
+					setError("Attachment not found: ", attachmentName.buffer());
+					return -1;
+				}
+				if (timelineType == ATTACHMENT_DEFORM) {
+					int id = static_cast<VertexAttachment *>(attachment)->getId();
+					addTimelineId(animation, ((PropertyId) Property_Deform << 32) | ((slotIndex << 16 | id) & 0xffffffff));
+				} else if (timelineType == ATTACHMENT_SEQUENCE) {
+					int id = 0;
+					if (attachment->getRTTI().instanceOf(RegionAttachment::rtti))
+						id = static_cast<RegionAttachment *>(attachment)->getSequence()->getId();
+					if (attachment->getRTTI().instanceOf(MeshAttachment::rtti))
+						id = static_cast<MeshAttachment *>(attachment)->getSequence()->getId();
+					addTimelineId(animation, ((PropertyId) Property_Sequence << 32) | ((slotIndex << 16 | id) & 0xffffffff));
+				} else
+					continue;
+				duration = MathUtil::max(duration, time);
+				if (attachments) attachments->add(attachment);
+			}
+		}
+	}
+
+	// Draw order timeline.
+	size_t drawOrderCount = (size_t) readVarint(input, true);
+	for (size_t i = 0; i < drawOrderCount; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		for (int ii = 0, nn = readVarint(input, true) * 2; ii < nn; ++ii)
+			readVarint(input, true);
+		bytes += sizeof(float) + sizeof(Vector<int>) + skeletonData->_slots.size() * sizeof(int);
+	}
+	if (drawOrderCount > 0) {
+		addTimelineId(animation, (PropertyId) Property_DrawOrder << 32);
+		bytes += sizeof(DrawOrderTimeline);
+	}
+
+	// Event timeline.
+	int eventCount = readVarint(input, true);
+	for (int i = 0; i < eventCount; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		EventData *eventData = skeletonData->_events[readVarint(input, true)];
+		readVarint(input, false);
+		input->cursor += 4;
+		int length = readVarint(input, true);
+		if (length > 0) input->cursor += length - 1;
+		if (!eventData->_audioPath.isEmpty()) input->cursor += 2 * 4;
+		bytes += sizeof(float) + sizeof(Event);
+	}
+	if (eventCount > 0) {
+		addTimelineId(animation, (PropertyId) Property_Event << 32);
+		bytes += sizeof(EventTimeline);
+	}
+
+	if (animation) animation->_duration = duration;
+	return (int) bytes;
+}
+
+void SkeletonBinary::markReachable(Animation *animation, Vector<Vector<String> > &names, Vector<Attachment *> &attachments) {
+	Vector<Timeline *> &timelines = animation->_timelines;
+	for (size_t i = 0, n = timelines.size(); i < n; ++i) {
+		Timeline *timeline = timelines[i];
+		if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
+			AttachmentTimeline *attachmentTimeline = static_cast<AttachmentTimeline *>(timeline);
+			Vector<String> &slotNames = names[attachmentTimeline->getSlotIndex()];
+			Vector<String> &attachmentNames = attachmentTimeline->getAttachmentNames();
+			for (size_t ii = 0, nn = attachmentNames.size(); ii < nn; ++ii)
+				if (!attachmentNames[ii].isEmpty() && !slotNames.contains(attachmentNames[ii]))
+					slotNames.add(attachmentNames[ii]);
+		} else if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+			attachments.add(static_cast<DeformTimeline *>(timeline)->getAttachment());
+		} else if (timeline->getRTTI().isExactly(SequenceTimeline::rtti)) {
+			attachments.add(static_cast<SequenceTimeline *>(timeline)->getAttachment());
+		}
+	}
+}
+
+void SkeletonBinary::stripUnreachable(SkeletonData *skeletonData, Vector<Vector<String> > &names,
+									  Vector<Attachment *> &attachments) {
+	for (size_t i = 0, n = skeletonData->_slots.size(); i < n; ++i) {
+		const String &setupName = skeletonData->_slots[i]->_attachmentName;
+		if (!setupName.isEmpty()) names[i].add(setupName);
+	}
+	/* Parents of linked meshes in any kept skin must survive. */
+	for (size_t i = 0, n = skeletonData->_skins.size(); i < n; ++i) {
+		Skin::AttachmentMap::Entries entries = skeletonData->_skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Attachment *attachment = entries.next()._attachment;
+			if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+				MeshAttachment *parent = static_cast<MeshAttachment *>(attachment)->getParentMesh();
+				if (parent) attachments.add(parent);
+			}
+		}
+	}
+	for (size_t i = 0, n = skeletonData->_skins.size(); i < n; ++i) {
+		Skin *skin = skeletonData->_skins[i];
+		Vector<size_t> slotIndices;
+		Vector<String> unreachable;
+		Skin::AttachmentMap::Entries entries = skin->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (names[entry._slotIndex].contains(entry._name) || attachments.contains(entry._attachment)) continue;
+			slotIndices.add(entry._slotIndex);
+			unreachable.add(entry._name);
+			_stripReport.attachments++;
+			_stripReport.bytes += getAttachmentBytes(entry._attachment);
+		}
+		for (size_t ii = 0, nn = unreachable.size(); ii < nn; ++ii)
+			skin->removeAttachment(slotIndices[ii], unreachable[ii]);
+	}
+}
+
+size_t SkeletonBinary::getAttachmentBytes(Attachment *attachment) {
+	const RTTI &rtti = attachment->getRTTI();
+	if (rtti.isExactly(RegionAttachment::rtti)) return sizeof(RegionAttachment) + 16 * sizeof(float);
+	if (rtti.isExactly(PointAttachment::rtti)) return sizeof(PointAttachment);
+	if (!rtti.instanceOf(VertexAttachment::rtti)) return sizeof(Attachment);
+	VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(attachment);
+	size_t bytes = sizeof(MeshAttachment) + vertexAttachment->getVertices().size() * sizeof(float) +
+				   vertexAttachment->getBones().size() * sizeof(int);
+	if (rtti.isExactly(MeshAttachment::rtti)) {
+		MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+		bytes += (mesh->getUVs().size() + mesh->getRegionUVs().size()) * sizeof(float) +
+				 (mesh->getTriangles().size() + mesh->getEdges().size()) * sizeof(unsigned short);
+	}
+	return bytes;
+}
+
+size_t SkeletonBinary::getTimelineBytes(int frameCount, int frameEntries) {
+	return sizeof(Timeline) + frameCount * frameEntries * sizeof(float);
+}
+
+size_t SkeletonBinary::getCurveTimelineBytes(int frameCount, int frameEntries, int bezierCount) {
+	// Curves hold a type per frame and 18 values (CurveTimeline::BEZIER_SIZE) per bezier.
+	return getTimelineBytes(frameCount, frameEntries) + (frameCount + bezierCount * 18) * sizeof(float);
+}
+
 void SkeletonBinary::setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1,
 							   float time2,
 							   float value1, float value2, float scale) {
@@ -871,7 +1474,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 					AttachmentTimeline *timeline = new (__FILE__, __LINE__) AttachmentTimeline(frameCount, slotIndex);
 					for (int frame = 0; frame < frameCount; ++frame) {
 						float time = readFloat(input);
-						String attachmentName(readStringRef(input, skeletonData));
+						String attachmentName = readStringRef(input, skeletonData);
 						timeline->setFrame(frame, time, attachmentName);
 					}
 					timelines.add(timeline);
@@ -1324,15 +1927,21 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 	// Attachment timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
-		Skin *skin = skeletonData->_skins[readVarint(input, true)];
+		Skin *skin = (_skinTable ? *_skinTable : skeletonData->_skins)[readVarint(input, true)];
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
 			int slotIndex = readVarint(input, true);
 			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
-				const char *attachmentName = readStringRef(input, skeletonData);
-				Attachment *baseAttachment = skin->getAttachment(slotIndex, String(attachmentName));
+				String attachmentName = readStringRef(input, skeletonData);
+				if (skin == NULL) {
+					unsigned int timelineType = readByte(input);
+					size_t bytes = 0;
+					skipAttachmentTimeline(input, timelineType, readVarint(input, true), bytes);
+					continue;
+				}
+				Attachment *baseAttachment = skin->getAttachment(slotIndex, attachmentName);
 				if (!baseAttachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
-					setError("Attachment not found: ", attachmentName);
+					setError("Attachment not found: ", attachmentName.buffer());
 					return NULL;
 				}
 				unsigned int timelineType = readByte(input);
@@ -1392,6 +2001,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 							}
 							time = time2;
 						}
+						timeline->sparsify();
 
 						timelines.add(timeline);
 						break;
@@ -1486,5 +2096,14 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 	for (int i = 0, n = (int) timelines.size(); i < n; i++) {
 		duration = MathUtil::max(duration, (timelines[i])->getDuration());
 	}
+	if (_quantizeAnimations) {
+		for (int i = 0, n = (int) timelines.size(); i < n; i++) {
+			Timeline *timeline = timelines[i];
+			if (timeline->getRTTI().instanceOf(CurveTimeline1::rtti))
+				static_cast<CurveTimeline1 *>(timeline)->quantize();
+			else if (timeline->getRTTI().isExactly(DeformTimeline::rtti))
+				static_cast<DeformTimeline *>(timeline)->quantize();
+		}
+	}
 	return new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
 }
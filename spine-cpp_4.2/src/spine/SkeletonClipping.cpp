@@ -31,6 +31,10 @@
 
 #include <spine/ClippingAttachment.h>
 #include <spine/Slot.h>
+#include <spine/Bone.h>
+#include <spine/ContainerUtil.h>
+
+#include <string.h>
 
 using namespace spine;
 
@@ -41,6 +45,10 @@ SkeletonClipping::SkeletonClipping() : _clipAttachment(NULL) {
 	_clippedUVs.ensureCapacity(128);
 }
 
+SkeletonClipping::~SkeletonClipping() {
+	ContainerUtil::cleanUpVectorOfPointers(_worldPolygonPool);
+}
+
 size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 	if (_clipAttachment != NULL) {
 		return 0;
@@ -48,21 +56,76 @@ size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 
 	_clipAttachment = clip;
 
-	int n = (int) clip->getWorldVerticesLength();
-	_clippingPolygon.setSize(n, 0);
-	clip->computeWorldVertices(slot, 0, n, _clippingPolygon, 0, 2);
-	makeClockwise(_clippingPolygon);
-	_clippingPolygons = &_triangulator.decompose(_clippingPolygon, _triangulator.triangulate(_clippingPolygon));
-
-	for (size_t i = 0; i < _clippingPolygons->size(); ++i) {
-		Vector<float> *polygonP = (*_clippingPolygons)[i];
-		Vector<float> &polygon = *polygonP;
-		makeClockwise(polygon);
-		polygon.add(polygon[0]);
-		polygon.add(polygon[1]);
+	// Weighted or deformed vertices move independently, so only those need decomposing in world space each frame.
+	if (clip->getBones().size() > 0 || slot.getDeform().size() > 0) {
+		int n = (int) clip->getWorldVerticesLength();
+		_clippingPolygon.setSize(n, 0);
+		clip->computeWorldVertices(slot, 0, n, _clippingPolygon, 0, 2);
+		_clippingPolygons = &decompose(_clippingPolygon);
+		return (*_clippingPolygons).size();
 	}
 
-	return (*_clippingPolygons).size();
+	// An affine transform keeps the convex decomposition valid. A mirroring bone flips the winding, so the order is
+	// reversed to keep the polygons clockwise.
+	Vector<Vector<float> *> &convexPolygons = getConvexPolygons(clip);
+	Bone &bone = slot.getBone();
+	float x = bone.getWorldX(), y = bone.getWorldY();
+	float a = bone.getA(), b = bone.getB(), c = bone.getC(), d = bone.getD();
+	bool flip = a * d - b * c < 0;
+	size_t polygonsCount = convexPolygons.size();
+	while (_worldPolygonPool.size() < polygonsCount)
+		_worldPolygonPool.add(new (__FILE__, __LINE__) Vector<float>());
+	_worldPolygons.clear();
+	for (size_t i = 0; i < polygonsCount; ++i) {
+		Vector<float> &local = *convexPolygons[i];
+		Vector<float> &world = *_worldPolygonPool[i];
+		_worldPolygons.add(&world);
+		size_t n = local.size();
+		world.setSize(n, 0);
+		float *in = local.buffer(), *out = world.buffer();
+		for (size_t ii = 0; ii < n; ii += 2) {
+			float vx = in[ii], vy = in[ii + 1];
+			size_t o = flip ? n - 2 - ii : ii;
+			out[o] = vx * a + vy * b + x;
+			out[o + 1] = vx * c + vy * d + y;
+		}
+	}
+	_clippingPolygons = &_worldPolygons;
+	return polygonsCount;
+}
+
+Vector<Vector<float> *> &SkeletonClipping::decompose(Vector<float> &polygon) {
+	makeClockwise(polygon);
+	Vector<Vector<float> *> &polygons = _triangulator.decompose(polygon, _triangulator.triangulate(polygon));
+	for (size_t i = 0; i < polygons.size(); ++i) {
+		Vector<float> &convex = *polygons[i];
+		makeClockwise(convex);
+		convex.add(convex[0]);
+		convex.add(convex[1]);
+	}
+	return polygons;
+}
+
+Vector<Vector<float> *> &SkeletonClipping::getConvexPolygons(ClippingAttachment *clip) {
+	Vector<float> &vertices = clip->getVertices();
+	size_t n = clip->getWorldVerticesLength();
+	Vector<float> &decomposed = clip->_decomposedVertices;
+	if (decomposed.size() == n && n <= vertices.size() &&
+		(n == 0 || memcmp(decomposed.buffer(), vertices.buffer(), n * sizeof(float)) == 0))
+		return clip->_convexPolygons;
+
+	decomposed.clear();
+	for (size_t i = 0; i < n; ++i)
+		decomposed.add(vertices[i]);
+	ContainerUtil::cleanUpVectorOfPointers(clip->_convexPolygons);
+	_clippingPolygon.clearAndAddAll(decomposed);
+	Vector<Vector<float> *> &polygons = decompose(_clippingPolygon);
+	for (size_t i = 0; i < polygons.size(); ++i) {
+		Vector<float> *convex = new (__FILE__, __LINE__) Vector<float>();
+		convex->clearAndAddAll(*polygons[i]);
+		clip->_convexPolygons.add(convex);
+	}
+	return clip->_convexPolygons;
 }
 
 void SkeletonClipping::clipEnd(Slot &slot) {
@@ -363,9 +426,11 @@ bool SkeletonClipping::clip(float x1, float y1, float x2, float y2, float x3, fl
 	} else
 		originalOutput->setSize(originalOutput->size() - 2, 0);
 
+	// Only touching the clipping area leaves less than a triangle. That is clipped away, not inside, which false would
+	// make clipTriangles draw the whole triangle.
 	if (originalOutput->size() < 6) {
 		originalOutput->clear();
-		return false;
+		return true;
 	}
 	return clipped;
 }
@@ -30,6 +30,7 @@
 #include <spine/SkeletonData.h>
 
 #include <spine/Animation.h>
+#include <spine/AnimationCache.h>
 #include <spine/BoneData.h>
 #include <spine/EventData.h>
 #include <spine/IkConstraintData.h>
@@ -52,6 +53,7 @@ SkeletonData::SkeletonData() : _name(),
 							   _referenceScale(100),
 							   _version(),
 							   _hash(),
+							   _animationCache(NULL),
 							   _fps(0),
 							   _imagesPath() {
 }
@@ -69,45 +71,43 @@ SkeletonData::~SkeletonData() {
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_physicsConstraints);
-	for (size_t i = 0; i < _strings.size(); i++) {
-		SpineExtension::free(_strings[i], __FILE__, __LINE__);
-	}
+	delete _animationCache;
 }
 
 BoneData *SkeletonData::findBone(const String &boneName) {
-	return ContainerUtil::findWithName(_bones, boneName);
+	return ContainerUtil::findWithName(_bones, _names.lookup(boneName));
 }
 
 SlotData *SkeletonData::findSlot(const String &slotName) {
-	return ContainerUtil::findWithName(_slots, slotName);
+	return ContainerUtil::findWithName(_slots, _names.lookup(slotName));
 }
 
 Skin *SkeletonData::findSkin(const String &skinName) {
-	return ContainerUtil::findWithName(_skins, skinName);
+	return ContainerUtil::findWithName(_skins, _names.lookup(skinName));
 }
 
 spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
-	return ContainerUtil::findWithName(_events, eventDataName);
+	return ContainerUtil::findWithName(_events, _names.lookup(eventDataName));
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	return ContainerUtil::findWithName(_animations, _names.lookup(animationName));
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_ikConstraints, constraintName);
+	return ContainerUtil::findWithName(_ikConstraints, _names.lookup(constraintName));
 }
 
 TransformConstraintData *SkeletonData::findTransformConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_transformConstraints, constraintName);
+	return ContainerUtil::findWithName(_transformConstraints, _names.lookup(constraintName));
 }
 
 PathConstraintData *SkeletonData::findPathConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_pathConstraints, constraintName);
+	return ContainerUtil::findWithName(_pathConstraints, _names.lookup(constraintName));
 }
 
 PhysicsConstraintData *SkeletonData::findPhysicsConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_physicsConstraints, constraintName);
+	return ContainerUtil::findWithName(_physicsConstraints, _names.lookup(constraintName));
 }
 
 const String &SkeletonData::getName() {
@@ -146,6 +146,10 @@ Vector<Animation *> &SkeletonData::getAnimations() {
 	return _animations;
 }
 
+AnimationCache *SkeletonData::getAnimationCache() {
+	return _animationCache;
+}
+
 Vector<IkConstraintData *> &SkeletonData::getIkConstraints() {
 	return _ikConstraints;
 }
@@ -242,3 +246,7 @@ float SkeletonData::getFps() {
 void SkeletonData::setFps(float inValue) {
 	_fps = inValue;
 }
+
+StringPool &SkeletonData::getNames() {
+	return _names;
+}
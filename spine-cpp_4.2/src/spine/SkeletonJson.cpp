@@ -189,7 +189,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			}
 		}
 
-		data = new (__FILE__, __LINE__) BoneData(bonesCount, Json::getString(boneMap, "name", 0), parent);
+		data = new (__FILE__, __LINE__) BoneData(bonesCount, skeletonData->_names.atom(Json::getString(boneMap, "name", 0)), parent);
 
 		data->_length = Json::getFloat(boneMap, "length", 0) * _scale;
 		data->_x = Json::getFloat(boneMap, "x", 0) * _scale;
@@ -242,7 +242,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 				return NULL;
 			}
 
-			String slotName = String(Json::getString(slotMap, "name", 0));
+			String slotName = skeletonData->_names.atom(Json::getString(slotMap, "name", 0));
 			data = new (__FILE__, __LINE__) SlotData(i, slotName, *boneData);
 
 			color = Json::getString(slotMap, "color", 0);
@@ -265,7 +265,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			}
 
 			item = Json::getItem(slotMap, "attachment");
-			if (item) data->setAttachmentName(item->_valueString);
+			if (item) data->setAttachmentName(skeletonData->_names.atom(item->_valueString));
 
 			item = Json::getItem(slotMap, "blend");
 			if (item) {
@@ -290,7 +290,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			const char *targetName;
 
 			IkConstraintData *data = new (__FILE__, __LINE__) IkConstraintData(
-					Json::getString(constraintMap, "name", 0));
+					skeletonData->_names.atom(Json::getString(constraintMap, "name", 0)));
 			data->setOrder(Json::getInt(constraintMap, "order", 0));
 			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
 
@@ -335,7 +335,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			const char *name;
 
 			TransformConstraintData *data = new (__FILE__, __LINE__) TransformConstraintData(
-					Json::getString(constraintMap, "name", 0));
+					skeletonData->_names.atom(Json::getString(constraintMap, "name", 0)));
 			data->setOrder(Json::getInt(constraintMap, "order", 0));
 			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
 
@@ -390,7 +390,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			const char *item;
 
 			PathConstraintData *data = new (__FILE__, __LINE__) PathConstraintData(
-					Json::getString(constraintMap, "name", 0));
+					skeletonData->_names.atom(Json::getString(constraintMap, "name", 0)));
 			data->setOrder(Json::getInt(constraintMap, "order", 0));
 			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
 
@@ -461,7 +461,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			const char *name;
 
 			PhysicsConstraintData *data = new (__FILE__, __LINE__) PhysicsConstraintData(
-					Json::getString(constraintMap, "name", 0));
+					skeletonData->_names.atom(Json::getString(constraintMap, "name", 0)));
 			data->setOrder(Json::getInt(constraintMap, "order", 0));
 			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
 
@@ -510,7 +510,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			Json *attachmentsMap;
 			Json *curves;
 
-			Skin *skin = new (__FILE__, __LINE__) Skin(Json::getString(skinMap, "name", ""));
+			Skin *skin = new (__FILE__, __LINE__) Skin(skeletonData->_names.atom(Json::getString(skinMap, "name", "")));
 
 			Json *item = Json::getItem(skinMap, "bones");
 			if (item) {
@@ -591,9 +591,9 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 
 					for (attachmentMap = attachmentsMap->_child; attachmentMap; attachmentMap = attachmentMap->_next) {
 						Attachment *attachment = NULL;
-						const char *skinAttachmentName = attachmentMap->_name;
-						const char *attachmentName = Json::getString(attachmentMap, "name", skinAttachmentName);
-						const char *attachmentPath = Json::getString(attachmentMap, "path", attachmentName);
+						String skinAttachmentName = skeletonData->_names.atom(attachmentMap->_name);
+						String attachmentName = skeletonData->_names.atom(Json::getString(attachmentMap, "name", attachmentMap->_name));
+						String attachmentPath = skeletonData->_names.atom(Json::getString(attachmentMap, "path", attachmentName.buffer()));
 						const char *color;
 						Json *entry;
 
@@ -624,7 +624,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 								attachment = _attachmentLoader->newRegionAttachment(*skin, attachmentName, attachmentPath, sequence);
 								if (!attachment) {
 									delete skeletonData;
-									setError(root, "Error reading attachment: ", skinAttachmentName);
+									setError(root, "Error reading attachment: ", skinAttachmentName.buffer());
 									return NULL;
 								}
 
@@ -643,7 +643,8 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 								color = Json::getString(attachmentMap, "color", 0);
 								if (color) toColor(region->getColor(), color, true);
 
-								if (region->_region != NULL) region->updateRegion();
+								if (sequence != NULL) region->updateSequence();
+								else if (region->_region != NULL) region->updateRegion();
 								_attachmentLoader->configureAttachment(region);
 								break;
 							}
@@ -654,7 +655,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 
 								if (!attachment) {
 									delete skeletonData;
-									setError(root, "Error reading attachment: ", skinAttachmentName);
+									setError(root, "Error reading attachment: ", skinAttachmentName.buffer());
 									return NULL;
 								}
 
@@ -686,7 +687,8 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 
 									readVertices(attachmentMap, mesh, verticesLength);
 
-									if (mesh->_region != NULL) mesh->updateRegion();
+									if (sequence != NULL) mesh->updateSequence();
+									else if (mesh->_region != NULL) mesh->updateRegion();
 
 									mesh->_hullLength = Json::getInt(attachmentMap, "hull", 0);
 
@@ -701,11 +703,11 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 								} else {
 									bool inheritTimelines = Json::getInt(attachmentMap, "timelines", 1) ? true : false;
 									LinkedMesh *linkedMesh = new (__FILE__, __LINE__) LinkedMesh(mesh,
-																								 String(Json::getString(
+																								 skeletonData->_names.atom(Json::getString(
 																										 attachmentMap,
 																										 "skin", 0)),
 																								 slot->getIndex(),
-																								 String(entry->_valueString),
+																								 skeletonData->_names.atom(entry->_valueString),
 																								 inheritTimelines);
 									_linkedMeshes.add(linkedMesh);
 								}
@@ -801,7 +803,8 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		linkedMesh->_mesh->_timelineAttachment = linkedMesh->_inheritTimeline ? static_cast<VertexAttachment *>(parent)
 																			  : linkedMesh->_mesh;
 		linkedMesh->_mesh->setParentMesh(static_cast<MeshAttachment *>(parent));
-		if (linkedMesh->_mesh->_region != NULL) linkedMesh->_mesh->updateRegion();
+		if (linkedMesh->_mesh->_sequence != NULL) linkedMesh->_mesh->updateSequence();
+		else if (linkedMesh->_mesh->_region != NULL) linkedMesh->_mesh->updateRegion();
 		_attachmentLoader->configureAttachment(linkedMesh->_mesh);
 	}
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
@@ -814,7 +817,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		skeletonData->_events.ensureCapacity(events->_size);
 		skeletonData->_events.setSize(events->_size, 0);
 		for (eventMap = events->_child, i = 0; eventMap; eventMap = eventMap->_next, ++i) {
-			EventData *eventData = new (__FILE__, __LINE__) EventData(String(eventMap->_name));
+			EventData *eventData = new (__FILE__, __LINE__) EventData(skeletonData->_names.atom(eventMap->_name));
 
 			eventData->_intValue = Json::getInt(eventMap, "int", 0);
 			eventData->_floatValue = Json::getFloat(eventMap, "float", 0);
@@ -969,7 +972,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 				AttachmentTimeline *timeline = new (__FILE__, __LINE__) AttachmentTimeline(frames, slotIndex);
 				for (keyMap = timelineMap->_child, frame = 0; keyMap; keyMap = keyMap->_next, ++frame) {
 					timeline->setFrame(frame, Json::getFloat(keyMap, "time", 0),
-									   Json::getItem(keyMap, "name") ? Json::getItem(keyMap, "name")->_valueString : NULL);
+									   skeletonData->_names.atom(Json::getItem(keyMap, "name") ? Json::getItem(keyMap, "name")->_valueString : NULL));
 				}
 				timelines.add(timeline);
 
@@ -1467,6 +1470,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 							time = time2;
 							keyMap = nextMap;
 						}
+						timeline->sparsify();
 						timelines.add(timeline);
 					} else if (timelineName == "sequence") {
 						SequenceTimeline *timeline = new SequenceTimeline(frames, slotIndex, attachment);
@@ -1565,7 +1569,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 	float duration = 0;
 	for (size_t i = 0; i < timelines.size(); i++)
 		duration = MathUtil::max(duration, timelines[i]->getDuration());
-	return new (__FILE__, __LINE__) Animation(String(root->_name), timelines, duration);
+	return new (__FILE__, __LINE__) Animation(skeletonData->_names.atom(root->_name), timelines, duration);
 }
 
 void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachment, size_t verticesLength) {
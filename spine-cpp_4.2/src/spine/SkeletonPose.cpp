@@ -0,0 +1,332 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/SkeletonPose.h>
+
+#include <spine/Bone.h>
+#include <spine/IkConstraint.h>
+#include <spine/PathConstraint.h>
+#include <spine/PhysicsConstraint.h>
+#include <spine/Skeleton.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+#include <spine/TransformConstraint.h>
+
+#include <string.h>
+
+using namespace spine;
+
+#define SKELETON_FLOATS 9
+#define BONE_FLOATS 13
+#define SLOT_FLOATS 8
+#define IK_FLOATS 2
+#define TRANSFORM_FLOATS 6
+#define PATH_FLOATS 5
+#define PHYSICS_FLOATS 23
+
+#define BONE_INTS 1
+#define SLOT_INTS 3
+#define IK_INTS 3
+#define PHYSICS_INTS 1
+
+SkeletonPose::SkeletonPose() : _data(NULL), _skin(NULL), _boneCount(0), _slotCount(0), _ikCount(0), _transformCount(0), _pathCount(0),
+							   _physicsCount(0) {
+}
+
+SkeletonPose::~SkeletonPose() {
+}
+
+void SkeletonPose::capture(Skeleton &skeleton) {
+	Vector<Bone *> &bones = skeleton._bones;
+	Vector<Slot *> &slots = skeleton._slots;
+	Vector<Slot *> &drawOrder = skeleton._drawOrder;
+	Vector<IkConstraint *> &ikConstraints = skeleton._ikConstraints;
+	Vector<TransformConstraint *> &transformConstraints = skeleton._transformConstraints;
+	Vector<PathConstraint *> &pathConstraints = skeleton._pathConstraints;
+	Vector<PhysicsConstraint *> &physicsConstraints = skeleton._physicsConstraints;
+	_data = skeleton._data;
+	_skin = skeleton._skin;
+	_boneCount = bones.size();
+	_slotCount = slots.size();
+	_ikCount = ikConstraints.size();
+	_transformCount = transformConstraints.size();
+	_pathCount = pathConstraints.size();
+	_physicsCount = physicsConstraints.size();
+
+	size_t deformCount = 0;
+	for (size_t i = 0; i < _slotCount; i++)
+		deformCount += slots[i]->_deform.size();
+	_floats.setSize(SKELETON_FLOATS + _boneCount * BONE_FLOATS + _slotCount * SLOT_FLOATS + _ikCount * IK_FLOATS +
+					_transformCount * TRANSFORM_FLOATS + _pathCount * PATH_FLOATS + _physicsCount * PHYSICS_FLOATS +
+					deformCount, 0);
+	_ints.setSize(_boneCount * BONE_INTS + _slotCount * SLOT_INTS + _ikCount * IK_INTS + _physicsCount * PHYSICS_INTS, 0);
+	_attachments.setSize(_slotCount, NULL);
+	float *f = _floats.buffer();
+	int *n = _ints.buffer();
+
+	*f++ = skeleton._x;
+	*f++ = skeleton._y;
+	*f++ = skeleton._scaleX;
+	*f++ = skeleton._scaleY;
+	*f++ = skeleton._time;
+	*f++ = skeleton._color.r;
+	*f++ = skeleton._color.g;
+	*f++ = skeleton._color.b;
+	*f++ = skeleton._color.a;
+
+	for (size_t i = 0; i < _boneCount; i++) {
+		Bone &bone = *bones[i];
+		*f++ = bone._x;
+		*f++ = bone._y;
+		*f++ = bone._rotation;
+		*f++ = bone._scaleX;
+		*f++ = bone._scaleY;
+		*f++ = bone._shearX;
+		*f++ = bone._shearY;
+		*f++ = bone._a;
+		*f++ = bone._b;
+		*f++ = bone._worldX;
+		*f++ = bone._c;
+		*f++ = bone._d;
+		*f++ = bone._worldY;
+		*n++ = bone._inherit;
+	}
+
+	for (size_t i = 0; i < _slotCount; i++) {
+		Slot &slot = *slots[i];
+		*f++ = slot._color.r;
+		*f++ = slot._color.g;
+		*f++ = slot._color.b;
+		*f++ = slot._color.a;
+		*f++ = slot._darkColor.r;
+		*f++ = slot._darkColor.g;
+		*f++ = slot._darkColor.b;
+		*f++ = slot._darkColor.a;
+		*n++ = slot._sequenceIndex;
+		*n++ = (int) slot._deform.size();
+		*n++ = drawOrder[i]->_data.getIndex();
+		_attachments[i] = slot._attachment;
+	}
+
+	for (size_t i = 0; i < _ikCount; i++) {
+		IkConstraint &constraint = *ikConstraints[i];
+		*f++ = constraint.getMix();
+		*f++ = constraint.getSoftness();
+		*n++ = constraint.getBendDirection();
+		*n++ = constraint.getCompress();
+		*n++ = constraint.getStretch();
+	}
+
+	for (size_t i = 0; i < _transformCount; i++) {
+		TransformConstraint &constraint = *transformConstraints[i];
+		*f++ = constraint.getMixRotate();
+		*f++ = constraint.getMixX();
+		*f++ = constraint.getMixY();
+		*f++ = constraint.getMixScaleX();
+		*f++ = constraint.getMixScaleY();
+		*f++ = constraint.getMixShearY();
+	}
+
+	for (size_t i = 0; i < _pathCount; i++) {
+		PathConstraint &constraint = *pathConstraints[i];
+		*f++ = constraint.getPosition();
+		*f++ = constraint.getSpacing();
+		*f++ = constraint.getMixRotate();
+		*f++ = constraint.getMixX();
+		*f++ = constraint.getMixY();
+	}
+
+	for (size_t i = 0; i < _physicsCount; i++) {
+		PhysicsConstraint &constraint = *physicsConstraints[i];
+		*f++ = constraint._inertia;
+		*f++ = constraint._strength;
+		*f++ = constraint._damping;
+		*f++ = constraint._massInverse;
+		*f++ = constraint._wind;
+		*f++ = constraint._gravity;
+		*f++ = constraint._mix;
+		*f++ = constraint._ux;
+		*f++ = constraint._uy;
+		*f++ = constraint._cx;
+		*f++ = constraint._cy;
+		*f++ = constraint._tx;
+		*f++ = constraint._ty;
+		*f++ = constraint._xOffset;
+		*f++ = constraint._xVelocity;
+		*f++ = constraint._yOffset;
+		*f++ = constraint._yVelocity;
+		*f++ = constraint._rotateOffset;
+		*f++ = constraint._rotateVelocity;
+		*f++ = constraint._scaleOffset;
+		*f++ = constraint._scaleVelocity;
+		*f++ = constraint._remaining;
+		*f++ = constraint._lastTime;
+		*n++ = constraint._reset;
+	}
+
+	for (size_t i = 0; i < _slotCount; i++) {
+		Vector<float> &deform = slots[i]->_deform;
+		if (deform.size() == 0) continue;
+		memcpy(f, deform.buffer(), deform.size() * sizeof(float));
+		f += deform.size();
+	}
+}
+
+bool SkeletonPose::restore(Skeleton &skeleton) {
+	Vector<Bone *> &bones = skeleton._bones;
+	Vector<Slot *> &slots = skeleton._slots;
+	Vector<Slot *> &drawOrder = skeleton._drawOrder;
+	Vector<IkConstraint *> &ikConstraints = skeleton._ikConstraints;
+	Vector<TransformConstraint *> &transformConstraints = skeleton._transformConstraints;
+	Vector<PathConstraint *> &pathConstraints = skeleton._pathConstraints;
+	Vector<PhysicsConstraint *> &physicsConstraints = skeleton._physicsConstraints;
+	if (_data == NULL || _data != skeleton._data || _boneCount != bones.size() || _slotCount != slots.size() ||
+		_ikCount != ikConstraints.size() || _transformCount != transformConstraints.size() ||
+		_pathCount != pathConstraints.size() || _physicsCount != physicsConstraints.size())
+		return false;
+	// Switches the update cache, the attachments it sets are replaced below.
+	skeleton.setSkin(_skin);
+	const float *f = _floats.buffer();
+	const int *n = _ints.buffer();
+
+	skeleton._x = *f++;
+	skeleton._y = *f++;
+	skeleton._scaleX = *f++;
+	skeleton._scaleY = *f++;
+	skeleton._time = *f++;
+	skeleton._color.r = *f++;
+	skeleton._color.g = *f++;
+	skeleton._color.b = *f++;
+	skeleton._color.a = *f++;
+
+	for (size_t i = 0; i < _boneCount; i++) {
+		Bone &bone = *bones[i];
+		bone._x = *f++;
+		bone._y = *f++;
+		bone._rotation = *f++;
+		bone._scaleX = *f++;
+		bone._scaleY = *f++;
+		bone._shearX = *f++;
+		bone._shearY = *f++;
+		bone._a = *f++;
+		bone._b = *f++;
+		bone._worldX = *f++;
+		bone._c = *f++;
+		bone._d = *f++;
+		bone._worldY = *f++;
+		bone._inherit = (Inherit) *n++;
+	}
+
+	// Deform is stored after all fixed size state, in slot order.
+	const float *deform = f + _slotCount * SLOT_FLOATS + _ikCount * IK_FLOATS + _transformCount * TRANSFORM_FLOATS +
+			  _pathCount * PATH_FLOATS + _physicsCount * PHYSICS_FLOATS;
+	for (size_t i = 0; i < _slotCount; i++) {
+		Slot &slot = *slots[i];
+		slot._color.r = *f++;
+		slot._color.g = *f++;
+		slot._color.b = *f++;
+		slot._color.a = *f++;
+		slot._darkColor.r = *f++;
+		slot._darkColor.g = *f++;
+		slot._darkColor.b = *f++;
+		slot._darkColor.a = *f++;
+		slot._sequenceIndex = *n++;
+		// Set directly, Slot::setAttachment would clear the deform.
+		slot._attachment = _attachments[i];
+		size_t deformCount = (size_t) *n++;
+		slot._deform.setSize(deformCount, 0);
+		if (deformCount) {
+			memcpy(slot._deform.buffer(), deform, deformCount * sizeof(float));
+			deform += deformCount;
+		}
+		drawOrder[i] = slots[*n++];
+	}
+
+	for (size_t i = 0; i < _ikCount; i++) {
+		IkConstraint &constraint = *ikConstraints[i];
+		constraint.setMix(*f++);
+		constraint.setSoftness(*f++);
+		constraint.setBendDirection(*n++);
+		constraint.setCompress(*n++ != 0);
+		constraint.setStretch(*n++ != 0);
+	}
+
+	for (size_t i = 0; i < _transformCount; i++) {
+		TransformConstraint &constraint = *transformConstraints[i];
+		constraint.setMixRotate(*f++);
+		constraint.setMixX(*f++);
+		constraint.setMixY(*f++);
+		constraint.setMixScaleX(*f++);
+		constraint.setMixScaleY(*f++);
+		constraint.setMixShearY(*f++);
+	}
+
+	for (size_t i = 0; i < _pathCount; i++) {
+		PathConstraint &constraint = *pathConstraints[i];
+		constraint.setPosition(*f++);
+		constraint.setSpacing(*f++);
+		constraint.setMixRotate(*f++);
+		constraint.setMixX(*f++);
+		constraint.setMixY(*f++);
+	}
+
+	for (size_t i = 0; i < _physicsCount; i++) {
+		PhysicsConstraint &constraint = *physicsConstraints[i];
+		constraint._inertia = *f++;
+		constraint._strength = *f++;
+		constraint._damping = *f++;
+		constraint._massInverse = *f++;
+		constraint._wind = *f++;
+		constraint._gravity = *f++;
+		constraint._mix = *f++;
+		constraint._ux = *f++;
+		constraint._uy = *f++;
+		constraint._cx = *f++;
+		constraint._cy = *f++;
+		constraint._tx = *f++;
+		constraint._ty = *f++;
+		constraint._xOffset = *f++;
+		constraint._xVelocity = *f++;
+		constraint._yOffset = *f++;
+		constraint._yVelocity = *f++;
+		constraint._rotateOffset = *f++;
+		constraint._rotateVelocity = *f++;
+		constraint._scaleOffset = *f++;
+		constraint._scaleVelocity = *f++;
+		constraint._remaining = *f++;
+		constraint._lastTime = *f++;
+		constraint._reset = *n++ != 0;
+	}
+	return true;
+}
+
+size_t SkeletonPose::getBytes() {
+	return _floats.size() * sizeof(float) + _ints.size() * sizeof(int) + _attachments.size() * sizeof(Attachment *);
+}
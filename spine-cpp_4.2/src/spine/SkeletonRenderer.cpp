@@ -160,7 +160,7 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 		Vector<unsigned short> *quadIndices = &_quadIndices;
 		Vector<float> *vertices = worldVertices;
 		int32_t verticesCount;
-		Vector<float> *uvs;
+		float *uvs;
 		Vector<unsigned short> *indices;
 		int32_t indicesCount;
 		Color *attachmentColor;
@@ -179,10 +179,10 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 			worldVertices->setSize(8, 0);
 			regionAttachment->computeWorldVertices(slot, *worldVertices, 0, 2);
 			verticesCount = 4;
-			uvs = &regionAttachment->getUVs();
+			uvs = regionAttachment->getUVs(slot);
 			indices = quadIndices;
 			indicesCount = 6;
-			texture = regionAttachment->getRegion()->rendererObject;
+			texture = regionAttachment->getRegion(slot)->rendererObject;
 
 		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
 			MeshAttachment *mesh = (MeshAttachment *) attachment;
@@ -197,10 +197,10 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 			worldVertices->setSize(mesh->getWorldVerticesLength(), 0);
 			mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices->buffer(), 0, 2);
 			verticesCount = (int32_t) (mesh->getWorldVerticesLength() >> 1);
-			uvs = &mesh->getUVs();
+			uvs = mesh->getUVs(slot);
 			indices = &mesh->getTriangles();
 			indicesCount = (int32_t) indices->size();
-			texture = mesh->getRegion()->rendererObject;
+			texture = mesh->getRegion(slot)->rendererObject;
 
 		} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
 			ClippingAttachment *clip = (ClippingAttachment *) slot.getAttachment();
@@ -221,10 +221,10 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 		}
 
 		if (clipper.isClipping()) {
-			clipper.clipTriangles(*worldVertices, *indices, *uvs, 2);
+			clipper.clipTriangles(worldVertices->buffer(), indices->buffer(), indices->size(), uvs, 2);
 			vertices = &clipper.getClippedVertices();
 			verticesCount = (int32_t) (clipper.getClippedVertices().size() >> 1);
-			uvs = &clipper.getClippedUVs();
+			uvs = clipper.getClippedUVs().buffer();
 			indices = &clipper.getClippedTriangles();
 			indicesCount = (int32_t) (clipper.getClippedTriangles().size());
 		}
@@ -232,7 +232,7 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 		RenderCommand *cmd = createRenderCommand(_allocator, verticesCount, indicesCount, slot.getData().getBlendMode(), texture);
 		_renderCommands.add(cmd);
 		memcpy(cmd->positions, vertices->buffer(), (verticesCount << 1) * sizeof(float));
-		memcpy(cmd->uvs, uvs->buffer(), (verticesCount << 1) * sizeof(float));
+		memcpy(cmd->uvs, uvs, (verticesCount << 1) * sizeof(float));
 		for (int ii = 0; ii < verticesCount; ii++) {
 			cmd->colors[ii] = color;
 			cmd->darkColors[ii] = darkColor;
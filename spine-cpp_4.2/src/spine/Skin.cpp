@@ -35,11 +35,17 @@
 
 #include <spine/ConstraintData.h>
 #include <spine/Slot.h>
+#include <spine/ContainerUtil.h>
 
 #include <assert.h>
 
 using namespace spine;
 
+/// Number of old skins whose transitions each skin keeps.
+static const size_t MAX_SKIN_TRANSITIONS = 8;
+
+int Skin::_nextRevision = 0;
+
 Skin::AttachmentMap::AttachmentMap() {
 }
 
@@ -88,7 +94,8 @@ Skin::AttachmentMap::Entries Skin::AttachmentMap::getEntries() {
 	return Skin::AttachmentMap::Entries(_buckets);
 }
 
-Skin::Skin(const String &name) : _name(name), _attachments(), _color(0.99607843f, 0.61960787f, 0.30980393f, 1) {
+Skin::Skin(const String &name) : _name(name), _attachments(), _color(0.99607843f, 0.61960787f, 0.30980393f, 1),
+								  _revision(++_nextRevision) {
 	assert(_name.length() > 0);
 }
 
@@ -98,11 +105,17 @@ Skin::~Skin() {
 		Skin::AttachmentMap::Entry entry = entries.next();
 		disposeAttachment(entry._attachment);
 	}
+	ContainerUtil::cleanUpVectorOfPointers(_transitions);
+}
+
+void Skin::changed() {
+	_revision = ++_nextRevision;
 }
 
 void Skin::setAttachment(size_t slotIndex, const String &name, Attachment *attachment) {
 	assert(attachment);
 	_attachments.put(slotIndex, name, attachment);
+	changed();
 }
 
 Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
@@ -111,6 +124,7 @@ Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
 
 void Skin::removeAttachment(size_t slotIndex, const String &name) {
 	_attachments.remove(slotIndex, name);
+	changed();
 }
 
 void Skin::findNamesForSlot(size_t slotIndex, Vector<String> &names) {
@@ -140,18 +154,58 @@ Skin::AttachmentMap::Entries Skin::getAttachments() {
 }
 
 void Skin::attachAll(Skeleton &skeleton, Skin &oldSkin) {
+	SkinTransition *transition = getTransition(oldSkin);
 	Vector<Slot *> &slots = skeleton.getSlots();
+	Attachment **fromAttachments = transition->_fromAttachments.buffer();
+	Attachment **toAttachments = transition->_toAttachments.buffer();
+	for (size_t i = 0, n = transition->_slots.size(); i < n; i++) {
+		Slot *slot = slots[transition->_slots[i]];
+		if (slot->getAttachment() == fromAttachments[i]) slot->setAttachment(toAttachments[i]);
+	}
+}
+
+Skin::SkinTransition *Skin::getTransition(Skin &oldSkin) {
+	SkinTransition *transition = NULL;
+	size_t index = 0, n = _transitions.size();
+	for (; index < n; index++) {
+		if (_transitions[index]->_from == &oldSkin) {
+			transition = _transitions[index];
+			break;
+		}
+	}
+
+	if (transition) {
+		_transitions.removeAt(index);
+		if (transition->_fromRevision == oldSkin._revision && transition->_toRevision == _revision) {
+			_transitions.add(transition);
+			return transition;
+		}
+	} else {
+		if (n == MAX_SKIN_TRANSITIONS) {
+			transition = _transitions[0];
+			_transitions.removeAt(0);
+		} else
+			transition = new (__FILE__, __LINE__) SkinTransition();
+		transition->_from = &oldSkin;
+	}
+
+	// Entries are kept in the old skin's order so chained swaps between shared attachments resolve as before.
+	transition->_fromRevision = oldSkin._revision;
+	transition->_toRevision = _revision;
+	transition->_slots.clear();
+	transition->_fromAttachments.clear();
+	transition->_toAttachments.clear();
 	Skin::AttachmentMap::Entries entries = oldSkin.getAttachments();
 	while (entries.hasNext()) {
 		Skin::AttachmentMap::Entry &entry = entries.next();
-		int slotIndex = (int) entry._slotIndex;
-		Slot *slot = slots[slotIndex];
-
-		if (slot->getAttachment() == entry._attachment) {
-			Attachment *attachment = getAttachment(slotIndex, entry._name);
-			if (attachment) slot->setAttachment(attachment);
-		}
+		Attachment *attachment = getAttachment(entry._slotIndex, entry._name);
+		if (!attachment || attachment == entry._attachment) continue;
+		transition->_slots.add(entry._slotIndex);
+		transition->_fromAttachments.add(entry._attachment);
+		transition->_toAttachments.add(attachment);
 	}
+	_transitions.add(transition);
+	return transition;
 }
 
 void Skin::addSkin(Skin *other) {
@@ -166,6 +220,7 @@ void Skin::addSkin(Skin *other) {
 		AttachmentMap::Entry &entry = entries.next();
 		setAttachment(entry._slotIndex, entry._name, entry._attachment);
 	}
+	changed();
 }
 
 void Skin::copySkin(Skin *other) {
@@ -184,6 +239,7 @@ void Skin::copySkin(Skin *other) {
 		else
 			setAttachment(entry._slotIndex, entry._name, entry._attachment->copy());
 	}
+	changed();
 }
 
 Vector<ConstraintData *> &Skin::getConstraints() {
@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/StringPool.h>
+
+using namespace spine;
+
+// strings are packed into blocks of this many bytes, longer ones get a block of their own
+static const size_t BlockSize = 1024;
+
+StringPool::StringPool() : _blocks(NULL), _table(NULL), _tableSize(0), _count(0), _bytes(0) {
+}
+
+StringPool::~StringPool() {
+	while (_blocks) {
+		Block *next = _blocks->next;
+		SpineExtension::free(_blocks, __FILE__, __LINE__);
+		_blocks = next;
+	}
+	if (_table) SpineExtension::free(_table, __FILE__, __LINE__);
+}
+
+const char *StringPool::intern(const char *chars, size_t length) {
+	unsigned int stringHash = hash(chars, length);
+	const char *atom = find(chars, length, stringHash);
+	if (atom) return atom;
+	if ((_count + 1) * 2 > _tableSize) grow();
+	// the hash, then the characters and their terminating zero, 4 byte aligned
+	char *entry = allocate((sizeof(stringHash) + length + 1 + 3) & ~(size_t) 3);
+	memcpy(entry, &stringHash, sizeof(stringHash));
+	char *copy = entry + sizeof(stringHash);
+	memcpy(copy, chars, length);
+	copy[length] = '\0';
+	size_t mask = _tableSize - 1;
+	size_t i = stringHash & mask;
+	while (_table[i]) i = (i + 1) & mask;
+	_table[i] = copy;
+	_count++;
+	return copy;
+}
+
+const char *StringPool::intern(const char *chars) {
+	return chars ? intern(chars, strlen(chars)) : NULL;
+}
+
+String StringPool::atom(const char *chars, size_t length) {
+	return chars ? share(intern(chars, length)) : String();
+}
+
+String StringPool::atom(const char *chars) {
+	return chars ? share(intern(chars, strlen(chars))) : String();
+}
+
+String StringPool::atom(const String &name) {
+	return name.buffer() ? share(intern(name.buffer(), name.length())) : String();
+}
+
+String StringPool::share(const char *atom) {
+	String string;
+	if (atom) string.setPointer((char *) atom, strlen(atom), String::Storage_Atom);
+	return string;
+}
+
+String StringPool::lookup(const String &name) const {
+	const char *chars = name.buffer();
+	if (!chars) return String();
+	unsigned int nameHash = name.storage() == String::Storage_Atom ? String::atomHash(chars) : hash(chars, name.length());
+	const char *atom = find(chars, name.length(), nameHash);
+	return atom ? share(atom) : String(chars, true, false);
+}
+
+String StringPool::lookup(const char *chars) const {
+	if (!chars) return String();
+	size_t length = strlen(chars);
+	const char *atom = find(chars, length, hash(chars, length));
+	return atom ? share(atom) : String(chars, true, false);
+}
+
+size_t StringPool::getCount() {
+	return _count;
+}
+
+size_t StringPool::getBytes() {
+	return _bytes;
+}
+
+unsigned int StringPool::hash(const char *chars, size_t length) {
+	// FNV-1a
+	unsigned int value = 2166136261u;
+	for (size_t i = 0; i < length; i++) {
+		value ^= (unsigned char) chars[i];
+		value *= 16777619u;
+	}
+	return value;
+}
+
+const char *StringPool::find(const char *chars, size_t length, unsigned int hash) const {
+	if (!_count) return NULL;
+	size_t mask = _tableSize - 1;
+	for (size_t i = hash & mask; _table[i]; i = (i + 1) & mask) {
+		const char *atom = _table[i];
+		if (String::atomHash(atom) == hash && strncmp(atom, chars, length) == 0 && atom[length] == '\0') return atom;
+	}
+	return NULL;
+}
+
+char *StringPool::allocate(size_t size) {
+	if (!_blocks || _blocks->capacity - _blocks->used < size) {
+		size_t capacity = size > BlockSize / 4 ? size : BlockSize;
+		Block *block = (Block *) SpineExtension::alloc<char>(sizeof(Block) + capacity, __FILE__, __LINE__);
+		block->used = 0;
+		block->capacity = capacity;
+		_bytes += sizeof(Block) + capacity;
+		if (capacity == size && _blocks) {
+			// keep filling the current block
+			block->next = _blocks->next;
+			_blocks->next = block;
+		} else {
+			block->next = _blocks;
+			_blocks = block;
+		}
+		block->used = size;
+		return (char *) (block + 1);
+	}
+	char *memory = (char *) (_blocks + 1) + _blocks->used;
+	_blocks->used += size;
+	return memory;
+}
+
+void StringPool::grow() {
+	size_t oldSize = _tableSize;
+	const char **oldTable = _table;
+	_tableSize = oldSize ? oldSize * 2 : 64;
+	_table = SpineExtension::calloc<const char *>(_tableSize, __FILE__, __LINE__);
+	_bytes += (_tableSize - oldSize) * sizeof(const char *);
+	size_t mask = _tableSize - 1;
+	for (size_t i = 0; i < oldSize; i++) {
+		const char *atom = oldTable[i];
+		if (!atom) continue;
+		size_t slot = String::atomHash(atom) & mask;
+		while (_table[slot]) slot = (slot + 1) & mask;
+		_table[slot] = atom;
+	}
+	if (oldTable) SpineExtension::free(oldTable, __FILE__, __LINE__);
+}
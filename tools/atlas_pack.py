@@ -0,0 +1,251 @@
+"""Repacks the regions of several spine atlases into shared pages and rewrites the atlases.
+
+Every skeleton normally ships its own pages, so two characters on screen load their pages twice and
+never share a texture, which keeps SpineBatcher from merging their slots. This tool packs the
+regions of all given atlases into common pages. Regions with identical pixels are stored once, so
+parts reused between skeletons (effects, shadows, shared equipment) cost nothing extra. Each atlas
+is rewritten to reference the shared pages at the new positions, with everything else unchanged.
+
+    python tools/atlas_pack.py hero.atlas enemy.atlas npc.atlas out/ --name characters
+
+Skeletons loaded from out/ share the pages through CubicatTextureLoader, which decodes a page once
+per path (and once per content for identical files under different paths) for every SpineNode.
+Pages only mix regions whose source pages have the same settings (filter, format, pma, repeat).
+Reads spine 3.8 and 4.x atlases and non-interlaced 8 bit PNGs. Palette pages are not read: pack
+first, then convert the shared pages with atlas_palette.py.
+"""
+import argparse
+import os.path
+import struct
+import zlib
+
+from atlas_palette import PNG_SIGNATURE, read_png
+
+
+class Page:
+    def __init__(self, name):
+        self.name = name
+        # (key, raw line) in file order
+        self.attributes = []
+        self.regions = []
+
+    def get(self, key):
+        for name, line in self.attributes:
+            if name == key:
+                return line.split(':', 1)[1].strip()
+        return None
+
+    def settings(self):
+        """Everything but the size, pages with equal settings can share a packed page."""
+        return tuple(line.strip() for key, line in self.attributes if key != 'size')
+
+
+class Region:
+    def __init__(self, name_line, page):
+        self.name_line = name_line
+        self.page = page
+        self.attributes = []
+        self.x = self.y = self.width = self.height = 0
+        self.rotated = False
+        self.placement = None
+
+    def parse(self):
+        values = dict((key, line.split(':', 1)[1]) for key, line in self.attributes)
+        if 'bounds' in values:
+            self.x, self.y, self.width, self.height = [int(v) for v in values['bounds'].split(',')]
+        else:
+            self.x, self.y = [int(v) for v in values['xy'].split(',')]
+            self.width, self.height = [int(v) for v in values['size'].split(',')]
+        rotate = values.get('rotate', 'false').strip()
+        self.rotated = rotate == 'true' or rotate in ('90', '270', '-90')
+
+    def packed_size(self):
+        """Size of the region on its page, rotated regions are stored with width and height swapped."""
+        return (self.height, self.width) if self.rotated else (self.width, self.height)
+
+
+def read_atlas(path):
+    pages = []
+    page = region = None
+    with open(path, encoding='utf-8') as f:
+        for raw in f:
+            raw = raw.rstrip('\r\n')
+            line = raw.strip()
+            if not line:
+                page = region = None
+            elif ':' not in line:
+                if page is None:
+                    page = Page(line)
+                    pages.append(page)
+                else:
+                    region = Region(raw, page)
+                    page.regions.append(region)
+            else:
+                key = line.split(':', 1)[0].strip()
+                (region.attributes if region else page.attributes).append((key, raw))
+    for page in pages:
+        for region in page.regions:
+            region.parse()
+    return pages
+
+
+def write_png(path, width, height, pixels, alpha):
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body) & 0xffffffff)
+
+    channels = 4 if alpha else 3
+    raw = bytearray()
+    for y in range(height):
+        raw.append(0)
+        for pixel in pixels[y * width:(y + 1) * width]:
+            raw += bytes(pixel[:channels])
+    with open(path, 'wb') as f:
+        f.write(PNG_SIGNATURE)
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 6 if alpha else 2, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(bytes(raw), 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+class Sheet:
+    """One output page, filled with shelves: rows as tall as their first (tallest) region."""
+
+    def __init__(self, settings, max_size):
+        self.settings = settings
+        self.max_size = max_size
+        self.shelves = []  # [y, height, next x]
+        self.used_height = 0
+        self.width = self.height = 0
+        self.entries = []  # (x, y, width, height, pixels)
+        self.alpha = False
+
+    def place(self, width, height, padding):
+        for shelf in self.shelves:
+            if height <= shelf[1] and shelf[2] + width <= self.max_size:
+                x = shelf[2]
+                shelf[2] += width + padding
+                return x, shelf[0]
+        if self.used_height + height > self.max_size:
+            return None
+        self.shelves.append([self.used_height, height, width + padding])
+        y = self.used_height
+        self.used_height += height + padding
+        return 0, y
+
+    def add(self, x, y, width, height, pixels, alpha):
+        self.entries.append((x, y, width, height, pixels))
+        self.width = max(self.width, x + width)
+        self.height = max(self.height, y + height)
+        self.alpha |= alpha
+
+    def render(self):
+        pixels = [(0, 0, 0, 0)] * (self.width * self.height)
+        for x, y, width, height, block in self.entries:
+            for row in range(height):
+                start = (y + row) * self.width + x
+                pixels[start:start + width] = block[row * width:(row + 1) * width]
+        return pixels
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('atlases', nargs='+')
+    parser.add_argument('out_dir')
+    parser.add_argument('--name', default='shared', help='base name of the packed pages')
+    parser.add_argument('--max-size', type=int, default=1024, help='largest page width and height')
+    parser.add_argument('--padding', type=int, default=2, help='transparent pixels between regions')
+    args = parser.parse_args()
+
+    names = [os.path.basename(path) for path in args.atlases]
+    if len(set(names)) != len(names):
+        raise SystemExit('atlas file names must differ, they are all written to the output directory')
+    atlases = [(path, read_atlas(path)) for path in args.atlases]
+
+    # cut every region out of its page, identical blocks are packed once
+    blocks = {}
+    before = regions = 0
+    for path, pages in atlases:
+        src_dir = os.path.dirname(os.path.abspath(path))
+        for page in pages:
+            width, height, color_type, pixels = read_png(os.path.join(src_dir, page.name))
+            if pixels is None:
+                raise SystemExit('%s: palette pages are not supported, pack the RGBA pages' % page.name)
+            before += width * height * (2 if color_type == 2 else 4)
+            alpha = color_type in (4, 6)
+            for region in page.regions:
+                w, h = region.packed_size()
+                if region.x < 0 or region.y < 0 or region.x + w > width or region.y + h > height:
+                    raise SystemExit('%s lies outside %s' % (region.name_line.strip(), page.name))
+                if w > args.max_size or h > args.max_size:
+                    raise SystemExit('%s is larger than --max-size' % region.name_line.strip())
+                block = tuple(pixel for row in range(h)
+                              for pixel in pixels[(region.y + row) * width + region.x:(region.y + row) * width + region.x + w])
+                key = (page.settings(), w, h, block)
+                blocks.setdefault(key, {'alpha': False, 'regions': []})
+                blocks[key]['alpha'] |= alpha
+                blocks[key]['regions'].append(region)
+                regions += 1
+
+    # tallest first keeps the shelves tight
+    sheets = []
+    for key in sorted(blocks, key=lambda k: (k[2], k[1]), reverse=True):
+        settings, w, h, block = key
+        spot = None
+        for sheet in sheets:
+            if sheet.settings == settings:
+                spot = sheet.place(w, h, args.padding)
+                if spot:
+                    break
+        if not spot:
+            sheet = Sheet(settings, args.max_size)
+            sheets.append(sheet)
+            spot = sheet.place(w, h, args.padding)
+        sheet.add(spot[0], spot[1], w, h, block, blocks[key]['alpha'])
+        for region in blocks[key]['regions']:
+            region.placement = (sheet, spot[0], spot[1])
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    after = 0
+    for i, sheet in enumerate(sheets):
+        sheet.name = '%s%s.png' % (args.name, i + 1 if len(sheets) > 1 else '')
+        write_png(os.path.join(args.out_dir, sheet.name), sheet.width, sheet.height, sheet.render(), sheet.alpha)
+        after += sheet.width * sheet.height * (4 if sheet.alpha else 2)
+        print('%s: %dx%d, %d regions' % (sheet.name, sheet.width, sheet.height, len(sheet.entries)))
+
+    for (path, pages), name in zip(atlases, names):
+        write_atlas(os.path.join(args.out_dir, name), pages, sheets)
+    print('%d regions, %d unique, %d pages -> %d, %d KB -> %d KB decoded' % (
+        regions, len(blocks), sum(len(pages) for _, pages in atlases), len(sheets), before // 1024, after // 1024))
+
+
+def write_atlas(path, pages, sheets):
+    lines = []
+    for sheet in sheets:
+        used = [region for page in pages for region in page.regions if region.placement[0] is sheet]
+        if not used:
+            continue
+        if lines:
+            lines.append('')
+        lines.append(sheet.name)
+        # settings are the same for every source page of the sheet, the first one speaks for all
+        if used[0].page.get('size') is None:
+            lines.append('size: %d,%d' % (sheet.width, sheet.height))
+        for key, line in used[0].page.attributes:
+            if key == 'size':
+                line = line.split(':', 1)[0] + ': %d,%d' % (sheet.width, sheet.height)
+            lines.append(line)
+        for region in used:
+            _, x, y = region.placement
+            lines.append(region.name_line)
+            for key, line in region.attributes:
+                prefix = line.split(':', 1)[0]
+                if key == 'bounds':
+                    line = prefix + ': %d,%d,%d,%d' % (x, y, region.width, region.height)
+                elif key == 'xy':
+                    line = prefix + ': %d, %d' % (x, y)
+                lines.append(line)
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    main()
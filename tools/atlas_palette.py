@@ -0,0 +1,258 @@
+"""Converts the pages of a spine atlas to 8 bit palette PNGs for the indexed texture path.
+
+CubicatTextureLoader decodes palette PNGs into one byte per pixel plus a 256 entry RGB565 + alpha
+color table, instead of 4 bytes per pixel for RGBA pages (2 for RGB). Colors are quantized with
+median cut on the RGB565 grid the loader keeps, so palette entries survive the conversion exactly.
+Fully transparent pixels share one entry.
+
+    python tools/atlas_palette.py hero.atlas out/
+
+Writes the atlas and its converted pages to the output directory and prints, per page, the decoded
+size before and after and the PSNR of the quantized page. Pages that already are palette PNGs are
+copied. Only non-interlaced 8 bit PNGs are read.
+"""
+import argparse
+import math
+import os.path
+import shutil
+import struct
+import zlib
+
+PNG_SIGNATURE = b'\x89PNG\r\n\x1a\n'
+CLUT_SIZE = 256
+# RGB565 colors then 8 bit alphas, see INDEXED_CLUT_BYTES in cubicat-port/texture_loader.h
+CLUT_BYTES = CLUT_SIZE * 3
+CHANNELS = {0: 1, 2: 3, 4: 2, 6: 4}
+
+
+def read_chunks(data):
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError('not a png file')
+    offset = 8
+    while offset < len(data):
+        length, kind = struct.unpack('>I4s', data[offset:offset + 8])
+        yield kind, data[offset + 8:offset + 8 + length]
+        offset += 12 + length
+
+
+def unfilter(raw, width, height, bpp):
+    stride = width * bpp
+    rows = []
+    prev = bytearray(stride)
+    offset = 0
+    for _ in range(height):
+        kind = raw[offset]
+        row = bytearray(raw[offset + 1:offset + 1 + stride])
+        offset += 1 + stride
+        if kind == 1:
+            for i in range(bpp, stride):
+                row[i] = (row[i] + row[i - bpp]) & 0xff
+        elif kind == 2:
+            for i in range(stride):
+                row[i] = (row[i] + prev[i]) & 0xff
+        elif kind == 3:
+            for i in range(stride):
+                left = row[i - bpp] if i >= bpp else 0
+                row[i] = (row[i] + ((left + prev[i]) >> 1)) & 0xff
+        elif kind == 4:
+            for i in range(stride):
+                a = row[i - bpp] if i >= bpp else 0
+                b = prev[i]
+                c = prev[i - bpp] if i >= bpp else 0
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                row[i] = (row[i] + pred) & 0xff
+        elif kind != 0:
+            raise ValueError('bad png filter %d' % kind)
+        rows.append(row)
+        prev = row
+    return rows
+
+
+def read_png(path):
+    """Returns (width, height, color type, rgba pixels as a list of tuples)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    header = None
+    idat = bytearray()
+    palette = []
+    trans = b''
+    for kind, body in read_chunks(data):
+        if kind == b'IHDR':
+            header = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'tRNS':
+            trans = body
+        elif kind == b'IDAT':
+            idat += body
+    width, height, depth, color_type, _, _, interlace = header
+    if color_type == 3:
+        return width, height, color_type, None
+    if depth != 8 or interlace:
+        raise ValueError('only non-interlaced 8 bit pngs are supported')
+    channels = CHANNELS[color_type]
+    rows = unfilter(zlib.decompress(bytes(idat)), width, height, channels)
+    pixels = []
+    for row in rows:
+        for x in range(0, len(row), channels):
+            if color_type == 6:
+                pixels.append(tuple(row[x:x + 4]))
+            elif color_type == 2:
+                pixels.append((row[x], row[x + 1], row[x + 2], 255))
+            elif color_type == 4:
+                pixels.append((row[x], row[x], row[x], row[x + 1]))
+            else:
+                pixels.append((row[x], row[x], row[x], 255))
+    return width, height, color_type, pixels
+
+
+def write_png(path, width, height, palette, indices):
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body) & 0xffffffff)
+
+    raw = bytearray()
+    for y in range(height):
+        raw.append(0)
+        raw += bytes(indices[y * width:(y + 1) * width])
+    alphas = [color[3] for color in palette]
+    while alphas and alphas[-1] == 255:
+        alphas.pop()
+    with open(path, 'wb') as f:
+        f.write(PNG_SIGNATURE)
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 3, 0, 0, 0)))
+        f.write(chunk(b'PLTE', bytes(c for color in palette for c in color[:3])))
+        if alphas:
+            f.write(chunk(b'tRNS', bytes(alphas)))
+        f.write(chunk(b'IDAT', zlib.compress(bytes(raw), 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def to_grid(color):
+    """Snaps a color to what the loader keeps: RGB565 expanded back to 8 bits, 8 bit alpha."""
+    r, g, b, a = color
+    if a == 0:
+        return 0, 0, 0, 0
+    r, g, b = r >> 3, g >> 2, b >> 3
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), a
+
+
+def box_split(histogram, box):
+    """(score, channel) of the box's best split: the widest channel weighted by the pixels in the box."""
+    if len(box) < 2:
+        return 0, 0
+    weight = sum(histogram[color] for color in box)
+    best = (0, 0)
+    for channel in range(4):
+        values = [color[channel] for color in box]
+        best = max(best, ((max(values) - min(values)) * weight, channel))
+    return best
+
+
+def median_cut(histogram, count):
+    """Splits the colors into at most count boxes, returns a list of lists of colors."""
+    box = list(histogram)
+    boxes = [(box, box_split(histogram, box))]
+    while len(boxes) < count:
+        best = max(range(len(boxes)), key=lambda i: boxes[i][1][0])
+        box, (score, channel) = boxes[best]
+        if score == 0:
+            break
+        box = sorted(box, key=lambda color: color[channel])
+        half = sum(histogram[color] for color in box) / 2
+        total, split = 0, 1
+        for i, color in enumerate(box[:-1]):
+            total += histogram[color]
+            if total >= half:
+                split = i + 1
+                break
+        low, high = box[:split], box[split:]
+        boxes[best:best + 1] = [(low, box_split(histogram, low)), (high, box_split(histogram, high))]
+    return [box for box, _ in boxes]
+
+
+def quantize(pixels, colors):
+    histogram = {}
+    for pixel in pixels:
+        color = to_grid(pixel)
+        histogram[color] = histogram.get(color, 0) + 1
+    palette = []
+    lookup = {}
+    for box in median_cut(histogram, colors):
+        weight = sum(histogram[color] for color in box)
+        mean = [sum(color[c] * histogram[color] for color in box) / weight for c in range(4)]
+        entry = to_grid(tuple(int(round(v)) for v in mean))
+        for color in box:
+            lookup[color] = len(palette)
+        palette.append(entry)
+    return palette, [lookup[to_grid(pixel)] for pixel in pixels]
+
+
+def premultiply(color):
+    a = color[3]
+    return color[0] * a / 255, color[1] * a / 255, color[2] * a / 255, a
+
+
+def psnr(pixels, palette, indices):
+    """Over premultiplied colors, so the color of transparent pixels doesn't count."""
+    error = 0
+    for pixel, index in zip(pixels, indices):
+        error += sum((a - b) ** 2 for a, b in zip(premultiply(pixel), premultiply(palette[index])))
+    if error == 0:
+        return float('inf')
+    return 10 * math.log10(255 * 255 * 4 * len(pixels) / error)
+
+
+def atlas_pages(path):
+    """Page file names: the first line of the file and every line after a blank one."""
+    pages = []
+    expect_page = True
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                expect_page = True
+            elif expect_page:
+                pages.append(line)
+                expect_page = False
+    return pages
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('atlas')
+    parser.add_argument('out_dir')
+    parser.add_argument('--colors', type=int, default=CLUT_SIZE, help='palette entries per page, at most 256')
+    args = parser.parse_args()
+    colors = max(2, min(CLUT_SIZE, args.colors))
+
+    src_dir = os.path.dirname(os.path.abspath(args.atlas))
+    os.makedirs(args.out_dir, exist_ok=True)
+    shutil.copy(args.atlas, os.path.join(args.out_dir, os.path.basename(args.atlas)))
+    before_total = after_total = 0
+    for page in atlas_pages(args.atlas):
+        src = os.path.join(src_dir, page)
+        dst = os.path.join(args.out_dir, page)
+        os.makedirs(os.path.dirname(os.path.abspath(dst)), exist_ok=True)
+        width, height, color_type, pixels = read_png(src)
+        after = width * height + CLUT_BYTES
+        if pixels is None:
+            shutil.copy(src, dst)
+            print('%s: already a palette png, %d KB' % (page, after // 1024))
+            before_total += after
+            after_total += after
+            continue
+        # the loader keeps RGB pages as RGB565 and everything else as RGBA8888
+        before = width * height * (2 if color_type == 2 else 4)
+        palette, indices = quantize(pixels, colors)
+        write_png(dst, width, height, palette, indices)
+        print('%s: %d colors, %d KB -> %d KB, PSNR %.1f dB' % (
+            page, len(palette), before // 1024, after // 1024, psnr(pixels, palette, indices)))
+        before_total += before
+        after_total += after
+    print('total: %d KB -> %d KB' % (before_total // 1024, after_total // 1024))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,23 @@
+// Cost of applying deform keys with and without sparse storage, for the mesh sizes of face and lip sync
+// rigs. Needs the component built with CONFIG_SPINE_BENCH on (menuconfig, Spine benchmarks). Copy next
+// to spine_api.js and load it after spine_api.js.
+let BENCH_APPLIES = 2000;
+// [vertices, moved vertices]
+let BENCH_MESHES = [[500, 500], [500, 60], [500, 10], [100, 20]];
+
+function benchDeformRun() {
+    for (let i = 0; i < BENCH_MESHES.length; i++) {
+        let vertices = BENCH_MESHES[i][0];
+        let moved = BENCH_MESHES[i][1];
+        let dense = spine.benchDeform(vertices, moved, BENCH_APPLIES, false);
+        let sparse = spine.benchDeform(vertices, moved, BENCH_APPLIES, true);
+        if (dense < 0 || sparse < 0) {
+            print("sparse deform keys need spine 4.2");
+            return;
+        }
+        print(vertices, "vertices,", moved, "moved:", dense / BENCH_APPLIES, "us dense,",
+              sparse / BENCH_APPLIES, "us sparse per apply");
+    }
+}
+
+benchDeformRun();
@@ -0,0 +1,36 @@
+// Cost of producing a pose as 16 bit fixed point vertices against floats, and how far the fixed point
+// vertices drift from the float ones. Needs the component built with CONFIG_SPINE_BENCH on (menuconfig,
+// Spine benchmarks). Copy next to spine_api.js, load it after spine_api.js and point the settings below
+// at a skeleton on the device. tools/host/fixed_point_check makes the same error check on a desktop,
+// for every animation and under moved and rotated nodes.
+let BENCH_SKEL = "/spiffs/spineboy.skel";
+let BENCH_ATLAS = "/spiffs/spineboy.atlas";
+let BENCH_ANIMATION = "walk";
+let BENCH_FRAMES = 60;
+let BENCH_PASSES = 200;
+// half a step of the 1/16 pixel positions and of the 1/32768 UVs, in millionths, plus float rounding
+let POSITION_BOUND = 1000000 / 32 + 1000;
+let UV_BOUND = 1000000 / 65536 + 1;
+
+function benchFixedPointRun() {
+    let node = spine.createSpine();
+    spine.SpineNode_loadWithBinaryFile(node, BENCH_SKEL, BENCH_ATLAS, 1.0);
+    let animation = spine.SpineNode_findAnimation(node, BENCH_ANIMATION);
+    if (animation < 0) {
+        print("animation not found:", BENCH_ANIMATION);
+        return;
+    }
+    spine.SpineNode_setAnimationById(node, 0, animation, true);
+
+    let worstPosition = spine.fixedPointError(node, BENCH_FRAMES, false);
+    let worstUV = spine.fixedPointError(node, BENCH_FRAMES, true);
+    print("position error:", worstPosition / 1000000, "px", worstPosition <= POSITION_BOUND ? "PASS" : "FAIL");
+    print("uv error:", worstUV / 1000000, worstUV <= UV_BOUND ? "PASS" : "FAIL");
+
+    let floats = spine.benchFixedVertices(node, BENCH_PASSES, false);
+    let fixed = spine.benchFixedVertices(node, BENCH_PASSES, true);
+    print("float:", floats / BENCH_PASSES, "us per pose");
+    print("fixed:", fixed / BENCH_PASSES, "us per pose");
+}
+
+benchFixedPointRun();
@@ -0,0 +1,552 @@
+// Host check of AnimationState's typed timeline dispatch against the virtual Timeline::apply calls it
+// replaced. build.sh links this file twice: apply_check with the runtime as it is, and apply_check_virtual
+// with AnimationState.cpp built with SPINE_VIRTUAL_TIMELINES, which sends every timeline through its
+// virtual apply as before. The rig and its animations are built here from the seed, with a timeline of
+// every type and linear, stepped and bezier curves. Each frame randomly sets, queues, empties or clears
+// animations on several tracks, with random alphas, blends, mix durations, thresholds, reverse, hold
+// previous and shortest rotation, then applies the state and also poses the skeleton with applyAt. The
+// local and world pose of every bone, the color, attachment and deform of every slot, the draw order,
+// every constraint's mixes and the events fired must be bit for bit the same for both builds. Both report
+// the time spent in AnimationState::apply. Exits with 1 on the first difference. See build.sh.
+//
+//     apply_check_virtual --write virtual.pose [seed, default 1] [frames, default 3000]
+//     apply_check --compare virtual.pose [seed] [frames]
+#include <spine/spine.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace spine;
+
+#define BONES 16
+#define ANIMATIONS 10
+#define TRACKS 4
+#define MESH_VERTICES 6
+
+SpineExtension *spine::getDefaultExtension() {
+    return new DefaultSpineExtension();
+}
+
+static float randomRange(float min, float max) {
+    return min + (max - min) * (float) rand() / (float) RAND_MAX;
+}
+
+static bool chance(int percent) {
+    return rand() % 100 < percent;
+}
+
+// every attachment in the rig, a slot's attachment is written as its index here
+static std::vector<Attachment *> attachments;
+
+enum Curve {
+    Curve_Linear,
+    Curve_Stepped,
+    Curve_Bezier
+};
+
+// random key times and values, with the curve of each key, for a timeline of `values` curve values
+struct Keys {
+    Keys(int values, float duration) : values(values) {
+        int count = 2 + rand() % 5;
+        for (int i = 0; i < count; ++i) {
+            times.push_back(duration * i / (count - 1));
+            curves.push_back(i == count - 1 ? Curve_Linear : (Curve) (rand() % 3));
+            for (int v = 0; v < values; ++v)
+                keyValues.push_back(randomRange(-1, 1));
+        }
+    }
+    size_t count() const {
+        return times.size();
+    }
+    size_t bezierCount() const {
+        size_t beziers = 0;
+        for (int curve : curves)
+            beziers += curve == Curve_Bezier ? values : 0;
+        return beziers;
+    }
+    float value(size_t key, int v, float scale = 1, float offset = 0) const {
+        return keyValues[key * values + v] * scale + offset;
+    }
+    // after the frames are set, the deform timeline curves its 0 to 1 progress instead of the values
+    void setCurves(CurveTimeline &timeline, float scale = 1, float offset = 0, bool progress = false) const {
+        size_t bezier = 0;
+        for (size_t i = 0; i + 1 < count(); ++i) {
+            if (curves[i] == Curve_Stepped) {
+                timeline.setStepped(i);
+            } else if (curves[i] == Curve_Bezier) {
+                float time1 = times[i], time2 = times[i + 1], span = time2 - time1;
+                for (int v = 0; v < values; ++v) {
+                    float value1 = progress ? 0 : value(i, v, scale, offset);
+                    float value2 = progress ? 1 : value(i + 1, v, scale, offset);
+                    timeline.setBezier(bezier++, i, v, time1, value1, time1 + span * randomRange(0, 0.5f),
+                                       value1 + (value2 - value1) * randomRange(-0.5f, 1.5f),
+                                       time2 - span * randomRange(0, 0.5f),
+                                       value2 + (value1 - value2) * randomRange(-0.5f, 1.5f), time2, value2);
+                }
+            }
+        }
+    }
+    int values;
+    std::vector<float> times;
+    std::vector<int> curves;
+    std::vector<float> keyValues;
+};
+
+static void addBoneTimeline(Vector<Timeline *> &timelines, float duration) {
+    int bone = rand() % BONES;
+    int type = rand() % 10;
+    // rotations, translations, scales and shears in their own ranges
+    static const float scales[] = {180, 50, 50, 50, 1, 1, 1, 30, 30, 30};
+    static const float offsets[] = {0, 0, 0, 0, 1, 1, 1, 0, 0, 0};
+    int values = type == 1 || type == 4 || type == 7 ? 2 : 1;
+    Keys keys(values, duration);
+    float scale = scales[type], offset = offsets[type];
+    CurveTimeline1 *timeline1 = NULL;
+    CurveTimeline2 *timeline2 = NULL;
+    switch (type) {
+        case 0: timeline1 = new (__FILE__, __LINE__) RotateTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 1: timeline2 = new (__FILE__, __LINE__) TranslateTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 2: timeline1 = new (__FILE__, __LINE__) TranslateXTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 3: timeline1 = new (__FILE__, __LINE__) TranslateYTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 4: timeline2 = new (__FILE__, __LINE__) ScaleTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 5: timeline1 = new (__FILE__, __LINE__) ScaleXTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 6: timeline1 = new (__FILE__, __LINE__) ScaleYTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 7: timeline2 = new (__FILE__, __LINE__) ShearTimeline(keys.count(), keys.bezierCount(), bone); break;
+        case 8: timeline1 = new (__FILE__, __LINE__) ShearXTimeline(keys.count(), keys.bezierCount(), bone); break;
+        default: timeline1 = new (__FILE__, __LINE__) ShearYTimeline(keys.count(), keys.bezierCount(), bone); break;
+    }
+    for (size_t i = 0; i < keys.count(); ++i) {
+        if (timeline1)
+            timeline1->setFrame(i, keys.times[i], keys.value(i, 0, scale, offset));
+        else
+            timeline2->setFrame(i, keys.times[i], keys.value(i, 0, scale, offset), keys.value(i, 1, scale, offset));
+    }
+    CurveTimeline *timeline = timeline1 ? (CurveTimeline *) timeline1 : timeline2;
+    keys.setCurves(*timeline, scale, offset);
+    timelines.add(timeline);
+}
+
+// colors stay in 0 to 1
+static void addSlotTimeline(Vector<Timeline *> &timelines, float duration) {
+    int slot = rand() % BONES;
+    switch (rand() % 4) {
+        case 0: {
+            Keys keys(4, duration);
+            RGBATimeline *timeline = new (__FILE__, __LINE__) RGBATimeline(keys.count(), keys.bezierCount(), slot);
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame((int) i, keys.times[i], keys.value(i, 0, 0.5f, 0.5f), keys.value(i, 1, 0.5f, 0.5f),
+                                   keys.value(i, 2, 0.5f, 0.5f), keys.value(i, 3, 0.5f, 0.5f));
+            keys.setCurves(*timeline, 0.5f, 0.5f);
+            timelines.add(timeline);
+            break;
+        }
+        case 1: {
+            // not one of the typed timelines, virtual in both builds
+            Keys keys(3, duration);
+            RGBTimeline *timeline = new (__FILE__, __LINE__) RGBTimeline(keys.count(), keys.bezierCount(), slot);
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame((int) i, keys.times[i], keys.value(i, 0, 0.5f, 0.5f), keys.value(i, 1, 0.5f, 0.5f),
+                                   keys.value(i, 2, 0.5f, 0.5f));
+            keys.setCurves(*timeline, 0.5f, 0.5f);
+            timelines.add(timeline);
+            break;
+        }
+        case 2: {
+            Keys keys(1, duration);
+            AlphaTimeline *timeline = new (__FILE__, __LINE__) AlphaTimeline(keys.count(), keys.bezierCount(), slot);
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame(i, keys.times[i], keys.value(i, 0, 0.5f, 0.5f));
+            keys.setCurves(*timeline, 0.5f, 0.5f);
+            timelines.add(timeline);
+            break;
+        }
+        default: {
+            Keys keys(0, duration);
+            AttachmentTimeline *timeline = new (__FILE__, __LINE__) AttachmentTimeline(keys.count(), slot);
+            static const char *names[] = {"a", "b", "mesh", ""};
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame((int) i, keys.times[i], names[rand() % 4]);
+            timelines.add(timeline);
+            break;
+        }
+    }
+}
+
+static void addDeformTimeline(Vector<Timeline *> &timelines, SkeletonData *data, float duration) {
+    int slot = rand() % BONES;
+    VertexAttachment *mesh = static_cast<VertexAttachment *>(data->getDefaultSkin()->getAttachment(slot, "mesh"));
+    Keys keys(MESH_VERTICES * 2, duration);
+    DeformTimeline *timeline = new (__FILE__, __LINE__) DeformTimeline(keys.count(), keys.bezierCount() / keys.values,
+                                                                       slot, mesh);
+    for (size_t i = 0; i < keys.count(); ++i) {
+        Vector<float> vertices;
+        for (int v = 0; v < keys.values; ++v)
+            vertices.add(keys.value(i, v, 10));
+        timeline->setFrame((int) i, keys.times[i], vertices);
+    }
+    // one 0 to 1 curve per key for all the vertices
+    Keys progress = keys;
+    progress.values = 1;
+    progress.setCurves(*timeline, 1, 0, true);
+    timelines.add(timeline);
+}
+
+static void addConstraintTimeline(Vector<Timeline *> &timelines, float duration) {
+    switch (rand() % 5) {
+        case 0: {
+            Keys keys(2, duration);
+            IkConstraintTimeline *timeline = new (__FILE__, __LINE__) IkConstraintTimeline(keys.count(),
+                                                                                           keys.bezierCount(), 0);
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame((int) i, keys.times[i], keys.value(i, 0, 0.5f, 0.5f), keys.value(i, 1, 5, 5),
+                                   rand() % 2 ? 1 : -1, rand() % 2, rand() % 2);
+            keys.setCurves(*timeline, 0.5f, 0.5f);
+            timelines.add(timeline);
+            break;
+        }
+        case 1: {
+            Keys keys(6, duration);
+            TransformConstraintTimeline *timeline = new (__FILE__, __LINE__) TransformConstraintTimeline(
+                    keys.count(), keys.bezierCount(), 0);
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame(i, keys.times[i], keys.value(i, 0, 0.5f, 0.5f), keys.value(i, 1, 0.5f, 0.5f),
+                                   keys.value(i, 2, 0.5f, 0.5f), keys.value(i, 3, 0.5f, 0.5f),
+                                   keys.value(i, 4, 0.5f, 0.5f), keys.value(i, 5, 0.5f, 0.5f));
+            keys.setCurves(*timeline, 0.5f, 0.5f);
+            timelines.add(timeline);
+            break;
+        }
+        case 2: {
+            Keys keys(3, duration);
+            PathConstraintMixTimeline *timeline = new (__FILE__, __LINE__) PathConstraintMixTimeline(
+                    keys.count(), keys.bezierCount(), 0);
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame((int) i, keys.times[i], keys.value(i, 0, 0.5f, 0.5f), keys.value(i, 1, 0.5f, 0.5f),
+                                   keys.value(i, 2, 0.5f, 0.5f));
+            keys.setCurves(*timeline, 0.5f, 0.5f);
+            timelines.add(timeline);
+            break;
+        }
+        default: {
+            Keys keys(1, duration);
+            CurveTimeline1 *timeline;
+            if (rand() % 2)
+                timeline = new (__FILE__, __LINE__) PathConstraintPositionTimeline(keys.count(), keys.bezierCount(), 0);
+            else
+                timeline = new (__FILE__, __LINE__) PathConstraintSpacingTimeline(keys.count(), keys.bezierCount(), 0);
+            for (size_t i = 0; i < keys.count(); ++i)
+                timeline->setFrame(i, keys.times[i], keys.value(i, 0, 100));
+            keys.setCurves(*timeline, 100);
+            timelines.add(timeline);
+            break;
+        }
+    }
+}
+
+static void addOrderTimelines(Vector<Timeline *> &timelines, SkeletonData *data, float duration) {
+    Keys keys(0, duration);
+    if (rand() % 2) {
+        DrawOrderTimeline *timeline = new (__FILE__, __LINE__) DrawOrderTimeline(keys.count());
+        for (size_t i = 0; i < keys.count(); ++i) {
+            Vector<int> drawOrder;
+            for (int s = 0; s < BONES; ++s)
+                drawOrder.add(s);
+            for (int s = BONES - 1; s > 0; --s) {
+                int other = rand() % (s + 1), swap = drawOrder[s];
+                drawOrder[s] = drawOrder[other];
+                drawOrder[other] = swap;
+            }
+            timeline->setFrame(i, keys.times[i], drawOrder);
+        }
+        timelines.add(timeline);
+    } else {
+        EventTimeline *timeline = new (__FILE__, __LINE__) EventTimeline(keys.count());
+        for (size_t i = 0; i < keys.count(); ++i) {
+            Event *event = new (__FILE__, __LINE__) Event(keys.times[i], *data->getEvents()[rand() % 2]);
+            event->setIntValue((int) i);
+            timeline->setFrame(i, event);
+        }
+        timelines.add(timeline);
+    }
+}
+
+static SkeletonData *randomRig() {
+    SkeletonData *data = new (__FILE__, __LINE__) SkeletonData();
+    Skin *skin = new (__FILE__, __LINE__) Skin("default");
+    data->getSkins().add(skin);
+    data->setDefaultSkin(skin);
+    for (int i = 0; i < BONES; ++i) {
+        std::string name = "bone" + std::to_string(i);
+        BoneData *parent = i ? data->getBones()[rand() % i] : NULL;
+        BoneData *bone = new (__FILE__, __LINE__) BoneData(i, name.c_str(), parent);
+        bone->setLength(randomRange(5, 30));
+        bone->setX(randomRange(-20, 20));
+        bone->setY(randomRange(-20, 20));
+        bone->setRotation(randomRange(-180, 180));
+        data->getBones().add(bone);
+        SlotData *slot = new (__FILE__, __LINE__) SlotData(i, name.c_str(), *bone);
+        slot->getColor().set(randomRange(0, 1), randomRange(0, 1), randomRange(0, 1), randomRange(0, 1));
+        data->getSlots().add(slot);
+        const char *names[] = {"a", "b"};
+        for (const char *attachmentName : names) {
+            RegionAttachment *region = new (__FILE__, __LINE__) RegionAttachment(attachmentName);
+            skin->setAttachment(i, attachmentName, region);
+            attachments.push_back(region);
+        }
+        MeshAttachment *mesh = new (__FILE__, __LINE__) MeshAttachment("mesh");
+        for (int v = 0; v < MESH_VERTICES * 2; ++v)
+            mesh->getVertices().add(randomRange(-10, 10));
+        mesh->setWorldVerticesLength(MESH_VERTICES * 2);
+        skin->setAttachment(i, "mesh", mesh);
+        attachments.push_back(mesh);
+        slot->setAttachmentName(i % 3 == 2 ? "mesh" : "a");
+    }
+    IkConstraintData *ik = new (__FILE__, __LINE__) IkConstraintData("ik");
+    ik->getBones().add(data->getBones()[BONES - 2]);
+    ik->setTarget(data->getBones()[1]);
+    ik->setMix(1);
+    ik->setBendDirection(1);
+    data->getIkConstraints().add(ik);
+    TransformConstraintData *transform = new (__FILE__, __LINE__) TransformConstraintData("transform");
+    transform->getBones().add(data->getBones()[BONES - 1]);
+    transform->setTarget(data->getBones()[2]);
+    transform->setOrder(1);
+    data->getTransformConstraints().add(transform);
+    // no path attachment, the constraint has nothing to do but its timelines still key it
+    PathConstraintData *path = new (__FILE__, __LINE__) PathConstraintData("path");
+    path->getBones().add(data->getBones()[BONES - 3]);
+    path->setTarget(data->getSlots()[0]);
+    path->setOrder(2);
+    data->getPathConstraints().add(path);
+    data->getEvents().add(new (__FILE__, __LINE__) EventData("step"));
+    data->getEvents().add(new (__FILE__, __LINE__) EventData("hit"));
+    for (int a = 0; a < ANIMATIONS; ++a) {
+        float duration = randomRange(0.3f, 2);
+        Vector<Timeline *> timelines;
+        for (int i = 0, n = 4 + rand() % 12; i < n; ++i)
+            addBoneTimeline(timelines, duration);
+        for (int i = 0, n = rand() % 5; i < n; ++i)
+            addSlotTimeline(timelines, duration);
+        for (int i = 0, n = rand() % 3; i < n; ++i)
+            addDeformTimeline(timelines, data, duration);
+        for (int i = 0, n = rand() % 3; i < n; ++i)
+            addConstraintTimeline(timelines, duration);
+        for (int i = 0, n = rand() % 3; i < n; ++i)
+            addOrderTimelines(timelines, data, duration);
+        std::string name = "animation" + std::to_string(a);
+        data->getAnimations().add(new (__FILE__, __LINE__) Animation(name.c_str(), timelines, duration));
+    }
+    return data;
+}
+
+// the pose of a frame as the bits of its values, each named for the report
+struct Pose {
+    void add(float value, const char *what, int index) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        add(bits, what, index);
+    }
+    void add(uint32_t bits, const char *what, int index) {
+        words.push_back(bits);
+        names.push_back(what);
+        indices.push_back(index);
+    }
+    std::vector<uint32_t> words;
+    std::vector<const char *> names;
+    std::vector<int> indices;
+};
+
+static Pose *firedPose;
+
+static void recordEvent(AnimationState *, EventType type, TrackEntry *entry, Event *event) {
+    firedPose->add((uint32_t) type, "event type", entry->getTrackIndex());
+    if (event) {
+        firedPose->add(event->getTime(), "event time", entry->getTrackIndex());
+        firedPose->add((uint32_t) event->getIntValue(), "event value", entry->getTrackIndex());
+    }
+}
+
+static void addColor(Pose &pose, Color &color, int index) {
+    pose.add(color.r, "slot r", index);
+    pose.add(color.g, "slot g", index);
+    pose.add(color.b, "slot b", index);
+    pose.add(color.a, "slot a", index);
+}
+
+static void addSkeleton(Pose &pose, Skeleton &skeleton) {
+    auto &bones = skeleton.getBones();
+    for (int i = 0; i < (int) bones.size(); ++i) {
+        Bone &bone = *bones[i];
+        pose.add(bone.getX(), "bone x", i);
+        pose.add(bone.getY(), "bone y", i);
+        pose.add(bone.getRotation(), "bone rotation", i);
+        pose.add(bone.getScaleX(), "bone scaleX", i);
+        pose.add(bone.getScaleY(), "bone scaleY", i);
+        pose.add(bone.getShearX(), "bone shearX", i);
+        pose.add(bone.getShearY(), "bone shearY", i);
+        pose.add(bone.getA(), "bone a", i);
+        pose.add(bone.getB(), "bone b", i);
+        pose.add(bone.getC(), "bone c", i);
+        pose.add(bone.getD(), "bone d", i);
+        pose.add(bone.getWorldX(), "bone worldX", i);
+        pose.add(bone.getWorldY(), "bone worldY", i);
+    }
+    auto &slots = skeleton.getSlots();
+    for (int i = 0; i < (int) slots.size(); ++i) {
+        Slot &slot = *slots[i];
+        addColor(pose, slot.getColor(), i);
+        Attachment *attachment = slot.getAttachment();
+        uint32_t index = 0;
+        while (index < attachments.size() && attachments[index] != attachment)
+            index++;
+        pose.add(index, "slot attachment", i);
+        Vector<float> &deform = slot.getDeform();
+        pose.add((uint32_t) deform.size(), "slot deform size", i);
+        for (size_t v = 0; v < deform.size(); ++v)
+            pose.add(deform[v], "slot deform", i);
+    }
+    auto &drawOrder = skeleton.getDrawOrder();
+    for (int i = 0; i < (int) drawOrder.size(); ++i)
+        pose.add((uint32_t) drawOrder[i]->getData().getIndex(), "draw order", i);
+    IkConstraint &ik = *skeleton.getIkConstraints()[0];
+    pose.add(ik.getMix(), "ik mix", 0);
+    pose.add(ik.getSoftness(), "ik softness", 0);
+    pose.add((uint32_t) ik.getBendDirection(), "ik bend direction", 0);
+    pose.add((uint32_t) ik.getCompress(), "ik compress", 0);
+    pose.add((uint32_t) ik.getStretch(), "ik stretch", 0);
+    TransformConstraint &transform = *skeleton.getTransformConstraints()[0];
+    pose.add(transform.getMixRotate(), "transform mixRotate", 0);
+    pose.add(transform.getMixX(), "transform mixX", 0);
+    pose.add(transform.getMixY(), "transform mixY", 0);
+    pose.add(transform.getMixScaleX(), "transform mixScaleX", 0);
+    pose.add(transform.getMixScaleY(), "transform mixScaleY", 0);
+    pose.add(transform.getMixShearY(), "transform mixShearY", 0);
+    PathConstraint &path = *skeleton.getPathConstraints()[0];
+    pose.add(path.getPosition(), "path position", 0);
+    pose.add(path.getSpacing(), "path spacing", 0);
+    pose.add(path.getMixRotate(), "path mixRotate", 0);
+    pose.add(path.getMixX(), "path mixX", 0);
+    pose.add(path.getMixY(), "path mixY", 0);
+}
+
+static Animation *randomAnimation(SkeletonData *data) {
+    return data->getAnimations()[rand() % ANIMATIONS];
+}
+
+// sets, queues, empties or clears a random track, with random settings
+static void changeTrack(AnimationState &state, SkeletonData *data) {
+    int track = rand() % TRACKS;
+    float mix = chance(20) ? 0 : randomRange(0, 0.4f);
+    TrackEntry *entry;
+    switch (rand() % 6) {
+        case 0: entry = state.setEmptyAnimation(track, mix); break;
+        case 1: entry = state.addEmptyAnimation(track, mix, randomRange(0, 0.5f)); break;
+        case 2: state.clearTrack(track); return;
+        case 3: entry = state.addAnimation(track, randomAnimation(data), chance(70), randomRange(0, 0.5f)); break;
+        default: entry = state.setAnimation(track, randomAnimation(data), chance(70)); break;
+    }
+    entry->setMixDuration(mix);
+    entry->setAlpha(chance(50) ? 1 : randomRange(0, 1));
+    if (track > 0 || chance(20))
+        entry->setMixBlend((MixBlend) (rand() % 4));
+    entry->setReverse(chance(12));
+    entry->setShortestRotation(chance(25));
+    entry->setHoldPrevious(chance(25));
+    entry->setTimeScale(randomRange(0.5f, 2));
+    entry->setEventThreshold(randomRange(0, 1));
+    entry->setAlphaAttachmentThreshold(randomRange(0, 1));
+    entry->setMixAttachmentThreshold(randomRange(0, 1));
+    entry->setMixDrawOrderThreshold(randomRange(0, 1));
+}
+
+// fills in the pose of every frame, returns the time spent in apply per frame
+static double run(SkeletonData *data, int frames, std::vector<Pose> &poses) {
+    AnimationStateData stateData(data);
+    AnimationState state(&stateData);
+    state.setListener(recordEvent);
+    Skeleton skeleton(data), atSkeleton(data);
+    skeleton.setToSetupPose();
+    double micros = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        // events fired while changing tracks count for this frame
+        poses.emplace_back();
+        Pose &pose = poses.back();
+        firedPose = &pose;
+        if (chance(4))
+            changeTrack(state, data);
+        if (chance(5)) {
+            TrackEntry *entry = state.getCurrent(rand() % TRACKS);
+            if (entry)
+                entry->setAlpha(randomRange(0, 1));
+        }
+        state.update(randomRange(0, 1 / 30.0f));
+        auto start = std::chrono::steady_clock::now();
+        state.apply(skeleton);
+        micros += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        skeleton.updateWorldTransform(Physics_None);
+        addSkeleton(pose, skeleton);
+        atSkeleton.setToSetupPose();
+        state.applyAt(atSkeleton, randomRange(0, 3));
+        atSkeleton.updateWorldTransform(Physics_None);
+        addSkeleton(pose, atSkeleton);
+    }
+    return micros / frames;
+}
+
+int main(int argc, char **argv) {
+    bool write = argc > 2 && !strcmp(argv[1], "--write");
+    bool compare = argc > 2 && !strcmp(argv[1], "--compare");
+    unsigned seed = argc > 3 ? (unsigned) atoi(argv[3]) : 1;
+    int frames = argc > 4 ? atoi(argv[4]) : 3000;
+    if ((!write && !compare) || frames < 1) {
+        fprintf(stderr, "usage: %s --write|--compare file.pose [seed] [frames]\n", argv[0]);
+        return 2;
+    }
+    SpineExtension::setInstance(getDefaultExtension());
+    srand(seed);
+    SkeletonData *data = randomRig();
+    std::vector<Pose> poses;
+    double micros = run(data, frames, poses);
+    printf("seed %u, %d frames, apply %.2f us per frame\n", seed, frames, micros);
+    delete data;
+    FILE *file = fopen(argv[2], write ? "wb" : "rb");
+    if (!file) {
+        fprintf(stderr, "can't open %s\n", argv[2]);
+        return 2;
+    }
+    bool passed = true;
+    for (int frame = 0; frame < frames && passed; ++frame) {
+        Pose &pose = poses[frame];
+        uint32_t count = (uint32_t) pose.words.size();
+        if (write) {
+            fwrite(&count, sizeof(count), 1, file);
+            fwrite(pose.words.data(), sizeof(uint32_t), count, file);
+            continue;
+        }
+        uint32_t written = 0;
+        std::vector<uint32_t> words;
+        if (fread(&written, sizeof(written), 1, file) == 1) {
+            words.resize(written);
+            if (fread(words.data(), sizeof(uint32_t), written, file) != written)
+                words.clear();
+        }
+        for (size_t i = 0; i < count && passed; ++i) {
+            if (i < words.size() && words[i] == pose.words[i])
+                continue;
+            printf("frame %d: %s %d differs\n", frame, pose.names[i], pose.indices[i]);
+            passed = false;
+        }
+        if (passed && written != count) {
+            printf("frame %d: %u values written, %u posed\n", frame, written, count);
+            passed = false;
+        }
+    }
+    fclose(file);
+    if (compare)
+        printf("%s\n", passed ? "PASS" : "FAIL");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#!/bin/sh
+# Builds the host checks in this directory against spine-cpp 4.2, with the port and the engine stand-ins
+# from engine/ for the checks that drive a SpineNode. Needs a C++17 compiler, and libpng for those.
+#
+#     tools/host/build.sh [output directory, default tools/host/build]
+set -e
+HOST=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HOST/../.." && pwd)
+OUT=${1:-$HOST/build}
+CXX=${CXX:-c++}
+FLAGS="-std=c++17 -O2 -DCONFIG_SPINE_VERSION_42=1 -DCONFIG_SPINE_VERSION=42 -I$ROOT/spine-cpp_4.2/include"
+mkdir -p "$OUT/spine" "$OUT/port"
+for f in "$ROOT"/spine-cpp_4.2/src/spine/*.cpp; do
+    o="$OUT/spine/$(basename "$f" .cpp).o"
+    [ "$o" -nt "$f" ] || $CXX $FLAGS -c "$f" -o "$o"
+done
+$CXX $FLAGS "$HOST/key_error_check.cpp" "$OUT"/spine/*.o -o "$OUT/key_error_check"
+$CXX $FLAGS "$HOST/clipping_check.cpp" "$OUT"/spine/*.o -o "$OUT/clipping_check"
+$CXX $FLAGS "$HOST/physics_check.cpp" "$OUT"/spine/*.o -o "$OUT/physics_check"
+$CXX $FLAGS "$HOST/quantize_check.cpp" "$OUT"/spine/*.o -o "$OUT/quantize_check"
+# apply_check_virtual swaps in an AnimationState built with the virtual timeline dispatch
+$CXX $FLAGS -DSPINE_VIRTUAL_TIMELINES -c "$ROOT/spine-cpp_4.2/src/spine/AnimationState.cpp" -o "$OUT/AnimationState-virtual.o"
+$CXX $FLAGS "$HOST/apply_check.cpp" "$OUT"/spine/*.o -o "$OUT/apply_check"
+VIRTUAL_OBJECTS=""
+for o in "$OUT"/spine/*.o; do
+    [ "$(basename "$o")" = AnimationState.o ] || VIRTUAL_OBJECTS="$VIRTUAL_OBJECTS $o"
+done
+$CXX $FLAGS "$HOST/apply_check.cpp" $VIRTUAL_OBJECTS "$OUT/AnimationState-virtual.o" -o "$OUT/apply_check_virtual"
+# as a component built with CONFIG_SPINE_BENCH, fixed_point_check drives SpineBench
+PORT_FLAGS="$FLAGS -DCONFIG_SPINE_BENCH=1 -I$HOST/engine -I$ROOT"
+for f in "$ROOT"/cubicat-port/*.cpp "$HOST/engine/engine.cpp"; do
+    $CXX $PORT_FLAGS -c "$f" -o "$OUT/port/$(basename "$f" .cpp).o"
+done
+$CXX $PORT_FLAGS "$HOST/fixed_point_check.cpp" "$OUT"/port/*.o "$OUT"/spine/*.o -lpng -o "$OUT/fixed_point_check"
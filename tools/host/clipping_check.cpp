@@ -0,0 +1,159 @@
+// Host check and benchmark of SkeletonClipping's cached convex decomposition on a mask heavy UI rig. The
+// rig is built here: a grid of panels, each a star shaped clipping mask on a bone with its own rotation
+// and scale, mirrored ones included, clipping a quad of four triangles. The whole rig turns a little
+// every frame. Each mask is clipped twice per frame. The cached path uses the attachment's bone space
+// decomposition. The reference path gives the slot a deform equal to the attachment's vertices, which
+// keeps the same world vertices but makes clipStart decompose them in world space as it did before
+// the cache. The clipped areas of the two must match within AREA_TOLERANCE relative, frame by frame.
+// clipStart and clipTriangles times per mask are reported for both. Exits with 1 when the areas differ.
+// See build.sh.
+//
+//     clipping_check [panels, default 30] [frames, default 200]
+#include <spine/spine.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+
+using namespace spine;
+
+// the two paths decompose the same polygon in different spaces, so the pieces round differently
+#define AREA_TOLERANCE 1e-6
+#define STAR_POINTS 7
+#define PANEL_SIZE 60.0f
+
+SpineExtension *spine::getDefaultExtension() {
+    return new DefaultSpineExtension();
+}
+
+static float randomRange(float min, float max) {
+    return min + (max - min) * (float) rand() / (float) RAND_MAX;
+}
+
+static SkeletonData *maskRig(int panels) {
+    SkeletonData *data = new (__FILE__, __LINE__) SkeletonData();
+    BoneData *root = new (__FILE__, __LINE__) BoneData(0, "root");
+    data->getBones().add(root);
+    Skin *skin = new (__FILE__, __LINE__) Skin("default");
+    data->getSkins().add(skin);
+    data->setDefaultSkin(skin);
+    int columns = (int) ceilf(sqrtf((float) panels));
+    for (int i = 0; i < panels; ++i) {
+        std::string name = "panel" + std::to_string(i);
+        BoneData *bone = new (__FILE__, __LINE__) BoneData((int) data->getBones().size(), name.c_str(), root);
+        bone->setX((i % columns) * PANEL_SIZE * 2.5f);
+        bone->setY((i / columns) * PANEL_SIZE * 2.5f);
+        bone->setRotation(randomRange(0, 360));
+        bone->setScaleX(randomRange(0.5f, 1.5f) * (rand() % 4 ? 1 : -1));
+        bone->setScaleY(randomRange(0.5f, 1.5f) * (rand() % 4 ? 1 : -1));
+        data->getBones().add(bone);
+        SlotData *slot = new (__FILE__, __LINE__) SlotData((int) data->getSlots().size(), name.c_str(), *bone);
+        data->getSlots().add(slot);
+        ClippingAttachment *clip = new (__FILE__, __LINE__) ClippingAttachment(name.c_str());
+        // concave, so it decomposes into several convex pieces, in either winding
+        bool clockwise = rand() % 2;
+        for (int p = 0; p < STAR_POINTS * 2; ++p) {
+            float angle = (clockwise ? -p : p) * 3.14159265f / STAR_POINTS;
+            float radius = p % 2 ? PANEL_SIZE * 0.4f : PANEL_SIZE;
+            clip->getVertices().add(cosf(angle) * radius);
+            clip->getVertices().add(sinf(angle) * radius);
+        }
+        clip->setWorldVerticesLength(STAR_POINTS * 4);
+        clip->setEndSlot(slot);
+        skin->setAttachment(i, name.c_str(), clip);
+        slot->setAttachmentName(name.c_str());
+    }
+    return data;
+}
+
+struct Path {
+    Path(const char *name, SkeletonData *data) : name(name), skeleton(data) {
+        skeleton.setToSetupPose();
+        skeleton.setSlotsToSetupPose();
+    }
+    const char *name;
+    Skeleton skeleton;
+    SkeletonClipping clipper;
+    double startMicros = 0;
+    double clipMicros = 0;
+};
+
+// the panel's quad in world space, through the bone so mirrored panels stay covered
+static void panelQuad(Bone &bone, float *vertices) {
+    static const float corners[] = {-1, -1, 1, -1, 1, 1, -1, 1, 0, 0};
+    for (int i = 0; i < 10; i += 2) {
+        float x = corners[i] * PANEL_SIZE, y = corners[i + 1] * PANEL_SIZE;
+        vertices[i] = x * bone.getA() + y * bone.getB() + bone.getWorldX();
+        vertices[i + 1] = x * bone.getC() + y * bone.getD() + bone.getWorldY();
+    }
+}
+
+static double clipPanels(Path &path) {
+    static unsigned short triangles[] = {0, 1, 4, 1, 2, 4, 2, 3, 4, 3, 0, 4};
+    static float uvs[] = {0, 0, 1, 0, 1, 1, 0, 1, 0.5f, 0.5f};
+    double area = 0;
+    auto &slots = path.skeleton.getSlots();
+    for (size_t i = 0; i < slots.size(); ++i) {
+        Slot &slot = *slots[i];
+        float vertices[10];
+        panelQuad(slot.getBone(), vertices);
+        auto start = std::chrono::steady_clock::now();
+        path.clipper.clipStart(slot, static_cast<ClippingAttachment *>(slot.getAttachment()));
+        auto started = std::chrono::steady_clock::now();
+        path.clipper.clipTriangles(vertices, triangles, 12, uvs, 2);
+        auto clipped = std::chrono::steady_clock::now();
+        path.startMicros += std::chrono::duration<double, std::micro>(started - start).count();
+        path.clipMicros += std::chrono::duration<double, std::micro>(clipped - started).count();
+        Vector<float> &out = path.clipper.getClippedVertices();
+        Vector<unsigned short> &tris = path.clipper.getClippedTriangles();
+        for (size_t t = 0; t < tris.size(); t += 3) {
+            float *a = &out[tris[t] * 2], *b = &out[tris[t + 1] * 2], *c = &out[tris[t + 2] * 2];
+            area += fabs((double) (b[0] - a[0]) * (c[1] - a[1]) - (double) (c[0] - a[0]) * (b[1] - a[1])) / 2;
+        }
+        path.clipper.clipEnd(slot);
+    }
+    return area;
+}
+
+static bool check(SkeletonData *data, int panels, int frames) {
+    Path cached("cached", data), reference("world space", data);
+    Path *paths[] = {&cached, &reference};
+    auto &slots = reference.skeleton.getSlots();
+    for (size_t i = 0; i < slots.size(); ++i)
+        slots[i]->getDeform().clearAndAddAll(static_cast<ClippingAttachment *>(slots[i]->getAttachment())->getVertices());
+    double worst = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        for (Path *path : paths) {
+            path->skeleton.getRootBone()->setRotation(frame * 0.7f);
+            path->skeleton.updateWorldTransform(Physics_None);
+        }
+        double area = clipPanels(cached), referenceArea = clipPanels(reference);
+        double error = fabs(area - referenceArea) / fmax(referenceArea, 1.0);
+        if (error > worst)
+            worst = error;
+    }
+    double masks = (double) panels * frames;
+    printf("%d masks of %d points, %d frames\n", panels, STAR_POINTS * 2, frames);
+    printf("%-12s %16s %20s\n", "path", "clipStart us", "clipTriangles us");
+    for (Path *path : paths)
+        printf("%-12s %16.3f %20.3f\n", path->name, path->startMicros / masks, path->clipMicros / masks);
+    bool passed = worst <= AREA_TOLERANCE;
+    printf("worst relative area difference %.2e, bound %.0e %s\n", worst, AREA_TOLERANCE, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    int panels = argc > 1 ? atoi(argv[1]) : 30;
+    int frames = argc > 2 ? atoi(argv[2]) : 200;
+    if (panels < 1 || frames < 1) {
+        fprintf(stderr, "usage: %s [panels] [frames]\n", argv[0]);
+        return 2;
+    }
+    SpineExtension::setInstance(getDefaultExtension());
+    srand(1);
+    SkeletonData *data = maskRig(panels);
+    bool passed = check(data, panels, frames);
+    delete data;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+#include "engine.h"
+#include "esp_timer.h"
+#include <chrono>
+
+using namespace cubicat;
+
+Cubicat CUBICAT;
+
+FILE* Storage::openFileFlash(const char* path) {
+    return fopen(path, "rb");
+}
+FILE* Storage::openFileSD(const char* path) {
+    return fopen(path, "rb");
+}
+
+Texture::Texture(uint16_t width, uint16_t height, const void* data, bool, uint16_t, uint16_t, const void*, uint8_t,
+                 bool) : m_iWidth(width), m_iHeight(height), m_pData(data) {
+}
+Texture::~Texture() {
+    free((void*)m_pData);
+}
+
+SharedPtr<Mesh2D> Mesh2D::create(const float*, uint32_t, const uint16_t*, uint32_t, bool) {
+    return SharedPtr<Mesh2D>(new Mesh2D());
+}
+void Mesh2D::updateVertices(const float* positions, uint32_t vertexCount) {
+    m_vPositions.assign(positions, positions + vertexCount * 2);
+}
+void Mesh2D::updateIndices(const uint16_t* indices, uint32_t indexCount) {
+    m_vIndices.assign(indices, indices + indexCount);
+}
+void Mesh2D::updateUVs(const float* uvs, uint32_t count) {
+    m_vUVs.assign(uvs, uvs + count);
+}
+
+SharedPtr<Polygon2D> Polygon2D::create(Mesh2DPtr mesh) {
+    auto polygon = SharedPtr<Polygon2D>(new Polygon2D());
+    polygon->m_pMesh = mesh;
+    return polygon;
+}
+
+int64_t esp_timer_get_time() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
@@ -0,0 +1,120 @@
+// Host stand-ins for the parts of the cubicat engine the port uses, enough to build the port on a desktop
+// and run the checks in tools/host against it. Nothing is drawn: meshes keep what they were given and
+// storage opens files by path.
+#ifndef _HOST_ENGINE_H_
+#define _HOST_ENGINE_H_
+#include <vector>
+#include <string>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "esp_heap_caps.h"
+
+#define NEW new
+#define DECLARE_RTTI_SUB(type, base)
+
+inline void* psram_prefered_malloc(size_t size) { return malloc(size); }
+inline void* psram_prefered_realloc(void* ptr, size_t size) { return realloc(ptr, size); }
+
+struct Storage {
+    FILE* openFileFlash(const char* path);
+    FILE* openFileSD(const char* path);
+};
+struct Cubicat {
+    Storage storage;
+};
+extern Cubicat CUBICAT;
+
+namespace cubicat {
+template<class T> class SharedPtr : public std::shared_ptr<T> {
+public:
+    using std::shared_ptr<T>::shared_ptr;
+    SharedPtr() {}
+    SharedPtr(std::nullptr_t) {}
+    template<class U> SharedPtr(const SharedPtr<U>& other) : std::shared_ptr<T>(other) {}
+};
+struct Vector2f {
+    float x, y;
+    Vector2f(float x = 0, float y = 0) : x(x), y(y) {}
+};
+class Texture {
+public:
+    Texture(uint16_t width, uint16_t height, const void* data, bool, uint16_t, uint16_t, const void* palette,
+            uint8_t bitPerPixel, bool alpha);
+    ~Texture();
+    uint16_t getWidth() const { return m_iWidth; }
+    uint16_t getHeight() const { return m_iHeight; }
+private:
+    uint16_t    m_iWidth;
+    uint16_t    m_iHeight;
+    const void* m_pData;
+};
+typedef SharedPtr<Texture> TexturePtr;
+enum class BlendMode { Normal, Additive, Multiply };
+class Material {
+public:
+    void setTexture(const TexturePtr& texture) { m_pTexture = texture; }
+    void setBilinearFilter(bool) {}
+    void setBlendMode(BlendMode blendMode) { m_eBlendMode = blendMode; }
+    TexturePtr  m_pTexture;
+    BlendMode   m_eBlendMode = BlendMode::Normal;
+};
+class Mesh2D {
+public:
+    static SharedPtr<Mesh2D> create(const float*, uint32_t, const uint16_t*, uint32_t, bool);
+    void updateVertices(const float* positions, uint32_t vertexCount);
+    void updateIndices(const uint16_t* indices, uint32_t indexCount);
+    void updateUVs(const float* uvs, uint32_t count);
+    std::vector<float>      m_vPositions;
+    std::vector<float>      m_vUVs;
+    std::vector<uint16_t>   m_vIndices;
+};
+typedef SharedPtr<Mesh2D> Mesh2DPtr;
+class Drawable {
+public:
+    virtual ~Drawable() = default;
+    template<class T> T* cast() { return static_cast<T*>(this); }
+    void setVisible(bool visible) { m_bVisible = visible; }
+    bool isVisible() { return m_bVisible; }
+    void addDirty(bool) {}
+    Material* getMaterial() { return &m_material; }
+private:
+    Material    m_material;
+    bool        m_bVisible = true;
+};
+typedef SharedPtr<Drawable> DrawablePtr;
+class Polygon2D : public Drawable {
+public:
+    static SharedPtr<Polygon2D> create(Mesh2DPtr mesh);
+    Mesh2D* getMesh() { return m_pMesh.get(); }
+private:
+    Mesh2DPtr   m_pMesh;
+};
+class Node {
+public:
+    virtual ~Node() = default;
+    virtual void update(float, bool) {}
+    bool isVisible() { return m_bVisible; }
+    void setVisible(bool visible) { m_bVisible = visible; }
+private:
+    bool        m_bVisible = true;
+};
+class Node2D : public Node {
+public:
+    void setPosition(const Vector2f& position) { m_position = position; }
+    const Vector2f& getPosition() { return m_position; }
+    // degrees
+    void setRotation(float rotation) { m_fRotation = rotation; }
+    float getRotation() { return m_fRotation; }
+    std::vector<DrawablePtr>& getDrawables() { return m_vDrawables; }
+    void attachDrawable(DrawablePtr drawable) { m_vDrawables.push_back(drawable); }
+    void clearDrawables() { m_vDrawables.clear(); }
+private:
+    Vector2f                    m_position;
+    float                       m_fRotation = 0;
+    std::vector<DrawablePtr>    m_vDrawables;
+};
+}
+
+#endif
@@ -0,0 +1,7 @@
+#pragma once
+#include <stdint.h>
+struct ImageData {
+    const uint8_t*  data;
+    uint16_t        width;
+    uint16_t        height;
+};
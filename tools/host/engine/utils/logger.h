@@ -0,0 +1,6 @@
+#pragma once
+#include <stdio.h>
+#define LOGE(fmt, ...) fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define LOGW(fmt, ...) fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define LOGI(fmt, ...) fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define LOGD(fmt, ...)
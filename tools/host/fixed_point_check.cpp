@@ -0,0 +1,105 @@
+// Host check of SpineNode's 16 bit fixed point output against its float output. It runs the comparison of
+// tools/fixed_point_bench.js on a desktop, for every animation of a skeleton and under node transforms the
+// device script doesn't try. Each animation plays at 30 fps with the node untransformed, moved and rotated.
+// The largest position and UV differences from the float vertices placed by the node transform must stay
+// within half a fixed point step plus float rounding. The same comparison is then made for what a
+// SpineBatcher uploads with and without setFixedPoint. Exits with 1 when a bound is exceeded. See build.sh.
+//
+//     fixed_point_check hero.skel hero.atlas [frames]
+//
+// Positions only cover +-2048 pixels (SPINE_FIXED_POSITION_BITS), rigs reaching further fail by design.
+#include "cubicat-port/spine_node.h"
+#include "cubicat-port/spine_batcher.h"
+#include "cubicat-port/spine_bench.h"
+#include "cubicat-port/spine_extension.h"
+#include "cubicat-port/texture_loader.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// half a step of the 1/16 pixel positions and of the 1/32768 UVs, plus float rounding
+static const double POSITION_BOUND = 0.5 / (1 << SPINE_FIXED_POSITION_BITS) + 0.001;
+static const double UV_BOUND = 0.5 / (1 << SPINE_FIXED_UV_BITS) + 0.000001;
+
+struct NodeTransform {
+    const char* name;
+    float       x;
+    float       y;
+    float       rotation;
+};
+
+static const NodeTransform TRANSFORMS[] = {
+    {"identity", 0, 0, 0},
+    {"moved", 310.5f, -207.25f, 0},
+    {"rotated", 120, 80, 37},
+};
+
+// largest differences between the meshes a batcher uploads in float and in fixed point mode
+static bool batcherError(SpineBatcher* batcher, double& positionError, double& uvError) {
+    std::vector<std::vector<float>> positions, uvs;
+    batcher->setFixedPoint(false);
+    batcher->update(0, false);
+    for (auto& drawable : batcher->getDrawables()) {
+        auto mesh = drawable->cast<Polygon2D>()->getMesh();
+        positions.push_back(mesh->m_vPositions);
+        uvs.push_back(mesh->m_vUVs);
+    }
+    int drawCalls = batcher->getDrawCalls();
+    batcher->setFixedPoint(true);
+    batcher->update(0, false);
+    if (batcher->getDrawCalls() != drawCalls)
+        return false;
+    auto& drawables = batcher->getDrawables();
+    for (int i = 0; i < drawCalls; ++i) {
+        auto mesh = drawables[i]->cast<Polygon2D>()->getMesh();
+        if (mesh->m_vPositions.size() != positions[i].size() || mesh->m_vUVs.size() != uvs[i].size())
+            return false;
+        for (size_t v = 0; v < positions[i].size(); ++v)
+            positionError = fmax(positionError, fabs(mesh->m_vPositions[v] - positions[i][v]));
+        for (size_t v = 0; v < uvs[i].size(); ++v)
+            uvError = fmax(uvError, fabs(mesh->m_vUVs[v] - uvs[i][v]));
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s skeleton.skel skeleton.atlas [frames]\n", argv[0]);
+        return 2;
+    }
+    int frames = argc > 3 ? atoi(argv[3]) : 60;
+    CubicatSpineExtension::init();
+    CubicatTextureLoader::init(SPIFFS);
+    SpineNode* node = SpineNode::createSpine();
+    node->loadWithBinaryFile(argv[1], argv[2]);
+    int animations = (int)node->getAnimationNames().size();
+    if (animations == 0) {
+        fprintf(stderr, "no animations in %s\n", argv[1]);
+        return 2;
+    }
+    SpineBatcherPtr batcher = SpineBatcher::create();
+    bool passed = true;
+    printf("bounds: position %.6f px, uv %.8f\n", POSITION_BOUND, UV_BOUND);
+    printf("%-24s %-9s %12s %12s %12s %12s\n", "animation", "node", "position", "uv", "batched", "batched uv");
+    for (auto& transform : TRANSFORMS) {
+        node->setPosition(Vector2f(transform.x, transform.y));
+        node->setRotation(transform.rotation);
+        for (int i = 0; i < animations; ++i) {
+            node->setAnimationById(0, i, true);
+            node->update(0, false);
+            double position = SpineBench::fixedPointError(node, frames, false) / 1000000.0;
+            double uv = SpineBench::fixedPointError(node, frames, true) / 1000000.0;
+            double batchedPosition = 0, batchedUV = 0;
+            batcher->addNode(node);
+            bool batched = batcherError(batcher.get(), batchedPosition, batchedUV);
+            batcher->removeNode(node);
+            bool ok = position >= 0 && uv >= 0 && batched && position <= POSITION_BOUND && uv <= UV_BOUND &&
+                      batchedPosition <= POSITION_BOUND && batchedUV <= UV_BOUND;
+            printf("%-24s %-9s %12.6f %12.8f %12.6f %12.8f %s\n", node->getAnimationNames()[i].c_str(), transform.name,
+                   position, uv, batchedPosition, batchedUV, ok ? "PASS" : "FAIL");
+            passed &= ok;
+        }
+    }
+    delete node;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// Host check of tools/spine_key_reducer.py output through the spine 4.2 runtime. Both JSON exports are
+// loaded with SkeletonJson and posed at 60 fps over every animation. Constraints, inherit modes and
+// physics are applied as on the device. The worst error of each bone is reported, over its origin and
+// its tip (origin plus length along the bone's x axis), which is the metric the reducer's approximate
+// bones-only check uses. No atlas is needed, attachments load without regions. Exits with 1 when
+// --tolerance is given and a bone exceeds it. See build.sh.
+//
+//     key_error_check hero.json hero-reduced.json [--tolerance 0.5]
+#include <spine/spine.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+using namespace spine;
+
+#define SAMPLE_RATE 60
+
+SpineExtension *spine::getDefaultExtension() {
+    return new DefaultSpineExtension();
+}
+
+// attachments without texture regions, bones and constraints don't need them
+class RegionlessAttachmentLoader : public AttachmentLoader {
+public:
+    RegionAttachment *newRegionAttachment(Skin &, const String &name, const String &, Sequence *) override {
+        return new (__FILE__, __LINE__) RegionAttachment(name);
+    }
+    MeshAttachment *newMeshAttachment(Skin &, const String &name, const String &, Sequence *) override {
+        return new (__FILE__, __LINE__) MeshAttachment(name);
+    }
+    BoundingBoxAttachment *newBoundingBoxAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) BoundingBoxAttachment(name);
+    }
+    PathAttachment *newPathAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) PathAttachment(name);
+    }
+    PointAttachment *newPointAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) PointAttachment(name);
+    }
+    ClippingAttachment *newClippingAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) ClippingAttachment(name);
+    }
+    void configureAttachment(Attachment *) override {
+    }
+};
+
+static SkeletonData *load(const char *path) {
+    SkeletonJson json(new (__FILE__, __LINE__) RegionlessAttachmentLoader(), true);
+    SkeletonData *data = json.readSkeletonDataFile(path);
+    if (!data)
+        fprintf(stderr, "%s: %s\n", path, json.getError().buffer());
+    return data;
+}
+
+static void pose(Skeleton &skeleton, Animation &animation, float lastTime, float time, float delta) {
+    skeleton.setToSetupPose();
+    animation.apply(skeleton, lastTime, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+    skeleton.update(delta);
+    skeleton.updateWorldTransform(lastTime < 0 ? Physics_Reset : Physics_Update);
+}
+
+static float tipError(Bone &bone1, Bone &bone2) {
+    float length = bone1.getData().getLength();
+    float x1 = bone1.getWorldX(), y1 = bone1.getWorldY(), x2 = bone2.getWorldX(), y2 = bone2.getWorldY();
+    float error = sqrtf((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+    // each tip on its own, so identical bones come out exactly 0 however the compiler fuses the math
+    float tipX1 = x1 + bone1.getA() * length, tipY1 = y1 + bone1.getC() * length;
+    float tipX2 = x2 + bone2.getA() * length, tipY2 = y2 + bone2.getC() * length;
+    float tip = sqrtf((tipX1 - tipX2) * (tipX1 - tipX2) + (tipY1 - tipY2) * (tipY1 - tipY2));
+    return std::max(error, tip);
+}
+
+int main(int argc, char **argv) {
+    const char *paths[2] = {NULL, NULL};
+    float tolerance = -1;
+    for (int i = 1, p = 0; i < argc; ++i) {
+        if (!strcmp(argv[i], "--tolerance") && i + 1 < argc)
+            tolerance = (float) atof(argv[++i]);
+        else if (p < 2)
+            paths[p++] = argv[i];
+    }
+    if (!paths[1]) {
+        fprintf(stderr, "usage: %s original.json reduced.json [--tolerance units]\n", argv[0]);
+        return 2;
+    }
+    SpineExtension::setInstance(getDefaultExtension());
+    SkeletonData *data1 = load(paths[0]);
+    SkeletonData *data2 = load(paths[1]);
+    if (!data1 || !data2)
+        return 2;
+    if (data1->getBones().size() != data2->getBones().size()) {
+        fprintf(stderr, "the skeletons have different bones\n");
+        return 2;
+    }
+    Skeleton *skeleton1 = new (__FILE__, __LINE__) Skeleton(data1);
+    Skeleton *skeleton2 = new (__FILE__, __LINE__) Skeleton(data2);
+    size_t boneCount = data1->getBones().size();
+    std::vector<float> boneErrors(boneCount, 0);
+    printf("%-32s %8s %10s\n", "animation", "samples", "worst");
+    auto &animations = data1->getAnimations();
+    for (size_t a = 0; a < animations.size(); ++a) {
+        Animation *animation1 = animations[a];
+        Animation *animation2 = data2->findAnimation(animation1->getName());
+        if (!animation2) {
+            fprintf(stderr, "%s: no animation %s\n", paths[1], animation1->getName().buffer());
+            return 2;
+        }
+        float duration = animation1->getDuration();
+        int steps = (int) ceilf(duration * SAMPLE_RATE);
+        float worst = 0, lastTime = -1;
+        for (int step = 0; step <= steps; ++step) {
+            float time = std::min((float) step / SAMPLE_RATE, duration);
+            float delta = lastTime < 0 ? 0 : time - lastTime;
+            pose(*skeleton1, *animation1, lastTime, time, delta);
+            pose(*skeleton2, *animation2, lastTime, time, delta);
+            lastTime = time;
+            for (size_t b = 0; b < boneCount; ++b) {
+                float error = tipError(*skeleton1->getBones()[b], *skeleton2->getBones()[b]);
+                boneErrors[b] = std::max(boneErrors[b], error);
+                worst = std::max(worst, error);
+            }
+        }
+        printf("%-32s %8d %10.4f\n", animation1->getName().buffer(), steps + 1, worst);
+    }
+    bool passed = true;
+    printf("worst world-space error per bone:\n");
+    std::vector<size_t> order;
+    for (size_t b = 0; b < boneCount; ++b)
+        order.push_back(b);
+    std::sort(order.begin(), order.end(), [&](size_t l, size_t r) { return boneErrors[l] > boneErrors[r]; });
+    for (size_t b : order) {
+        if (boneErrors[b] <= 0)
+            continue;
+        bool over = tolerance >= 0 && boneErrors[b] > tolerance;
+        printf("  %-30s %.4f%s\n", data1->getBones()[b]->getName().buffer(), boneErrors[b], over ? " over" : "");
+        passed &= !over;
+    }
+    delete skeleton1;
+    delete skeleton2;
+    delete data1;
+    delete data2;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// Host check and benchmark of Skeleton::setPhysicsMaxSteps on a hair heavy rig. The rig is built here:
+// strands of chained bones, each bone with a physics constraint, swung by moving the skeleton. It runs
+// at 60 fps with one long frame (the hitch, like a flash read in loadWithBinaryFile) in the middle, and
+// also starts with a long first frame, before the constraints have a pose to move from. Each policy
+// reports the cost of a normal frame, of the hitch frame and of the frames after it.
+//
+// Checked for every constraint on every frame, from its remaining time before and after:
+// - PhysicsSteps_Drop keeps no more than the capped time,
+// - PhysicsSteps_Defer runs no more than the step limit, keeps all time not stepped, the first frame
+//   included, and works off the hitch within the frames the limit allows.
+// Exits with 1 when a check fails. See build.sh.
+//
+//     physics_check [max steps, default 4] [hitch seconds, default 2] [strands, default 20]
+#include <spine/spine.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace spine;
+
+#define FRAME (1 / 60.0f)
+#define FRAMES 400
+#define HITCH_FRAME 200
+#define STRAND_BONES 15
+// remaining time is accumulated in floats, over hundreds of steps
+#define TIME_EPSILON 0.001f
+
+SpineExtension *spine::getDefaultExtension() {
+    return new DefaultSpineExtension();
+}
+
+static SkeletonData *hairRig(int strands) {
+    SkeletonData *data = new (__FILE__, __LINE__) SkeletonData();
+    BoneData *root = new (__FILE__, __LINE__) BoneData(0, "root");
+    data->getBones().add(root);
+    for (int s = 0; s < strands; ++s) {
+        BoneData *parent = root;
+        for (int b = 0; b < STRAND_BONES; ++b) {
+            std::string name = "hair" + std::to_string(s) + "-" + std::to_string(b);
+            BoneData *bone = new (__FILE__, __LINE__) BoneData((int) data->getBones().size(), name.c_str(), parent);
+            bone->setLength(12);
+            if (b == 0) {
+                bone->setX((s - strands / 2) * 10.0f);
+                bone->setRotation(-90);
+            } else {
+                bone->setX(12);
+            }
+            data->getBones().add(bone);
+            PhysicsConstraintData *physics = new (__FILE__, __LINE__) PhysicsConstraintData(name.c_str());
+            physics->setBone(bone);
+            physics->setOrder((int) data->getPhysicsConstraints().size());
+            physics->setRotate(1);
+            physics->setX(1);
+            physics->setY(1);
+            physics->setStep(FRAME);
+            physics->setInertia(0.5f);
+            physics->setStrength(100);
+            physics->setDamping(0.85f);
+            physics->setMassInverse(1);
+            physics->setMix(1);
+            physics->setLimit(5000);
+            physics->setGravity(50);
+            data->getPhysicsConstraints().add(physics);
+            parent = bone;
+        }
+    }
+    return data;
+}
+
+struct Run {
+    const char *name;
+    int maxSteps;
+    PhysicsSteps policy;
+    double normalMicros = 0;
+    double hitchMicros = 0;
+    double afterMicros = 0;
+    // frames until the Defer backlog was worked off after the hitch
+    int recoveryFrames = -1;
+    int failures = 0;
+};
+
+static void fail(Run &run, int frame, const char *what, float value) {
+    if (run.failures++ < 5)
+        printf("  %s frame %d: %s (%.4f)\n", run.name, frame, what, value);
+}
+
+static void run(SkeletonData *data, Run &run, float hitch) {
+    Skeleton skeleton(data);
+    skeleton.setPhysicsMaxSteps(run.maxSteps, run.policy);
+    skeleton.setToSetupPose();
+    auto &constraints = skeleton.getPhysicsConstraints();
+    std::vector<float> before(constraints.size());
+    // the cap leaves half a step over the limit, see PhysicsConstraint::update
+    float limit = FRAME * (run.maxSteps + 0.5f);
+    int normalFrames = 0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        float delta = frame == 0 || frame == HITCH_FRAME ? hitch : FRAME;
+        for (size_t i = 0; i < constraints.size(); ++i)
+            before[i] = constraints[i]->getRemaining();
+        auto start = std::chrono::steady_clock::now();
+        skeleton.setX(sinf(frame * 0.1f) * 40);
+        skeleton.update(delta);
+        skeleton.updateWorldTransform(Physics_Update);
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (frame == HITCH_FRAME)
+            run.hitchMicros = micros;
+        else if (frame > HITCH_FRAME && frame <= HITCH_FRAME + 4)
+            run.afterMicros += micros / 4;
+        else if (frame > 4) {
+            run.normalMicros += micros;
+            normalFrames++;
+        }
+        float worstBacklog = 0;
+        for (size_t i = 0; i < constraints.size(); ++i) {
+            float remaining = constraints[i]->getRemaining();
+            float stepped = (before[i] + delta - remaining) / FRAME;
+            worstBacklog = fmaxf(worstBacklog, remaining);
+            if (run.maxSteps == 0)
+                continue;
+            // dropped time isn't stepped, so only the remaining time can be checked
+            if (run.policy == PhysicsSteps_Drop && remaining > limit + TIME_EPSILON)
+                fail(run, frame, "more than the limit's time kept", remaining);
+            if (run.policy == PhysicsSteps_Defer) {
+                if (stepped > run.maxSteps + TIME_EPSILON / FRAME)
+                    fail(run, frame, "steps over the limit", stepped);
+                if (fabsf(stepped - roundf(stepped)) > TIME_EPSILON / FRAME)
+                    fail(run, frame, "deferred time lost", stepped);
+            }
+        }
+        if (run.recoveryFrames < 0 && frame > HITCH_FRAME && worstBacklog < FRAME)
+            run.recoveryFrames = frame - HITCH_FRAME;
+    }
+    run.normalMicros /= normalFrames;
+    if (run.policy == PhysicsSteps_Defer && run.maxSteps > 1) {
+        // each frame adds one step's worth and may take maxSteps
+        int allowed = (int) ceilf(hitch / FRAME / (run.maxSteps - 1)) + 2;
+        if (run.recoveryFrames < 0 || run.recoveryFrames > allowed)
+            fail(run, HITCH_FRAME, "backlog not worked off in time", (float) run.recoveryFrames);
+    }
+}
+
+int main(int argc, char **argv) {
+    int maxSteps = argc > 1 ? atoi(argv[1]) : 4;
+    float hitch = argc > 2 ? (float) atof(argv[2]) : 2;
+    int strands = argc > 3 ? atoi(argv[3]) : 20;
+    if (maxSteps < 1 || hitch < FRAME || strands < 1) {
+        fprintf(stderr, "usage: %s [max steps] [hitch seconds] [strands]\n", argv[0]);
+        return 2;
+    }
+    SpineExtension::setInstance(getDefaultExtension());
+    SkeletonData *data = hairRig(strands);
+    Run runs[] = {
+            {"no limit", 0, PhysicsSteps_Drop},
+            {"drop", maxSteps, PhysicsSteps_Drop},
+            {"defer", maxSteps, PhysicsSteps_Defer},
+    };
+    printf("%d physics constraints, %.2f s hitch at frame %d, limit %d steps\n",
+           (int) data->getPhysicsConstraints().size(), hitch, HITCH_FRAME, maxSteps);
+    printf("%-10s %12s %12s %14s %10s\n", "policy", "normal us", "hitch us", "after us", "recovery");
+    bool passed = true;
+    for (auto &r : runs) {
+        run(data, r, hitch);
+        printf("%-10s %12.1f %12.1f %14.1f %10d %s\n", r.name, r.normalMicros, r.hitchMicros, r.afterMicros,
+               r.recoveryFrames, r.failures ? "FAIL" : "PASS");
+        passed &= r.failures == 0;
+    }
+    delete data;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// Host check of SkeletonBinary::setQuantizeAnimations against the float timelines. The skeleton is loaded
+// twice, with and without quantizing, and every animation is posed at 60 fps in both. Physics is left
+// out, it would only carry the error on. Reported per animation, and checked against the bounds:
+// - the worst bone error, over its origin and tip (origin plus length along the bone's x axis), in
+//   skeleton units, against --tolerance,
+// - the worst deform vertex error, also against --tolerance. Each deform timeline is applied on its own
+//   with its attachment on the slot, so keys for attachments the animation doesn't show count too,
+// - the worst slot color channel error, against COLOR_TOLERANCE.
+// The timeline memory of both loads and the host time spent applying them are reported too. Only
+// memory is measured, not PSRAM traffic or cache misses on the device. Exits with 1 when a bound is
+// exceeded. See build.sh.
+//
+//     quantize_check hero.skel [--tolerance 0.05]
+#include <spine/spine.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+
+using namespace spine;
+
+#define SAMPLE_RATE 60
+#define DEFAULT_TOLERANCE 0.05f
+// half of an 8 bit color step
+#define COLOR_TOLERANCE (0.5f / 255)
+
+SpineExtension *spine::getDefaultExtension() {
+    return new DefaultSpineExtension();
+}
+
+// attachments without texture regions, bones, deforms and colors don't need them
+class RegionlessAttachmentLoader : public AttachmentLoader {
+public:
+    RegionAttachment *newRegionAttachment(Skin &, const String &name, const String &, Sequence *) override {
+        return new (__FILE__, __LINE__) RegionAttachment(name);
+    }
+    MeshAttachment *newMeshAttachment(Skin &, const String &name, const String &, Sequence *) override {
+        return new (__FILE__, __LINE__) MeshAttachment(name);
+    }
+    BoundingBoxAttachment *newBoundingBoxAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) BoundingBoxAttachment(name);
+    }
+    PathAttachment *newPathAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) PathAttachment(name);
+    }
+    PointAttachment *newPointAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) PointAttachment(name);
+    }
+    ClippingAttachment *newClippingAttachment(Skin &, const String &name) override {
+        return new (__FILE__, __LINE__) ClippingAttachment(name);
+    }
+    void configureAttachment(Attachment *) override {
+    }
+};
+
+static SkeletonData *load(const char *path, bool quantize) {
+    SkeletonBinary binary(new (__FILE__, __LINE__) RegionlessAttachmentLoader(), true);
+    binary.setQuantizeAnimations(quantize);
+    SkeletonData *data = binary.readSkeletonDataFile(path);
+    if (!data)
+        fprintf(stderr, "%s: %s\n", path, binary.getError().buffer());
+    return data;
+}
+
+static size_t timelineBytes(SkeletonData *data) {
+    size_t bytes = 0;
+    auto &animations = data->getAnimations();
+    for (size_t a = 0; a < animations.size(); ++a)
+        bytes += AnimationCache::getTimelinesBytes(animations[a]->getTimelines());
+    return bytes;
+}
+
+// returns the apply time in microseconds
+static double pose(Skeleton &skeleton, Animation &animation, float lastTime, float time) {
+    skeleton.setToSetupPose();
+    auto start = std::chrono::steady_clock::now();
+    animation.apply(skeleton, lastTime, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    skeleton.updateWorldTransform(Physics_None);
+    return micros;
+}
+
+static float tipError(Bone &bone1, Bone &bone2) {
+    float length = bone1.getData().getLength();
+    float x1 = bone1.getWorldX(), y1 = bone1.getWorldY(), x2 = bone2.getWorldX(), y2 = bone2.getWorldY();
+    float error = sqrtf((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+    float tipX1 = x1 + bone1.getA() * length, tipY1 = y1 + bone1.getC() * length;
+    float tipX2 = x2 + bone2.getA() * length, tipY2 = y2 + bone2.getC() * length;
+    float tip = sqrtf((tipX1 - tipX2) * (tipX1 - tipX2) + (tipY1 - tipY2) * (tipY1 - tipY2));
+    return std::max(error, tip);
+}
+
+struct Errors {
+    float bone = 0;
+    float deform = 0;
+    float color = 0;
+};
+
+static void compare(Skeleton &skeleton1, Skeleton &skeleton2, Errors &errors) {
+    for (size_t b = 0; b < skeleton1.getBones().size(); ++b)
+        errors.bone = std::max(errors.bone, tipError(*skeleton1.getBones()[b], *skeleton2.getBones()[b]));
+    for (size_t s = 0; s < skeleton1.getSlots().size(); ++s) {
+        Slot &slot1 = *skeleton1.getSlots()[s], &slot2 = *skeleton2.getSlots()[s];
+        Color &color1 = slot1.getColor(), &color2 = slot2.getColor();
+        errors.color = std::max({errors.color, fabsf(color1.r - color2.r), fabsf(color1.g - color2.g),
+                                 fabsf(color1.b - color2.b), fabsf(color1.a - color2.a)});
+    }
+}
+
+static void compareDeforms(Skeleton &skeleton1, Skeleton &skeleton2, Animation &animation1, Animation &animation2,
+                           float time, Errors &errors) {
+    Vector<Timeline *> &timelines1 = animation1.getTimelines(), &timelines2 = animation2.getTimelines();
+    for (size_t i = 0; i < timelines1.size(); ++i) {
+        if (!timelines1[i]->getRTTI().isExactly(DeformTimeline::rtti))
+            continue;
+        DeformTimeline *timeline1 = static_cast<DeformTimeline *>(timelines1[i]);
+        DeformTimeline *timeline2 = static_cast<DeformTimeline *>(timelines2[i]);
+        Slot &slot1 = *skeleton1.getSlots()[timeline1->getSlotIndex()];
+        Slot &slot2 = *skeleton2.getSlots()[timeline2->getSlotIndex()];
+        slot1.setAttachment(timeline1->getAttachment());
+        slot2.setAttachment(timeline2->getAttachment());
+        slot1.getDeform().clear();
+        slot2.getDeform().clear();
+        timeline1->apply(skeleton1, time, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+        timeline2->apply(skeleton2, time, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+        Vector<float> &deform1 = slot1.getDeform(), &deform2 = slot2.getDeform();
+        if (deform1.size() != deform2.size()) {
+            errors.deform = INFINITY;
+            continue;
+        }
+        for (size_t v = 0; v < deform1.size(); ++v)
+            errors.deform = std::max(errors.deform, fabsf(deform1[v] - deform2[v]));
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    float tolerance = DEFAULT_TOLERANCE;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--tolerance") && i + 1 < argc)
+            tolerance = (float) atof(argv[++i]);
+        else if (!path)
+            path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s skeleton.skel [--tolerance units]\n", argv[0]);
+        return 2;
+    }
+    SpineExtension::setInstance(getDefaultExtension());
+    SkeletonData *data1 = load(path, false);
+    SkeletonData *data2 = load(path, true);
+    if (!data1 || !data2)
+        return 2;
+    Skeleton *skeleton1 = new (__FILE__, __LINE__) Skeleton(data1);
+    Skeleton *skeleton2 = new (__FILE__, __LINE__) Skeleton(data2);
+    printf("bounds: bone and deform %.4f, color %.4f\n", tolerance, COLOR_TOLERANCE);
+    printf("%-32s %8s %10s %10s %10s\n", "animation", "samples", "bone", "deform", "color");
+    bool passed = true;
+    double floatMicros = 0, quantizedMicros = 0;
+    auto &animations = data1->getAnimations();
+    for (size_t a = 0; a < animations.size(); ++a) {
+        Animation *animation1 = animations[a];
+        Animation *animation2 = data2->getAnimations()[a];
+        float duration = animation1->getDuration();
+        int steps = (int) ceilf(duration * SAMPLE_RATE);
+        float lastTime = -1;
+        Errors errors;
+        for (int step = 0; step <= steps; ++step) {
+            float time = std::min((float) step / SAMPLE_RATE, duration);
+            floatMicros += pose(*skeleton1, *animation1, lastTime, time);
+            quantizedMicros += pose(*skeleton2, *animation2, lastTime, time);
+            lastTime = time;
+            compare(*skeleton1, *skeleton2, errors);
+            compareDeforms(*skeleton1, *skeleton2, *animation1, *animation2, time, errors);
+        }
+        bool ok = errors.bone <= tolerance && errors.deform <= tolerance && errors.color <= COLOR_TOLERANCE;
+        printf("%-32s %8d %10.6f %10.6f %10.6f %s\n", animation1->getName().buffer(), steps + 1, errors.bone,
+               errors.deform, errors.color, ok ? "PASS" : "FAIL");
+        passed &= ok;
+    }
+    printf("timelines: %zu bytes float, %zu bytes quantized\n", timelineBytes(data1), timelineBytes(data2));
+    printf("host apply: %.0f us float, %.0f us quantized\n", floatMicros, quantizedMicros);
+    delete skeleton1;
+    delete skeleton2;
+    delete data1;
+    delete data2;
+    return passed ? 0 : 1;
+}
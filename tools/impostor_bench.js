@@ -0,0 +1,36 @@
+// Update cost of a live SpineNode against the same node playing its baked impostor, and the memory the
+// impostor takes. Needs the component built with CONFIG_SPINE_BENCH on (menuconfig, Spine benchmarks).
+// Copy next to spine_api.js, load it after spine_api.js and point the settings below at a skeleton on
+// the device.
+let BENCH_SKEL = "/spiffs/spineboy.skel";
+let BENCH_ATLAS = "/spiffs/spineboy.atlas";
+let BENCH_ANIMATION = "idle";
+let BENCH_FRAME_RATE = 15;
+// impostor pixels per skeleton unit, below 1 for distant characters
+let BENCH_RESOLUTION = 0.25;
+let BENCH_UPDATES = 300;
+
+function benchImpostorRun() {
+    let node = spine.createSpine();
+    spine.SpineNode_loadWithBinaryFile(node, BENCH_SKEL, BENCH_ATLAS, 1.0);
+    let animation = spine.SpineNode_findAnimation(node, BENCH_ANIMATION);
+    if (animation < 0) {
+        print("animation not found:", BENCH_ANIMATION);
+        return;
+    }
+    spine.SpineNode_setAnimationById(node, 0, animation, true);
+
+    let start = spine.benchMicros();
+    if (!spine.SpineNode_bakeImpostor(node, animation, BENCH_FRAME_RATE, BENCH_RESOLUTION)) {
+        print("bake failed, pages must be png files and the impostor within the budget");
+        return;
+    }
+    print("bake:", spine.benchMicros() - start, "us,", spine.getImpostorBytes(), "bytes");
+    let live = spine.benchImpostor(node, BENCH_UPDATES, false);
+    let impostor = spine.benchImpostor(node, BENCH_UPDATES, true);
+    print("live:", live / BENCH_UPDATES, "us per update");
+    print("impostor:", impostor / BENCH_UPDATES, "us per update");
+    spine.SpineNode_releaseImpostor(node);
+}
+
+benchImpostorRun();
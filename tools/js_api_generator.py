@@ -1,3 +1,4 @@
+import argparse
 import os.path
 import re
 
@@ -18,8 +19,9 @@ def find_header_files(directory, excludes_abs):
     for root, dirs, files in walk_excluding(directory, excludes_abs):
         dirs[:] = [d for d in dirs if d not in excludes_abs]
         for file in files:
-            if file.endswith(".h"):
-                header_files.append(os.path.join(root, file))
+            path = os.path.join(root, file)
+            if file.endswith(".h") and os.path.normpath(path) not in excludes_abs:
+                header_files.append(path)
     return header_files
 
 
@@ -56,7 +58,7 @@ def param_convert_js(c_param_type):
     return js_param_type
 
 
-def gen_js_file(js_file, return_type, func_name, params_list, namespace):
+def gen_js_file(js_file, ffi_decls, return_type, func_name, params_list, namespace):
     if '*' in return_type and 'char*' not in return_type:
         return_type = 'void*'
     if 'Ptr' in return_type:
@@ -82,8 +84,10 @@ def gen_js_file(js_file, return_type, func_name, params_list, namespace):
         js_file.write(f'{func_name}: function() {{\n')
     else:
         js_file.write(f'{func_name}: function({c_params_value_str}) {{\n')
-    js_file.write(f'    let f = ffi(\"{return_type} {func_name}({c_params_simple_str})\");\n')
-    js_file.write(f'    return f({c_params_value_str});\n')
+    # resolve the native function once when the script loads instead of on every call
+    ffi_name = f'{namespace}_ffi_{func_name}'
+    ffi_decls.append(f'let {ffi_name} = ffi(\"{return_type} {func_name}({c_params_simple_str})\");\n')
+    js_file.write(f'    return {ffi_name}({c_params_value_str});\n')
     if len(namespace) > 0:
         js_file.write('},\n')
     else:
@@ -179,6 +183,7 @@ def api_binding_generator(header_path: str, header_excludes: list, js_out_path:
             headers = find_header_files(header_path, excludes_abs)
             export_headers = set()
             export_funcs = set()
+            ffi_decls = []
             for header in headers:
                 with open(header, 'r', encoding='utf-8') as h_file:
                     begin = False
@@ -256,7 +261,7 @@ def api_binding_generator(header_path: str, header_excludes: list, js_out_path:
                                     transformed_params.append('float vec_z')
                                 else:
                                     transformed_params.append(clear_param)
-                            gen_js_file(js_file, return_type, func_name, transformed_params, namespace)
+                            gen_js_file(js_file, ffi_decls, return_type, func_name, transformed_params, namespace)
                             gen_cpp_file(cpp_file, class_name, static_func, return_type, func_name, transformed_params)
                             export_funcs.add(func_name)
         with open(cpp_out_file, 'r', encoding='utf-8') as file:
@@ -279,9 +284,15 @@ def api_binding_generator(header_path: str, header_excludes: list, js_out_path:
             file.write(content)
         if len(namespace) > 0:
             js_file.write('};\n')
+        for decl in ffi_decls:
+            js_file.write(decl)
 
 
 def main():
+    parser = argparse.ArgumentParser()
+    # headers or directories left out of the bindings, relative to this script
+    parser.add_argument('--exclude', action='append', default=[])
+    args = parser.parse_args()
     js_out_path = '../../../spiffs_img'
     absolute_path = os.path.abspath(js_out_path)
     if not os.path.exists(absolute_path):
@@ -289,7 +300,7 @@ def main():
         return
     # export spine library
     header_path = '../cubicat-port'
-    header_excludes = ['../dist']
+    header_excludes = ['../dist'] + args.exclude
     cpp_out_path = '../js_binding'
     api_binding_generator(header_path, header_excludes, js_out_path, cpp_out_path, 'spine_api', 'spine')
 
@@ -0,0 +1,60 @@
+// JS to native call overhead of the spine bindings: the bare ffi call, name based calls, handle based
+// calls and the command buffer. Needs the component built with CONFIG_SPINE_BENCH on (menuconfig, Spine
+// benchmarks). Copy next to spine_api.js, load it after spine_api.js and point the settings below at a
+// skeleton on the device.
+let BENCH_SKEL = "/spiffs/spineboy.skel";
+let BENCH_ATLAS = "/spiffs/spineboy.atlas";
+let BENCH_ANIMATIONS = ["idle", "walk", "run"];
+let BENCH_CALLS = 1000;
+// commands per runCommands call
+let BENCH_BATCH = 50;
+
+function benchReport(name, start, calls) {
+    let us = spine.benchMicros() - start;
+    print(name, us / calls, "us per call");
+}
+
+function benchRun() {
+    let node = spine.createSpine();
+    spine.SpineNode_loadWithBinaryFile(node, BENCH_SKEL, BENCH_ATLAS, 1.0);
+    let names = BENCH_ANIMATIONS;
+    let ids = [];
+    for (let i = 0; i < names.length; i++) {
+        ids.push(spine.SpineNode_findAnimation(node, names[i]));
+        if (ids[i] < 0) {
+            print("animation not found:", names[i]);
+            return;
+        }
+    }
+
+    let start = spine.benchMicros();
+    for (let i = 0; i < BENCH_CALLS; i++) {
+        spine.benchNoop(node, 0, ids[i % 3], true);
+    }
+    benchReport("noop", start, BENCH_CALLS);
+
+    start = spine.benchMicros();
+    for (let i = 0; i < BENCH_CALLS; i++) {
+        spine.SpineNode_setAnimation(node, 0, names[i % 3], true);
+    }
+    benchReport("setAnimation by name", start, BENCH_CALLS);
+
+    start = spine.benchMicros();
+    for (let i = 0; i < BENCH_CALLS; i++) {
+        spine.SpineNode_setAnimationById(node, 0, ids[i % 3], true);
+    }
+    benchReport("setAnimationById", start, BENCH_CALLS);
+
+    let commands = "";
+    for (let i = 0; i < BENCH_BATCH; i++) {
+        commands = commands + "s 0 " + JSON.stringify(ids[i % 3]) + " 1;";
+    }
+    let batches = BENCH_CALLS / BENCH_BATCH;
+    start = spine.benchMicros();
+    for (let i = 0; i < batches; i++) {
+        spine.SpineNode_runCommands(node, commands);
+    }
+    benchReport("runCommands, per command", start, batches * BENCH_BATCH);
+}
+
+benchRun();
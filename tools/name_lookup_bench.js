@@ -0,0 +1,36 @@
+// Memory a skeleton takes to load and what looking its bones, slots and animations up by name costs.
+// From spine 4.2 the names of a skeleton data are interned, so the load allocates less and lookups
+// compare atoms. Allocations are counted when the component is built with SPINE_ALLOCATION_STATS
+// defined (e.g. target_compile_definitions(${COMPONENT_LIB} PRIVATE SPINE_ALLOCATION_STATS)). Needs the
+// component built with CONFIG_SPINE_BENCH on (menuconfig, Spine benchmarks). Copy next to spine_api.js,
+// load it after spine_api.js and point the settings below at a skeleton.
+let BENCH_SKEL = "/spiffs/spineboy.skel";
+let BENCH_ATLAS = "/spiffs/spineboy.atlas";
+let BENCH_PASSES = 100;
+
+function benchNameLookupRun() {
+    let heap = spine.freeHeap();
+    let allocations = spine.spineAllocations();
+    let start = spine.benchMicros();
+    let node = spine.createSpine();
+    spine.SpineNode_loadWithBinaryFile(node, BENCH_SKEL, BENCH_ATLAS, 1.0);
+    let micros = spine.benchMicros() - start;
+    if (allocations < 0)
+        print("load:", micros, "us,", heap - spine.freeHeap(), "bytes");
+    else
+        print("load:", micros, "us,", heap - spine.freeHeap(), "bytes,",
+              spine.spineAllocations() - allocations, "allocations");
+    let names = spine.internedNames(node, false);
+    if (names < 0)
+        print("no interning before spine 4.2");
+    else
+        print("interned:", names, "names,", spine.internedNames(node, true), "bytes");
+    micros = spine.benchNameLookup(node, BENCH_PASSES);
+    if (micros < 0) {
+        print("a name was not found");
+        return;
+    }
+    print("lookup:", micros / BENCH_PASSES, "us per pass over every name");
+}
+
+benchNameLookupRun();
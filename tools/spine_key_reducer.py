@@ -0,0 +1,370 @@
+"""Removes bone keys that linear or bezier interpolation can reproduce within a tolerance.
+
+Works on spine 4.2 JSON exports. Baked IK and physics produce a key per frame; most of them lie on a
+curve through their neighbours. A run of keys is replaced by one segment when every key and every
+sample in between stays within tolerance. The world-space tolerance is split between a bone's
+animated properties and those of its ancestors, then turned into local tolerances from the setup pose
+(parent scale for translation, the reach of the bone's subtree for rotation, scale and shear). The result is then checked by posing the skeleton from the original and
+the reduced animations.
+
+    python tools/spine_key_reducer.py hero.json hero-reduced.json --tolerance 0.5
+
+Export the reduced JSON to .skel with the spine editor CLI. Only bone timelines are reduced, the
+others are copied unchanged. The world check here is approximate: it poses bones only, without
+constraints, treats every inherit mode as "normal" and evaluates curves exactly where the runtime
+approximates them. IK can amplify an error many times. Check the result through the runtime with
+tools/host/key_error_check (see tools/host/build.sh):
+
+    key_error_check hero.json hero-reduced.json --tolerance 0.5
+"""
+import argparse
+import json
+import math
+import os.path
+
+SAMPLE_RATE = 60
+
+# timeline name -> (value keys, default value, kind)
+BONE_TIMELINES = {
+    'rotate': (('value',), 0, 'rotate'),
+    'translate': (('x', 'y'), 0, 'translate'),
+    'translatex': (('value',), 0, 'translate'),
+    'translatey': (('value',), 0, 'translate'),
+    'scale': (('x', 'y'), 1, 'scale'),
+    'scalex': (('value',), 1, 'scale'),
+    'scaley': (('value',), 1, 'scale'),
+    'shear': (('x', 'y'), 0, 'shear'),
+    'shearx': (('value',), 0, 'shear'),
+    'sheary': (('value',), 0, 'shear'),
+}
+
+
+def key_values(key, names, default):
+    return [key.get(name, default) for name in names]
+
+
+def bezier_value(time, time1, value1, cx1, cy1, cx2, cy2, time2, value2):
+    # Solve x(s) = time by bisection, x is monotonic for curves exported by the editor.
+    lo, hi = 0.0, 1.0
+    for _ in range(40):
+        s = (lo + hi) / 2
+        u = 1 - s
+        x = u * u * u * time1 + 3 * u * u * s * cx1 + 3 * u * s * s * cx2 + s * s * s * time2
+        if x < time:
+            lo = s
+        else:
+            hi = s
+    s = (lo + hi) / 2
+    u = 1 - s
+    return u * u * u * value1 + 3 * u * u * s * cy1 + 3 * u * s * s * cy2 + s * s * s * value2
+
+
+def segment_value(key, next_key, names, default, time):
+    """Value of the segment starting at key, as the runtime evaluates it."""
+    values = key_values(key, names, default)
+    if next_key is None:
+        return values
+    curve = key.get('curve')
+    if curve == 'stepped':
+        return values
+    time1, time2 = key.get('time', 0), next_key.get('time', 0)
+    values2 = key_values(next_key, names, default)
+    if time2 <= time1:
+        return values2
+    if curve is None:
+        t = (time - time1) / (time2 - time1)
+        return [v1 + (v2 - v1) * t for v1, v2 in zip(values, values2)]
+    return [bezier_value(time, time1, v1, *curve[i * 4:i * 4 + 4], time2, v2)
+            for i, (v1, v2) in enumerate(zip(values, values2))]
+
+
+def timeline_value(keys, names, default, time):
+    if not keys or time < keys[0].get('time', 0):
+        return None
+    i = 0
+    while i + 1 < len(keys) and keys[i + 1].get('time', 0) <= time:
+        i += 1
+    return segment_value(keys[i], keys[i + 1] if i + 1 < len(keys) else None, names, default, time)
+
+
+def sample_times(time1, time2, keys):
+    times = [key.get('time', 0) for key in keys if time1 < key.get('time', 0) < time2]
+    t = math.floor(time1 * SAMPLE_RATE + 1) / SAMPLE_RATE
+    while t < time2:
+        times.append(t)
+        t += 1.0 / SAMPLE_RATE
+    return sorted(times)
+
+
+def fit_segment(keys, first, last, names, default, tolerance):
+    """Returns the curve for one segment from keys[first] to keys[last], or False if none fits."""
+    time1, time2 = keys[first].get('time', 0), keys[last].get('time', 0)
+    values1, values2 = key_values(keys[first], names, default), key_values(keys[last], names, default)
+    span = time2 - time1
+    samples = [(t, timeline_value(keys, names, default, t)) for t in sample_times(time1, time2, keys[first:last + 1])]
+    if span <= 0:
+        return False
+
+    def fits(evaluate):
+        return all(abs(a - b) <= tolerance for t, values in samples for a, b in zip(evaluate(t), values))
+
+    if fits(lambda t: [v1 + (v2 - v1) * (t - time1) / span for v1, v2 in zip(values1, values2)]):
+        return None
+
+    # Control x at thirds makes x(s) linear, so the control y values are a linear least squares fit.
+    cx1, cx2 = time1 + span / 3, time1 + span * 2 / 3
+    curve = []
+    for i, (v1, v2) in enumerate(zip(values1, values2)):
+        a11 = a12 = a22 = b1 = b2 = 0.0
+        for t, values in samples:
+            s = (t - time1) / span
+            u = 1 - s
+            p1, p2 = 3 * u * u * s, 3 * u * s * s
+            r = values[i] - u * u * u * v1 - s * s * s * v2
+            a11 += p1 * p1
+            a12 += p1 * p2
+            a22 += p2 * p2
+            b1 += p1 * r
+            b2 += p2 * r
+        det = a11 * a22 - a12 * a12
+        if abs(det) < 1e-12:
+            cy1, cy2 = v1 + (v2 - v1) / 3, v1 + (v2 - v1) * 2 / 3
+        else:
+            cy1, cy2 = (b1 * a22 - b2 * a12) / det, (a11 * b2 - a12 * b1) / det
+        curve += [cx1, cy1, cx2, cy2]
+
+    def evaluate(t):
+        s = (t - time1) / span
+        u = 1 - s
+        return [u * u * u * v1 + 3 * u * u * s * curve[i * 4 + 1] + 3 * u * s * s * curve[i * 4 + 3] + s * s * s * v2
+                for i, (v1, v2) in enumerate(zip(values1, values2))]
+
+    return curve if fits(evaluate) else False
+
+
+def reduce_keys(keys, names, default, tolerance):
+    if len(keys) < 3:
+        return keys
+    result = [dict(keys[0])]
+    first = 0
+    while first < len(keys) - 1:
+        if keys[first].get('curve') == 'stepped':
+            first += 1
+            result.append(dict(keys[first]))
+            continue
+        last, curve = first + 1, keys[first].get('curve')
+        while last + 1 < len(keys) and keys[last].get('curve') != 'stepped':
+            fitted = fit_segment(keys, first, last + 1, names, default, tolerance)
+            if fitted is False:
+                break
+            last, curve = last + 1, fitted
+        if last > first + 1:
+            if curve is None:
+                result[-1].pop('curve', None)
+            else:
+                result[-1]['curve'] = [round(c, 5) for c in curve]
+        result.append(dict(keys[last]))
+        first = last
+    return result
+
+
+class Pose:
+    def __init__(self, bones):
+        self.bones = bones
+        self.index = {bone['name']: i for i, bone in enumerate(bones)}
+        self.parents = [self.index.get(bone.get('parent')) for bone in bones]
+
+    def world(self, local):
+        """Returns (a, b, c, d, worldX, worldY) per bone for local (x, y, rotation, scaleX, scaleY, shearX, shearY)."""
+        world = []
+        for i, bone in enumerate(self.bones):
+            x, y, rotation, sx, sy, shx, shy = local[i]
+            la = math.cos(math.radians(rotation + shx)) * sx
+            lb = math.cos(math.radians(rotation + 90 + shy)) * sy
+            lc = math.sin(math.radians(rotation + shx)) * sx
+            ld = math.sin(math.radians(rotation + 90 + shy)) * sy
+            parent = self.parents[i]
+            if parent is None:
+                a, b, c, d, wx, wy = la, lb, lc, ld, x, y
+            else:
+                pa, pb, pc, pd, px, py = world[parent][:6]
+                a, b, c, d = pa * la + pb * lc, pa * lb + pb * ld, pc * la + pd * lc, pc * lb + pd * ld
+                wx, wy = pa * x + pb * y + px, pc * x + pd * y + py
+            world.append((a, b, c, d, wx, wy))
+        return world
+
+    def setup(self):
+        return [[bone.get('x', 0), bone.get('y', 0), bone.get('rotation', 0), bone.get('scaleX', 1),
+                 bone.get('scaleY', 1), bone.get('shearX', 0), bone.get('shearY', 0)] for bone in self.bones]
+
+    def apply(self, timelines, time):
+        local = self.setup()
+        for bone_name, bone_timelines in timelines.items():
+            i = self.index.get(bone_name)
+            if i is None:
+                continue
+            for name, keys in bone_timelines.items():
+                if name not in BONE_TIMELINES:
+                    continue
+                names, default, _ = BONE_TIMELINES[name]
+                values = timeline_value(keys, names, default, time)
+                if values is None:
+                    continue
+                pose = local[i]
+                if name == 'rotate':
+                    pose[2] += values[0]
+                elif name in ('translate', 'translatex', 'translatey', 'shear', 'shearx', 'sheary'):
+                    base = 0 if name.startswith('translate') else 5
+                    offset = 1 if name.endswith('y') and len(values) == 1 else 0
+                    for v, value in enumerate(values):
+                        pose[base + offset + v] += value
+                else:
+                    offset = 1 if name == 'scaley' else 0
+                    for v, value in enumerate(values):
+                        pose[3 + offset + v] *= value
+        return local
+
+
+def tip_error(bone, world1, world2):
+    length = bone.get('length', 0)
+    a1, b1, c1, d1, x1, y1 = world1
+    a2, b2, c2, d2, x2, y2 = world2
+    error = math.hypot(x1 - x2, y1 - y2)
+    tip = math.hypot(x1 + a1 * length - x2 - a2 * length, y1 + c1 * length - y2 - c2 * length)
+    return max(error, tip)
+
+
+def local_tolerances(pose, animated, tolerance, angle, scale):
+    """Per bone local tolerance by kind, so that the properties animated on a bone and its animated ancestors
+    together move the bone by at most `tolerance` in world space."""
+    world = pose.world(pose.setup())
+    reach = [bone.get('length', 0) for bone in pose.bones]
+    for i in reversed(range(len(pose.bones))):
+        parent = pose.parents[i]
+        if parent is not None:
+            bone = pose.bones[i]
+            offset = math.hypot(bone.get('x', 0), bone.get('y', 0))
+            reach[parent] = max(reach[parent], offset + reach[i])
+    shares = []
+    for i, bone in enumerate(pose.bones):
+        parent = pose.parents[i]
+        shares.append(len(animated.get(bone['name'], ())) + (shares[parent] if parent is not None else 0))
+    result = {}
+    for i, bone in enumerate(pose.bones):
+        budget = tolerance / max(shares[i], 1)
+        parent = pose.parents[i]
+        parent_scale = 1.0
+        if parent is not None:
+            a, b, c, d = world[parent][:4]
+            parent_scale = max(math.hypot(a, c), math.hypot(b, d), 1e-6)
+        a, b, c, d = world[i][:4]
+        world_reach = max(reach[i] * max(math.hypot(a, c), math.hypot(b, d)), 1e-6)
+        result[bone['name']] = {
+            'translate': budget / parent_scale,
+            'rotate': min(angle, math.degrees(budget / world_reach)),
+            'shear': min(angle, math.degrees(budget / world_reach)),
+            'scale': min(scale, budget / world_reach),
+        }
+    return result
+
+
+def animation_duration(animation):
+    duration = 0
+
+    def visit(node):
+        nonlocal duration
+        if isinstance(node, dict):
+            if isinstance(node.get('time'), (int, float)):
+                duration = max(duration, node['time'])
+            for value in node.values():
+                visit(value)
+        elif isinstance(node, list):
+            for value in node:
+                visit(value)
+
+    visit(animation)
+    return duration
+
+
+def count_keys(bone_timelines):
+    return sum(len(keys) for timelines in bone_timelines.values() for name, keys in timelines.items()
+               if name in BONE_TIMELINES)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Remove redundant bone keys from a spine 4.2 JSON export.',
+        epilog='The reported world-space error is approximate: bones only, no constraints, every inherit mode '
+               'treated as "normal". Check the output through the runtime with tools/host/key_error_check.')
+    parser.add_argument('input')
+    parser.add_argument('output')
+    parser.add_argument('--tolerance', type=float, default=0.5, help='max world-space error in skeleton units')
+    parser.add_argument('--angle', type=float, default=0.5, help='max rotation and shear error in degrees')
+    parser.add_argument('--scale', type=float, default=0.005, help='max scale error')
+    parser.add_argument('--pretty', action='store_true', help='indent the output')
+    parser.add_argument('--report', help='also write the report as JSON to this file')
+    args = parser.parse_args()
+
+    with open(args.input, 'r', encoding='utf-8') as f:
+        skeleton = json.load(f)
+    pose = Pose(skeleton.get('bones', []))
+    animated = {}
+    for animation in skeleton.get('animations', {}).values():
+        for bone_name, timelines in animation.get('bones', {}).items():
+            animated.setdefault(bone_name, set()).update(
+                BONE_TIMELINES[name][2] for name in timelines if name in BONE_TIMELINES)
+    tolerances = local_tolerances(pose, animated, args.tolerance, args.angle, args.scale)
+
+    report = {'animations': {}, 'bones': {}}
+    bone_error = {bone['name']: 0.0 for bone in pose.bones}
+    for animation_name, animation in skeleton.get('animations', {}).items():
+        original = animation.get('bones', {})
+        reduced = {}
+        for bone_name, timelines in original.items():
+            reduced[bone_name] = {}
+            for name, keys in timelines.items():
+                if name in BONE_TIMELINES and bone_name in tolerances:
+                    names, default, kind = BONE_TIMELINES[name]
+                    reduced[bone_name][name] = reduce_keys(keys, names, default, tolerances[bone_name][kind])
+                else:
+                    reduced[bone_name][name] = keys
+        duration = animation_duration(animation)
+        steps = int(math.ceil(duration * SAMPLE_RATE))
+        for step in range(steps + 1):
+            time = min(step / SAMPLE_RATE, duration)
+            world1, world2 = pose.world(pose.apply(original, time)), pose.world(pose.apply(reduced, time))
+            for i, bone in enumerate(pose.bones):
+                bone_error[bone['name']] = max(bone_error[bone['name']], tip_error(bone, world1[i], world2[i]))
+        if original:
+            animation['bones'] = reduced
+        report['animations'][animation_name] = {'keys': count_keys(original), 'reduced': count_keys(reduced)}
+
+    with open(args.output, 'w', encoding='utf-8') as f:
+        if args.pretty:
+            json.dump(skeleton, f, indent='\t')
+        else:
+            json.dump(skeleton, f, separators=(',', ':'))
+
+    report['bones'] = bone_error
+    report['approximate'] = True
+    report['size'] = os.path.getsize(args.input)
+    report['reducedSize'] = os.path.getsize(args.output)
+    keys = sum(a['keys'] for a in report['animations'].values())
+    reduced_keys = sum(a['reduced'] for a in report['animations'].values())
+    print('%-32s %8s %8s' % ('animation', 'keys', 'reduced'))
+    for name, counts in report['animations'].items():
+        print('%-32s %8d %8d' % (name, counts['keys'], counts['reduced']))
+    print('%-32s %8d %8d' % ('total', keys, reduced_keys))
+    print('file size: %d -> %d bytes' % (report['size'], report['reducedSize']))
+    print('worst world-space error per bone, approximate (no constraints, inherit modes as "normal"):')
+    for name, error in sorted(bone_error.items(), key=lambda item: -item[1]):
+        if error > 0:
+            print('  %-30s %.4f' % (name, error))
+    print('check through the runtime: key_error_check %s %s' % (args.input, args.output))
+    if args.report:
+        with open(args.report, 'w', encoding='utf-8') as f:
+            json.dump(report, f, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,17 @@
+// Texel fetch cost of RGBA8888 pages against 8 bit indexed pages with a color table, see
+// tools/atlas_palette.py. Needs the component built with CONFIG_SPINE_BENCH on (menuconfig, Spine
+// benchmarks). Copy next to spine_api.js and load it after spine_api.js.
+let BENCH_FETCHES = 200000;
+
+function benchTextureRun() {
+    let rgba = spine.benchTexelFetch(false, BENCH_FETCHES);
+    let indexed = spine.benchTexelFetch(true, BENCH_FETCHES);
+    if (rgba < 0 || indexed < 0) {
+        print("not enough PSRAM for the bench pages");
+        return;
+    }
+    print("256x256 page, RGBA8888:", 256 * 256 * 4, "bytes,", rgba * 1000 / BENCH_FETCHES, "ns per texel");
+    print("256x256 page, indexed:", 256 * 256 + 256 * 3, "bytes,", indexed * 1000 / BENCH_FETCHES, "ns per texel");
+}
+
+benchTextureRun();
@@ -0,0 +1,34 @@
+// Container churn of the spine runtime on a real rig: copies of strings and nested vectors, and buffer
+// reallocations, while loading a skeleton and while it plays. Needs the component built with
+// CONFIG_SPINE_BENCH on (menuconfig, Spine benchmarks) and SPINE_VECTOR_STATS defined (e.g.
+// target_compile_definitions(${COMPONENT_LIB} PRIVATE SPINE_VECTOR_STATS)). Copy next to spine_api.js,
+// load it after spine_api.js and point the settings below at a skeleton.
+let BENCH_SKEL = "/spiffs/spineboy.skel";
+let BENCH_ATLAS = "/spiffs/spineboy.atlas";
+let BENCH_ANIMATION = "walk";
+let BENCH_UPDATES = 60;
+
+function vectorStatsRun() {
+    if (spine.vectorStats(false, true) < 0) {
+        print("build with SPINE_VECTOR_STATS defined to count");
+        return;
+    }
+    spine.vectorStats(true, true);
+    let start = spine.benchMicros();
+    let node = spine.createSpine();
+    spine.SpineNode_loadWithBinaryFile(node, BENCH_SKEL, BENCH_ATLAS, 1.0);
+    print("load:", spine.benchMicros() - start, "us,", spine.vectorStats(false, true), "copies,",
+          spine.vectorStats(true, true), "reallocations");
+    let animation = spine.SpineNode_findAnimation(node, BENCH_ANIMATION);
+    if (animation < 0) {
+        print("animation not found:", BENCH_ANIMATION);
+        return;
+    }
+    spine.SpineNode_setAnimationById(node, 0, animation, true);
+    // without an impostor this times plain updates
+    spine.benchImpostor(node, BENCH_UPDATES, false);
+    print(BENCH_UPDATES, "updates:", spine.vectorStats(false, true), "copies,", spine.vectorStats(true, true),
+          "reallocations");
+}
+
+vectorStatsRun();